@@ -43,6 +43,81 @@ project "MDCII"
         "src/**.proto"
     }
 
+    -- the world generator has its own main function
+    removefiles
+    {
+        "src/WorldGenMain.cpp"
+    }
+
+    includedirs
+    {
+        "src"
+    }
+
+    postbuildcommands
+    {
+        "{COPY} config.ini %{cfg.targetdir}",
+        "{COPY} resources/ %{cfg.targetdir}/resources"
+    }
+
+    filter "system:windows"
+        systemversion "latest"
+
+    filter "configurations:Debug"
+        defines { "MDCII_DEBUG_BUILD", "GLFW_INCLUDE_NONE", "_CRT_SECURE_NO_WARNINGS", "GLM_ENABLE_EXPERIMENTAL", "SPDLOG_NO_EXCEPTIONS" }
+        runtime "Debug"
+        symbols "On"
+
+    -- disable Basic Runtime Checks
+    -- debug with inlines (use /Ob1)
+    -- disable Edit And Continue (use /Zi)
+    -- disable Just My Code debugging
+    filter "configurations:FastDebug"
+        defines { "MDCII_DEBUG_BUILD", "GLFW_INCLUDE_NONE", "_CRT_SECURE_NO_WARNINGS", "GLM_ENABLE_EXPERIMENTAL", "SPDLOG_NO_EXCEPTIONS" }
+        runtime "Debug"
+        symbols "On"
+        flags { "NoRuntimeChecks" }
+        buildoptions "/Ob1"
+        editandcontinue "Off"
+        justmycode "Off"
+
+    filter "configurations:Release"
+        defines { "GLFW_INCLUDE_NONE", "_CRT_SECURE_NO_WARNINGS", "GLM_ENABLE_EXPERIMENTAL", "SPDLOG_NO_EXCEPTIONS" }
+        runtime "Release"
+        optimize "On"
+
+project "MDCII_WORLDGEN"
+    location "/Dev/MDCII"
+    architecture "x64"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+    characterset "Unicode"
+
+    targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+    objdir ("obj/" .. outputdir .. "/%{prj.name}")
+
+    linkoptions
+    {
+        conan_exelinkflags,
+        "/IGNORE:4099"
+    }
+
+    files
+    {
+        "src/**.h",
+        "src/**.hpp",
+        "src/**.cpp",
+        "src/**.cc",
+        "src/**.proto"
+    }
+
+    -- the game has its own main function
+    removefiles
+    {
+        "src/Main.cpp"
+    }
+
     includedirs
     {
         "src"
@@ -104,7 +179,18 @@ project "MDCII_TEST"
 
     files
     {
-        "tests/**.cpp"
+        "tests/**.cpp",
+        "src/**.h",
+        "src/**.hpp",
+        "src/**.cpp",
+        "src/**.cc"
+    }
+
+    -- the tests use all sources except the entry points
+    removefiles
+    {
+        "src/Main.cpp",
+        "src/WorldGenMain.cpp"
     }
 
     includedirs
@@ -112,10 +198,16 @@ project "MDCII_TEST"
         "src"
     }
 
+    postbuildcommands
+    {
+        "{COPY} config.ini %{cfg.targetdir}",
+        "{COPY} resources/ %{cfg.targetdir}/resources"
+    }
+
     filter "system:windows"
         systemversion "latest"
 
     filter "configurations:Debug"
-        defines { "_CRT_SECURE_NO_WARNINGS" }
+        defines { "GLFW_INCLUDE_NONE", "_CRT_SECURE_NO_WARNINGS", "GLM_ENABLE_EXPERIMENTAL", "SPDLOG_NO_EXCEPTIONS" }
         runtime "Debug"
         symbols "On"
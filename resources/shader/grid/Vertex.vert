@@ -2,6 +2,9 @@
 
 layout (location = 0) in vec4 aPosition;
 
+// the position of the first instance of the island in the shared buffer
+layout (location = 1) in int aInstanceOffset;
+
 layout(std140, binding = 0) buffer modelMatrices
 {
     mat4 modelMatrix[];
@@ -9,11 +12,20 @@ layout(std140, binding = 0) buffer modelMatrices
 
 out vec2 vUv;
 
-uniform mat4 view;
-uniform mat4 projection;
+// the same for all draws of a frame
+layout(std140, binding = 0) uniform frame
+{
+    mat4 projectionView;
+    int updates[5];
+    int worldRotation;
+    float maxY;
+    float nrOfRows;
+};
 
 void main()
 {
-    gl_Position = projection * view * modelMatrix[gl_InstanceID] * vec4(aPosition.xy, 0.0, 1.0);
+    int instance = aInstanceOffset + gl_InstanceID;
+
+    gl_Position = projectionView * modelMatrix[instance] * vec4(aPosition.xy, 0.0, 1.0);
     vUv = aPosition.zw;
 }
@@ -0,0 +1,45 @@
+#version 430
+
+//-------------------------------------------------
+// Out
+//-------------------------------------------------
+
+out vec4 fragColor;
+
+//-------------------------------------------------
+// In
+//-------------------------------------------------
+
+in vec2 vUv;
+flat in int vTextureAtlasIndex;
+
+//-------------------------------------------------
+// Uniforms
+//-------------------------------------------------
+
+uniform sampler2DArray diffuseMap;
+
+//-------------------------------------------------
+// Constants
+//-------------------------------------------------
+
+const int NO_TEXTURE_ATLAS = -1;
+
+//-------------------------------------------------
+// Main
+//-------------------------------------------------
+
+void main()
+{
+    if (vTextureAtlasIndex == NO_TEXTURE_ATLAS)
+    {
+        discard;
+    }
+
+    fragColor = texture(diffuseMap, vec3(vUv, vTextureAtlasIndex));
+
+    if (fragColor.a == 0)
+    {
+        discard;
+    }
+}
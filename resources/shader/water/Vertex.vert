@@ -0,0 +1,184 @@
+#version 430
+
+//-------------------------------------------------
+// In
+//-------------------------------------------------
+
+layout (location = 0) in vec4 aPosition;
+
+layout(std430, binding = 3) buffer heights
+{
+    float textureHeight[];
+};
+
+layout(std430, binding = 4) buffer buildingAnimations
+{
+    ivec4 buildingAnimation[];
+};
+
+layout(std430, binding = 8) buffer islandGrid
+{
+    uint islandIndex[];
+};
+
+//-------------------------------------------------
+// Out
+//-------------------------------------------------
+
+out vec2 vUv;
+flat out int vTextureAtlasIndex;
+
+//-------------------------------------------------
+// Uniforms
+//-------------------------------------------------
+
+// the same for all draws of a frame
+layout(std140, binding = 0) uniform frame
+{
+    mat4 projectionView;
+    int updates[5];
+    int worldRotation;
+    float maxY;
+    float nrOfRows;
+};
+
+uniform int worldWidth;
+uniform int worldHeight;
+uniform int tileWidth;
+uniform int tileHeight;
+uniform vec2 waterSize;
+uniform int minColumn;
+uniform int minRow;
+uniform int nrOfColumns;
+uniform int waterBuildingId;
+uniform int waterGfx;
+
+//-------------------------------------------------
+// Constants
+//-------------------------------------------------
+
+const int NO_GFX = -1;
+const uint NO_ISLAND = 0xFFFFu;
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+vec2 calcUvOffset(int t_gfx, int t_rows)
+{
+    return vec2(
+        (t_gfx % t_rows) / nrOfRows,
+        (t_gfx / t_rows) / nrOfRows
+    );
+}
+
+int calcTextureAtlasIndex(int t_gfx, int t_rows)
+{
+    return (t_gfx / (t_rows * t_rows));
+}
+
+ivec2 unrotatePosition(ivec2 t_position)
+{
+    switch(worldRotation)
+    {
+        case 1:
+            return ivec2(t_position.y, worldWidth - t_position.x - 1);
+        case 2:
+            return ivec2(worldWidth - t_position.x - 1, worldHeight - t_position.y - 1);
+        case 3:
+            return ivec2(worldHeight - t_position.y - 1, t_position.x);
+    }
+
+    return t_position;
+}
+
+bool isDeepWater(ivec2 t_worldPosition)
+{
+    if (t_worldPosition.x < 0 || t_worldPosition.x >= worldWidth || t_worldPosition.y < 0 || t_worldPosition.y >= worldHeight)
+    {
+        return false;
+    }
+
+    // two 16-bit island indices are packed into one uint
+    int index = t_worldPosition.y * worldWidth + t_worldPosition.x;
+    uint packed = islandIndex[index >> 1];
+    uint island = (index & 1) == 0 ? (packed & 0xFFFFu) : (packed >> 16);
+
+    return island == NO_ISLAND;
+}
+
+//-------------------------------------------------
+// Animation
+//-------------------------------------------------
+
+int getFrame(int t_animCount, int t_animTime)
+{
+    switch(t_animTime)
+    {
+        case 90:
+            return updates[0] % t_animCount;
+        case 130:
+            return updates[1] % t_animCount;
+        case 150:
+            return updates[2] % t_animCount;
+        case 180:
+            return updates[3] % t_animCount;
+        case 220:
+            return updates[4] % t_animCount;
+    }
+
+    return 0;
+}
+
+int animateWater(int t_gfx)
+{
+    ivec4 animation = buildingAnimation[waterBuildingId];
+    if (animation.y < 0)
+    {
+        return t_gfx;
+    }
+
+    return t_gfx + getFrame(animation.x, animation.y) * animation.w;
+}
+
+//-------------------------------------------------
+// Main
+//-------------------------------------------------
+
+void main()
+{
+    // the instance Id is converted into a screen column (x - y) and a screen row (x + y)
+    int row = minRow + gl_InstanceID / nrOfColumns;
+    int column = minColumn + 2 * (gl_InstanceID % nrOfColumns);
+    column += (column + row) & 1;
+
+    ivec2 rotatedPosition = ivec2((row + column) / 2, (row - column) / 2);
+    if (!isDeepWater(unrotatePosition(rotatedPosition)))
+    {
+        // moves the vertex out of the clip space
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        vTextureAtlasIndex = NO_GFX;
+        return;
+    }
+
+    vec2 screenPosition = vec2(column * (tileWidth / 2), row * (tileHeight / 2));
+    screenPosition.y -= waterSize.y - float(tileHeight);
+
+    gl_Position = projectionView * vec4(screenPosition + aPosition.xy * waterSize, 0.0, 1.0);
+
+    int rows = int(nrOfRows);
+    int gfx = animateWater(waterGfx);
+
+    vec2 uvOffset = calcUvOffset(gfx, rows);
+    vTextureAtlasIndex = calcTextureAtlasIndex(gfx, rows);
+
+    vec2 uv = aPosition.zw;
+
+    vUv.x = (uv.x / nrOfRows) + uvOffset.x;
+    vUv.y = (uv.y / nrOfRows) + uvOffset.y;
+
+    if (uv.y == 1.0)
+    {
+        vUv.y = ((1.0 / nrOfRows) * textureHeight[gfx] / maxY) + uvOffset.y;
+    }
+}
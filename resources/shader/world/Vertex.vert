@@ -6,6 +6,9 @@
 
 layout (location = 0) in vec4 aPosition;
 
+// the position of the first instance of the island in the shared buffers
+layout (location = 1) in int aInstanceOffset;
+
 layout(std140, binding = 0) buffer modelMatrices
 {
     mat4 modelMatrix[];
@@ -31,6 +34,24 @@ layout(std430, binding = 4) buffer buildingAnimations
     ivec4 buildingAnimation[];
 };
 
+// the buildings are composed with the terrain at render time
+// when rendering a single layer, the same buffers are bound here
+
+layout(std140, binding = 5) buffer buildingsModelMatrices
+{
+    mat4 buildingsModelMatrix[];
+};
+
+layout(std430, binding = 6) buffer buildingsGfxNumbers
+{
+    ivec4 buildingsGfxNumber[];
+};
+
+layout(std430, binding = 7) buffer buildingsBuildingIds
+{
+    ivec4 buildingsBuildingId[];
+};
+
 //-------------------------------------------------
 // Out
 //-------------------------------------------------
@@ -42,16 +63,28 @@ flat out int vTextureAtlasIndex;
 // Uniforms
 //-------------------------------------------------
 
-uniform mat4 projectionView;
-uniform int worldRotation;
-uniform float maxY;
-uniform float nrOfRows;
-uniform int updates[5];
+// the same for all draws of a frame
+layout(std140, binding = 0) uniform frame
+{
+    mat4 projectionView;
+    int updates[5];
+    int worldRotation;
+    float maxY;
+    float nrOfRows;
+};
+
+//-------------------------------------------------
+// Constants
+//-------------------------------------------------
+
+const int NO_GFX = -1;
 
 //-------------------------------------------------
 // Globals
 //-------------------------------------------------
 
+mat4 instanceModelMatrix;
+int instanceBuildingId;
 vec2 uvOffset;
 vec2 uv;
 float height;
@@ -70,7 +103,6 @@ vec2 calcUvOffset(int t_gfx, int t_rows)
 
 int calcTextureAtlasIndex(int t_gfx, int t_rows)
 {
-    const int NO_GFX = -1;
     if (t_gfx == NO_GFX)
     {
         return NO_GFX;
@@ -107,7 +139,7 @@ int getFrame(int t_animCount, int t_animTime)
 
 void correctModelMatrix(float t_newHeight)
 {
-    mat4 m = modelMatrix[gl_InstanceID];
+    mat4 m = instanceModelMatrix;
 
     /* scaling
         x 0 0 0
@@ -131,8 +163,12 @@ void correctModelMatrix(float t_newHeight)
 
 void animateBuilding(int t_gfx, int t_rows)
 {
-    int building = int(buildingId[gl_InstanceID][worldRotation]);
-    ivec4 animation = ivec4(buildingAnimation[building]);
+    if (instanceBuildingId < 0)
+    {
+        return;
+    }
+
+    ivec4 animation = ivec4(buildingAnimation[instanceBuildingId]);
 
     int animAnz = animation.x;
     int animTime = animation.y;
@@ -161,10 +197,24 @@ void animateBuilding(int t_gfx, int t_rows)
 
 void main()
 {
-    gl_Position = projectionView * modelMatrix[gl_InstanceID] * vec4(aPosition.xy, 0.0, 1.0);
+    int instance = aInstanceOffset + gl_InstanceID;
+
+    int gfx = int(gfxNumber[instance][worldRotation]);
+    instanceModelMatrix = modelMatrix[instance];
+    instanceBuildingId = int(buildingId[instance][worldRotation]);
+
+    // a building replaces the terrain at the same position
+    int buildingsGfx = int(buildingsGfxNumber[instance][worldRotation]);
+    if (buildingsGfx != NO_GFX)
+    {
+        gfx = buildingsGfx;
+        instanceModelMatrix = buildingsModelMatrix[instance];
+        instanceBuildingId = int(buildingsBuildingId[instance][worldRotation]);
+    }
+
+    gl_Position = projectionView * instanceModelMatrix * vec4(aPosition.xy, 0.0, 1.0);
 
     int rows = int(nrOfRows);
-    int gfx = int(gfxNumber[gl_InstanceID][worldRotation]);
 
     uvOffset = calcUvOffset(gfx, rows);
     vTextureAtlasIndex = calcTextureAtlasIndex(gfx, rows);
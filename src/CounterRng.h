@@ -0,0 +1,141 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <cstdint>
+
+//-------------------------------------------------
+// CounterRng
+//-------------------------------------------------
+
+namespace mdcii
+{
+    /**
+     * A counter-based random number generator.
+     *
+     * Each number is a hash of the seed, a stream (e.g. the island index) and a counter.
+     * The numbers of a stream therefore do not depend on other streams
+     * or on the thread on which they are generated.
+     */
+    class CounterRng
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        /**
+         * Constructs a new CounterRng object.
+         *
+         * @param t_seed The seed.
+         * @param t_stream The independent stream of numbers.
+         */
+        CounterRng(const uint64_t t_seed, const uint64_t t_stream)
+            : m_key{ Mix(t_seed ^ Mix(t_stream + 0x9E3779B97F4A7C15ull)) }
+        {}
+
+        //-------------------------------------------------
+        // Random
+        //-------------------------------------------------
+
+        /**
+         * Gets the number at a given counter without changing the current counter.
+         *
+         * @param t_counter The counter.
+         *
+         * @return A random 64-bit number.
+         */
+        [[nodiscard]] uint64_t At(const uint64_t t_counter) const
+        {
+            return Mix(m_key + t_counter * 0x9E3779B97F4A7C15ull);
+        }
+
+        /**
+         * Gets the next random number.
+         *
+         * @return A random 64-bit number.
+         */
+        uint64_t Next()
+        {
+            return At(m_counter++);
+        }
+
+        /**
+         * Gets the next random number in a range.
+         *
+         * @param t_min The min value.
+         * @param t_max The max value (inclusive).
+         *
+         * @return A random number between min and max.
+         */
+        int32_t NextInt(const int32_t t_min, const int32_t t_max)
+        {
+            const auto range{ static_cast<uint64_t>(static_cast<int64_t>(t_max) - t_min) + 1 };
+
+            return static_cast<int32_t>(t_min + static_cast<int64_t>(Next() % range));
+        }
+
+        /**
+         * Gets the next random number in [0, 1).
+         *
+         * @return A random float.
+         */
+        float NextFloat()
+        {
+            return static_cast<float>(Next() >> 40) / static_cast<float>(1ull << 24);
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The key derived from seed and stream.
+         */
+        uint64_t m_key{ 0 };
+
+        /**
+         * The current counter.
+         */
+        uint64_t m_counter{ 0 };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * The SplitMix64 finalizer.
+         *
+         * @param t_value The value to hash.
+         *
+         * @return The hashed value.
+         */
+        static uint64_t Mix(uint64_t t_value)
+        {
+            t_value = (t_value ^ (t_value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            t_value = (t_value ^ (t_value >> 27)) * 0x94D049BB133111EBull;
+
+            return t_value ^ (t_value >> 31);
+        }
+    };
+}
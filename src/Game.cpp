@@ -16,6 +16,9 @@
 // along with this program; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #include "Game.h"
 #include "MdciiException.h"
 #include "MainMenuState.h"
@@ -24,13 +27,57 @@
 #include "camera/Camera.h"
 #include "state/StateStack.h"
 #include "ogl/Window.h"
+#include "ogl/Device.h"
+#include "event/EventManager.h"
 #include "file/OriginalResourcesManager.h"
+#include "profiler/Profiler.h"
+#include "profiler/FrameStatistics.h"
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+namespace
+{
+    double MillisecondsSince(const std::chrono::steady_clock::time_point t_start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t_start).count();
+    }
+
+    /**
+     * Sleeps most of the remaining time and yields for the last millisecond,
+     * because the sleep of the OS is not precise enough for the frame deadline.
+     */
+    void SleepUntil(const double t_deadline)
+    {
+        for (auto remaining{ t_deadline - glfwGetTime() }; remaining > 0.0; remaining = t_deadline - glfwGetTime())
+        {
+            if (remaining > 0.002)
+            {
+                std::this_thread::sleep_for(std::chrono::duration<double>(remaining - 0.001));
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void LogFrameStatistics(const std::string_view t_name, const mdcii::profiler::FrameStatistics& t_statistics)
+    {
+        mdcii::Log::MDCII_LOG_INFO(
+            "{:<7} min {:8.3f} | mean {:8.3f} | median {:8.3f} | p95 {:8.3f} | p99 {:8.3f} | max {:8.3f} ms",
+            t_name, t_statistics.min, t_statistics.mean, t_statistics.median, t_statistics.p95, t_statistics.p99, t_statistics.max
+        );
+    }
+}
 
 //-------------------------------------------------
 // Ctors. / Dtor.
 //-------------------------------------------------
 
-mdcii::Game::Game()
+mdcii::Game::Game(std::optional<HeadlessSettings> t_headlessSettings)
+    : m_headlessSettings{ std::move(t_headlessSettings) }
 {
     Log::MDCII_LOG_DEBUG("[Game::Game()] Create Game.");
 }
@@ -49,7 +96,17 @@ void mdcii::Game::Run()
     Log::MDCII_LOG_DEBUG("[Game::Run()] Starts running game.");
 
     Init();
-    GameLoop();
+
+    if (m_headlessSettings.has_value())
+    {
+        HeadlessLoop();
+    }
+    else
+    {
+        GameLoop();
+    }
+
+    event::EventManager::StopRecording(m_window->width, m_window->height);
 }
 
 //-------------------------------------------------
@@ -63,21 +120,38 @@ void mdcii::Game::Init()
     CreateSharedObjects();
     Start();
 
+    if (const auto& replayLog{ event::EventManager::GetReplayLog() };
+        event::EventManager::IsReplaying() && (replayLog.width != m_window->width || replayLog.height != m_window->height))
+    {
+        Log::MDCII_LOG_WARN("The input was recorded with a {}x{} window. The mouse positions will not match.", replayLog.width, replayLog.height);
+    }
+
     Log::MDCII_LOG_DEBUG("[Game::Init()] The game was successfully initialized.");
 }
 
-void mdcii::Game::Input() const
+bool mdcii::Game::Input() const
 {
+    MDCII_PROFILE_SCOPE("Input")
+
+    // all input events of the last frame are dispatched here
+    const auto dispatched{ event::EventManager::ProcessEvents() };
+
     m_stateStack->Input();
+
+    return dispatched;
 }
 
 void mdcii::Game::Update() const
 {
+    MDCII_PROFILE_SCOPE("Update")
+
     m_stateStack->Update();
 }
 
 void mdcii::Game::Render() const
 {
+    MDCII_PROFILE_SCOPE("Render")
+
     m_stateStack->Render();
 }
 
@@ -96,24 +170,45 @@ void mdcii::Game::GameLoop() const
     auto render{ 0 };
     auto updates{ 0 };
 
+    const auto maxFps{ INI.Get<int>("window", "max_fps") };
+    const auto minFrameTime{ maxFps > 0 ? 1.0 / maxFps : 0.0 };
+    const auto idleDelay{ INI.Get<double>("window", "idle_delay") };
+    auto lastActivityTime{ previousTime };
+
     while (!m_window->WindowShouldClose())
     {
+        MDCII_PROFILE_BEGIN_FRAME
+
         const auto currentTime{ glfwGetTime() };
         const auto elapsedTime{ currentTime - previousTime };
         previousTime = currentTime;
 
-        lag += elapsedTime;
+        // don't try to catch up after a long frame
+        lag = std::min(lag + elapsedTime, MAX_LAG);
 
-        Input();
+        if (Input() || m_stateStack->IsAnimating())
+        {
+            lastActivityTime = currentTime;
+        }
 
-        while (lag >= FRAME_TIME)
+        // recorded and replayed sessions use one update per frame, so that a replay does the same work
+        if (event::EventManager::IsRecording() || event::EventManager::IsReplaying())
         {
             Update();
             updates++;
-            lag -= FRAME_TIME;
+            lag = 0.0;
+        }
+        else
+        {
+            while (lag >= FRAME_TIME)
+            {
+                Update();
+                updates++;
+                lag -= FRAME_TIME;
+            }
         }
 
-        if (m_stateStack->IsEmpty())
+        if (m_stateStack->IsEmpty() || event::EventManager::IsReplayFinished())
         {
             m_window->Close();
         }
@@ -121,6 +216,28 @@ void mdcii::Game::GameLoop() const
         Render();
         render++;
 
+        MDCII_PROFILE_END_FRAME
+
+        // frame limiter
+        if (minFrameTime > 0.0)
+        {
+            SleepUntil(currentTime + minFrameTime);
+        }
+
+        // idle mode: nothing changed for a while, so the next frame waits for an event
+        if (idleDelay > 0.0 &&
+            !event::EventManager::IsRecording() &&
+            !event::EventManager::IsReplaying() &&
+            glfwGetTime() - lastActivityTime > idleDelay
+        )
+        {
+            glfwWaitEventsTimeout(IDLE_TIMEOUT);
+
+            // the idle wait is not simulated time, so waking up doesn't cause a burst of catch-up updates
+            lag = 0.0;
+            previousTime = glfwGetTime();
+        }
+
         if (glfwGetTime() - infoTimer > 1.0)
         {
             infoTimer++;
@@ -128,21 +245,113 @@ void mdcii::Game::GameLoop() const
             std::stringstream ss;
 #ifdef MDCII_DEBUG_BUILD
             ss << m_window->GetTitle() << " [DEBUG BUILD Version: " << VERSION << "]"
-               << "   |   Render: " << render << "   |   Updates: " << updates;
+               << "   |   Render: " << render << "   |   Updates: " << updates
+               << "   |   Events: " << event::EventManager::events_received << "/" << event::EventManager::events_dispatched;
 #else
             ss << m_window->GetTitle() << " [RELEASE BUILD Version: " << VERSION << "]"
-               << "   |   Render: " << render << "   |   Updates: " << updates;
+               << "   |   Render: " << render << "   |   Updates: " << updates
+               << "   |   Events: " << event::EventManager::events_received << "/" << event::EventManager::events_dispatched;
 #endif
             glfwSetWindowTitle(m_window->GetWindowHandle(), ss.str().c_str());
 
             updates = 0;
             render = 0;
+            event::EventManager::events_received = 0;
+            event::EventManager::events_dispatched = 0;
         }
     }
 
+#ifdef MDCII_PROFILING
+    profiler::Profiler::CleanUp();
+#endif
+
     Log::MDCII_LOG_DEBUG("[Game::GameLoop()] The game loop has ended.");
 }
 
+void mdcii::Game::HeadlessLoop() const
+{
+    auto settings{ m_headlessSettings.value() };
+
+    // a replay runs exactly the recorded frames; the first one is the loading frame
+    if (event::EventManager::IsReplaying())
+    {
+        settings.frames = std::max(static_cast<int32_t>(event::EventManager::GetReplayLog().frames) - 1, 0);
+    }
+
+    Log::MDCII_LOG_DEBUG("[Game::HeadlessLoop()] Starting the headless loop with {} frames.", settings.frames);
+
+    // the first input applies the pending push of the state, which loads the map
+    const auto loadStart{ std::chrono::steady_clock::now() };
+    Input();
+    const auto loadTime{ MillisecondsSince(loadStart) };
+
+    // only count the Gpu work of the measured frames
+    const auto& device{ ogl::Device::Get() };
+    const auto deviceStart{ device.statistics };
+
+    std::vector<double> updateTimes;
+    std::vector<double> renderTimes;
+    updateTimes.reserve(settings.frames);
+    renderTimes.reserve(settings.frames);
+
+    const auto runStart{ std::chrono::steady_clock::now() };
+    for (auto frame{ 0 }; frame < settings.frames; ++frame)
+    {
+        if (m_stateStack->IsEmpty())
+        {
+            throw MDCII_EXCEPTION("[Game::HeadlessLoop()] The game state was closed after " + std::to_string(frame) + " frames.");
+        }
+
+        MDCII_PROFILE_BEGIN_FRAME
+
+        Input();
+
+        // exactly one update per frame, so that each run does the same work
+        const auto updateStart{ std::chrono::steady_clock::now() };
+        Update();
+        updateTimes.push_back(MillisecondsSince(updateStart));
+
+        // wait for the Gpu, otherwise only the time to queue the commands is measured
+        const auto renderStart{ std::chrono::steady_clock::now() };
+        Render();
+        glFinish();
+        renderTimes.push_back(MillisecondsSince(renderStart));
+
+        MDCII_PROFILE_END_FRAME
+    }
+    const auto runTime{ MillisecondsSince(runStart) };
+
+    Log::MDCII_LOG_INFO("Headless run of {}: {} frames in {:.3f} ms ({:.1f} fps)",
+        settings.mapFilePath, settings.frames, runTime, runTime > 0.0 ? settings.frames * 1000.0 / runTime : 0.0);
+    Log::MDCII_LOG_INFO("{:<7} {:.3f} ms", "load", loadTime);
+    LogFrameStatistics("update", profiler::calc_frame_statistics(updateTimes));
+    LogFrameStatistics("render", profiler::calc_frame_statistics(renderTimes));
+
+    if (settings.frames > 0)
+    {
+        const auto gpu{ device.statistics - deviceStart };
+        Log::MDCII_LOG_INFO("{:<7} {:.1f} draws, {:.1f} instances, {:.1f} uploads, {:.1f} KiB per frame",
+            "device",
+            static_cast<double>(gpu.drawCalls) / settings.frames,
+            static_cast<double>(gpu.instancesDrawn) / settings.frames,
+            static_cast<double>(gpu.bufferUploads) / settings.frames,
+            static_cast<double>(gpu.bytesUploaded) / 1024.0 / settings.frames
+        );
+        Log::MDCII_LOG_INFO("{:<7} {:.1f} state changes, {:.1f} skipped per frame",
+            "state",
+            static_cast<double>(gpu.stateChanges) / settings.frames,
+            static_cast<double>(gpu.skippedStateChanges) / settings.frames
+        );
+    }
+
+#ifdef MDCII_PROFILING
+    profiler::Profiler::ExportChromeTrace("headless_trace.json");
+    profiler::Profiler::CleanUp();
+#endif
+
+    Log::MDCII_LOG_DEBUG("[Game::HeadlessLoop()] The headless loop has ended.");
+}
+
 //-------------------------------------------------
 // Helper
 //-------------------------------------------------
@@ -151,10 +360,16 @@ void mdcii::Game::CreateSharedObjects()
 {
     Log::MDCII_LOG_DEBUG("[Game::CreateSharedObjects()] Create shared objects.");
 
-    m_window = std::make_shared<ogl::Window>();
+    m_window = std::make_shared<ogl::Window>(m_headlessSettings.has_value());
     m_camera = std::make_shared<camera::Camera>(m_window->width, m_window->height);
     m_originalResourcesManager = std::make_shared<file::OriginalResourcesManager>();
-    m_stateStack = std::make_unique<state::StateStack>(std::make_unique<state::Context>(m_window, m_camera, m_originalResourcesManager));
+    auto context{ std::make_unique<state::Context>(m_window, m_camera, m_originalResourcesManager) };
+    if (m_headlessSettings.has_value())
+    {
+        context->headlessMapFilePath = m_headlessSettings->mapFilePath;
+    }
+
+    m_stateStack = std::make_unique<state::StateStack>(std::move(context));
 }
 
 void mdcii::Game::Start() const
@@ -166,6 +381,13 @@ void mdcii::Game::Start() const
     m_stateStack->RegisterState<GameState>(state::StateId::NEW_GAME);
     m_stateStack->RegisterState<GameState>(state::StateId::LOADED_GAME);
     m_stateStack->RegisterState<GameState>(state::StateId::EXAMPLE_GAME);
+    m_stateStack->RegisterState<GameState>(state::StateId::HEADLESS_GAME);
+
+    if (m_headlessSettings.has_value())
+    {
+        m_stateStack->PushState(state::StateId::HEADLESS_GAME);
+        return;
+    }
 
     if (const auto startStateId{ magic_enum::enum_cast<state::StateId>(INI.Get<std::string>("game", "start_state")) }; startStateId.has_value())
     {
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <optional>
 #include "ini/ini.h"
 #include "ecs/entt.hpp"
 
@@ -63,6 +64,22 @@ namespace mdcii::state
 
 namespace mdcii
 {
+    /**
+     * The settings to run the game without a visible window.
+     */
+    struct HeadlessSettings
+    {
+        /**
+         * The map to load, relative to the resources path.
+         */
+        std::string mapFilePath;
+
+        /**
+         * The number of frames to update and render.
+         */
+        int32_t frames{ 0 };
+    };
+
     /**
      * The main game object.
      */
@@ -83,6 +100,16 @@ namespace mdcii
          */
         static constexpr auto FRAME_TIME{ 1.0 / 60.0 };
 
+        /**
+         * The maximum time to catch up with updates after a long frame or an idle wait.
+         */
+        static constexpr auto MAX_LAG{ 0.25 };
+
+        /**
+         * The longest wait for events in idle mode. Keeps timers like the autosave running.
+         */
+        static constexpr auto IDLE_TIMEOUT{ 0.5 };
+
         //-------------------------------------------------
         // Member
         //-------------------------------------------------
@@ -103,7 +130,12 @@ namespace mdcii
         // Ctors. / Dtor.
         //-------------------------------------------------
 
-        Game();
+        /**
+         * Constructs a new Game object.
+         *
+         * @param t_headlessSettings Runs a benchmark without a visible window if set.
+         */
+        explicit Game(std::optional<HeadlessSettings> t_headlessSettings = std::nullopt);
 
         Game(const Game& t_other) = delete;
         Game(Game&& t_other) noexcept = delete;
@@ -145,12 +177,23 @@ namespace mdcii
          */
         std::unique_ptr<state::StateStack> m_stateStack;
 
+        /**
+         * Set if the game runs without a visible window.
+         */
+        std::optional<HeadlessSettings> m_headlessSettings;
+
         //-------------------------------------------------
         // Logic
         //-------------------------------------------------
 
         void Init();
-        void Input() const;
+        /**
+         * Dispatches the input events and handles the input of the States.
+         *
+         * @return True if any input event was dispatched.
+         */
+        bool Input() const;
+
         void Update() const;
         void Render() const;
 
@@ -160,6 +203,11 @@ namespace mdcii
 
         void GameLoop() const;
 
+        /**
+         * Runs a fixed number of frames and logs the timing statistics.
+         */
+        void HeadlessLoop() const;
+
         //-------------------------------------------------
         // Helper
         //-------------------------------------------------
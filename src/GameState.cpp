@@ -22,6 +22,7 @@
 #include "ogl/Window.h"
 #include "world/World.h"
 #include "state/StateStack.h"
+#include "profiler/Profiler.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -72,9 +73,18 @@ void mdcii::GameState::RenderImGui()
 
     m_world->RenderImGui();
 
+#ifdef MDCII_PROFILING
+    profiler::Profiler::RenderImGui();
+#endif
+
     ogl::Window::ImGuiEnd();
 }
 
+bool mdcii::GameState::IsAnimating() const
+{
+    return m_world->IsAnimating();
+}
+
 //-------------------------------------------------
 // Init
 //-------------------------------------------------
@@ -94,6 +104,9 @@ void mdcii::GameState::Init()
     case state::StateId::EXAMPLE_GAME:
         m_world = std::make_shared<world::World>(EXAMPLE_GAME_MAP, context, state::StateId::EXAMPLE_GAME);
         break;
+    case state::StateId::HEADLESS_GAME:
+        m_world = std::make_shared<world::World>(context->headlessMapFilePath, context, state::StateId::HEADLESS_GAME);
+        break;
     default:;
     }
 
@@ -82,6 +82,7 @@ namespace mdcii
         void Update() override;
         void Render() override;
         void RenderImGui() override;
+        [[nodiscard]] bool IsAnimating() const override;
 
     protected:
 
@@ -19,12 +19,47 @@
 #include "Log.h"
 #include "Game.h"
 #include "MdciiException.h"
+#include "file/SaveGame.h"
+#include "event/EventManager.h"
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+namespace
+{
+    constexpr auto USAGE{
+        "Usage: MDCII [--headless [<map file> [<frames>]]] [--record <input log>] [--replay <input log>]\n"
+        "       MDCII --convert-map <json file> <savegame file>"
+    };
+
+    int parse_frames(const std::string& t_value)
+    {
+        std::size_t end{ 0 };
+        auto frames{ -1 };
+        try
+        {
+            frames = std::stoi(t_value, &end);
+        }
+        catch (const std::exception&)
+        {
+            end = 0;
+        }
+
+        if (end != t_value.size() || frames < 0)
+        {
+            throw MDCII_EXCEPTION("[main()] Invalid number of frames " + t_value + ", expected a number >= 0.\n" + USAGE);
+        }
+
+        return frames;
+    }
+}
 
 //-------------------------------------------------
 // Main
 //-------------------------------------------------
 
-int main()
+int main(const int t_argc, char* t_argv[])
 {
     mdcii::Log::Init();
 
@@ -33,7 +68,62 @@ int main()
 
     try
     {
-        mdcii::Game game;
+        // converts a Json map into a savegame: --convert-map <json file> <savegame file>
+        if (t_argc == 4 && std::string(t_argv[1]) == "--convert-map")
+        {
+            mdcii::file::SaveGameWriter::ConvertJsonMap(t_argv[2], t_argv[3], mdcii::Game::INI.Get<bool>("content", "save_game_rle"));
+
+            return EXIT_SUCCESS;
+        }
+
+        // runs without a visible window and prints timing statistics: --headless [<map file> [<frames>]]
+        // records the input of a session: --record <input log>
+        // replays a recorded session at a fixed timestep: --replay <input log>
+        std::optional<mdcii::HeadlessSettings> headlessSettings;
+        if (mdcii::Game::INI.Get<bool>("headless", "enabled"))
+        {
+            headlessSettings = mdcii::HeadlessSettings{ mdcii::Game::INI.Get<std::string>("headless", "map"), parse_frames(mdcii::Game::INI.Get<std::string>("headless", "frames")) };
+        }
+
+        // true if the next argument is a value and not an option
+        const auto hasValue{ [&](const int t_index) { return t_index + 1 < t_argc && std::string(t_argv[t_index + 1]).rfind("--", 0) != 0; } };
+
+        for (auto i{ 1 }; i < t_argc; ++i)
+        {
+            const std::string argument{ t_argv[i] };
+
+            if (argument == "--headless")
+            {
+                if (!headlessSettings.has_value())
+                {
+                    headlessSettings = mdcii::HeadlessSettings{ mdcii::Game::INI.Get<std::string>("headless", "map"), parse_frames(mdcii::Game::INI.Get<std::string>("headless", "frames")) };
+                }
+
+                if (hasValue(i))
+                {
+                    headlessSettings->mapFilePath = t_argv[++i];
+                }
+
+                if (hasValue(i))
+                {
+                    headlessSettings->frames = parse_frames(t_argv[++i]);
+                }
+            }
+            else if (argument == "--record" && hasValue(i))
+            {
+                mdcii::event::EventManager::StartRecording(t_argv[++i]);
+            }
+            else if (argument == "--replay" && hasValue(i))
+            {
+                mdcii::event::EventManager::StartReplay(t_argv[++i]);
+            }
+            else
+            {
+                throw MDCII_EXCEPTION("[main()] Invalid argument " + argument + ".\n" + USAGE);
+            }
+        }
+
+        mdcii::Game game{ headlessSettings };
         game.Run();
 
         return EXIT_SUCCESS;
@@ -0,0 +1,204 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <future>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+//-------------------------------------------------
+// ThreadPool
+//-------------------------------------------------
+
+namespace mdcii
+{
+    /**
+     * A fixed number of worker threads processing tasks from a queue.
+     */
+    class ThreadPool
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        /**
+         * Constructs a new ThreadPool object and starts the worker threads.
+         *
+         * @param t_nrOfThreads The number of worker threads.
+         */
+        explicit ThreadPool(const uint32_t t_nrOfThreads = std::thread::hardware_concurrency())
+        {
+            const auto nrOfThreads{ t_nrOfThreads > 0 ? t_nrOfThreads : 1u };
+            for (auto i{ 0u }; i < nrOfThreads; ++i)
+            {
+                m_threads.emplace_back([this]() { Work(); });
+            }
+        }
+
+        ThreadPool(const ThreadPool& t_other) = delete;
+        ThreadPool(ThreadPool&& t_other) noexcept = delete;
+        ThreadPool& operator=(const ThreadPool& t_other) = delete;
+        ThreadPool& operator=(ThreadPool&& t_other) noexcept = delete;
+
+        /**
+         * Finishes the remaining tasks and joins the worker threads.
+         */
+        ~ThreadPool() noexcept
+        {
+            {
+                std::lock_guard lock{ m_mutex };
+                m_stop = true;
+            }
+
+            m_condition.notify_all();
+
+            for (auto& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * Returns the number of worker threads.
+         */
+        [[nodiscard]] size_t GetNrOfThreads() const { return m_threads.size(); }
+
+        //-------------------------------------------------
+        // Tasks
+        //-------------------------------------------------
+
+        /**
+         * Adds a task to the queue.
+         * An exception thrown by the task is rethrown by the returned future.
+         *
+         * @tparam T The type of the callable.
+         * @param t_task The callable without arguments.
+         *
+         * @return A future for the result of the task.
+         */
+        template<typename T>
+        auto Submit(T&& t_task) -> std::future<std::invoke_result_t<T>>
+        {
+            auto task{ std::make_shared<std::packaged_task<std::invoke_result_t<T>()>>(std::forward<T>(t_task)) };
+            auto future{ task->get_future() };
+
+            {
+                std::lock_guard lock{ m_mutex };
+                m_tasks.emplace([task]() { (*task)(); });
+            }
+
+            m_condition.notify_one();
+
+            return future;
+        }
+
+        /**
+         * Waits for all futures and rethrows the first exception.
+         *
+         * @tparam T The result type of the futures.
+         * @param t_futures The futures to wait for.
+         */
+        template<typename T>
+        static void WaitForAll(std::vector<std::future<T>>& t_futures)
+        {
+            for (auto& future : t_futures)
+            {
+                future.wait();
+            }
+
+            for (auto& future : t_futures)
+            {
+                future.get();
+            }
+
+            t_futures.clear();
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The worker threads.
+         */
+        std::vector<std::thread> m_threads;
+
+        /**
+         * The tasks waiting to be processed.
+         */
+        std::queue<std::function<void()>> m_tasks;
+
+        /**
+         * Protects the task queue and the stop flag.
+         */
+        std::mutex m_mutex;
+
+        /**
+         * Wakes up the worker threads.
+         */
+        std::condition_variable m_condition;
+
+        /**
+         * Set to true to stop the worker threads.
+         */
+        bool m_stop{ false };
+
+        //-------------------------------------------------
+        // Worker
+        //-------------------------------------------------
+
+        /**
+         * The loop of each worker thread.
+         */
+        void Work()
+        {
+            while (true)
+            {
+                std::function<void()> task;
+
+                {
+                    std::unique_lock lock{ m_mutex };
+                    m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+
+                    if (m_stop && m_tasks.empty())
+                    {
+                        return;
+                    }
+
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop();
+                }
+
+                task();
+            }
+        }
+    };
+}
@@ -0,0 +1,87 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#include <thread>
+#include "Log.h"
+#include "MdciiException.h"
+#include "world/World.h"
+#include "world/WorldGenerator.h"
+
+//-------------------------------------------------
+// Main
+//-------------------------------------------------
+
+/*
+ * Creates a random world without starting the game:
+ * MDCII_WORLDGEN <world width> <world height> <number of islands> <seed> <output file> [number of threads]
+ * An output file with the extension .sav is written as a savegame, otherwise as a Json map.
+ */
+int main(const int t_argc, char* t_argv[])
+{
+    mdcii::Log::Init();
+
+    try
+    {
+        if (t_argc != 6 && t_argc != 7)
+        {
+            mdcii::Log::MDCII_LOG_ERROR("Usage: MDCII_WORLDGEN <width> <height> <islands> <seed> <output file> [threads]");
+
+            return EXIT_FAILURE;
+        }
+
+        const auto width{ std::stoi(t_argv[1]) };
+        const auto height{ std::stoi(t_argv[2]) };
+        const auto nrOfIslands{ std::stoi(t_argv[3]) };
+        const auto seed{ std::stoull(t_argv[4]) };
+        const std::string filePath{ t_argv[5] };
+        const auto nrOfThreads{ t_argc == 7 ? static_cast<uint32_t>(std::stoul(t_argv[6])) : std::thread::hardware_concurrency() };
+
+        if (width < mdcii::world::World::WORLD_MIN_WIDTH || width > mdcii::world::World::WORLD_MAX_WIDTH ||
+            height < mdcii::world::World::WORLD_MIN_HEIGHT || height > mdcii::world::World::WORLD_MAX_HEIGHT)
+        {
+            throw MDCII_EXCEPTION("[main()] Invalid world size " + std::to_string(width) + "x" + std::to_string(height) + ".");
+        }
+
+        if (nrOfIslands < 1)
+        {
+            throw MDCII_EXCEPTION("[main()] At least one island is required.");
+        }
+
+        const auto islands{ mdcii::world::WorldGenerator::CreateIslandSettings(width, height, nrOfIslands, mdcii::world::WorldGenerator::ISLAND_WATER_MARGIN, seed) };
+        mdcii::world::WorldGenerator::CreateWorld(filePath, width, height, islands, seed, nrOfThreads);
+
+        mdcii::Log::MDCII_LOG_INFO("[main()] The world was written to file {}.", filePath);
+
+        return EXIT_SUCCESS;
+    }
+    catch (const mdcii::MdciiException& e)
+    {
+        mdcii::Log::MDCII_LOG_ERROR("MdciiException {}", e.what());
+    }
+    catch (const std::exception& e)
+    {
+        mdcii::Log::MDCII_LOG_ERROR("Standard Exception: {}", e.what());
+    }
+    catch (...)
+    {
+        mdcii::Log::MDCII_LOG_ERROR("Unknown Exception. No details available.");
+    }
+
+    return EXIT_FAILURE;
+}
@@ -17,12 +17,30 @@
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
 #include <imgui.h>
+#include <magic_enum.hpp>
 #include "EventManager.h"
+#include "Log.h"
 
 //-------------------------------------------------
 // Init
 //-------------------------------------------------
 
+void mdcii::event::EventManager::InitEventQueue()
+{
+    // the queue only buffers the events, the listeners are registered on the event_dispatcher
+    magic_enum::enum_for_each<MdciiEventType>([](const MdciiEventType t_type) {
+        event_queue.appendListener(t_type, [](const MdciiEventType t_eventType, const std::shared_ptr<MdciiEvent>& t_event) {
+            if (m_recording)
+            {
+                m_recordLog.records.push_back({ frame, t_event });
+            }
+
+            event_dispatcher.dispatch(t_eventType, *t_event);
+            events_dispatched++;
+        });
+    });
+}
+
 void mdcii::event::EventManager::SetKeyboardGlfwCallbacks(GLFWwindow* t_windowHandle)
 {
     // Registers a callback that will be invoked when a key is pressed or released
@@ -48,13 +66,13 @@ void mdcii::event::EventManager::SetKeyboardGlfwCallbacks(GLFWwindow* t_windowHa
             switch (t_action)
             {
             case GLFW_PRESS:
-                event_dispatcher.dispatch(MdciiEventType::KEY_PRESSED, KeyPressedEvent(t_key));
+                Enqueue(std::make_shared<KeyPressedEvent>(t_key));
                 break;
             case GLFW_RELEASE:
-                event_dispatcher.dispatch(MdciiEventType::KEY_RELEASED, KeyReleasedEvent(t_key));
+                Enqueue(std::make_shared<KeyReleasedEvent>(t_key));
                 break;
             case GLFW_REPEAT:
-                event_dispatcher.dispatch(MdciiEventType::KEY_PRESSED, KeyPressedEvent(t_key, 1));
+                Enqueue(std::make_shared<KeyPressedEvent>(t_key, 1));
                 break;
             default:;
             }
@@ -78,13 +96,7 @@ void mdcii::event::EventManager::SetMouseGlfwCallbacks(GLFWwindow* t_windowHandl
     glfwSetCursorPosCallback(
         t_windowHandle,
         [](GLFWwindow* t_window, const double t_x, const double t_y) {
-            event_dispatcher.dispatch(
-                MdciiEventType::MOUSE_MOVED,
-                MouseMovedEvent(
-                    static_cast<float>(t_x),
-                    static_cast<float>(t_y)
-                )
-            );
+            EnqueueMouseMoved(std::make_shared<MouseMovedEvent>(static_cast<float>(t_x), static_cast<float>(t_y)));
         }
     );
 
@@ -98,13 +110,7 @@ void mdcii::event::EventManager::SetMouseGlfwCallbacks(GLFWwindow* t_windowHandl
             io.MouseWheel += static_cast<float>(t_yOffset);
 
             // MDCII
-            event_dispatcher.dispatch(
-                MdciiEventType::MOUSE_SCROLLED,
-                MouseScrolledEvent(
-                    static_cast<float>(t_xOffset),
-                    static_cast<float>(t_yOffset)
-                )
-            );
+            Enqueue(std::make_shared<MouseScrolledEvent>(static_cast<float>(t_xOffset), static_cast<float>(t_yOffset)));
         }
     );
 
@@ -112,7 +118,7 @@ void mdcii::event::EventManager::SetMouseGlfwCallbacks(GLFWwindow* t_windowHandl
     glfwSetCursorEnterCallback(
         t_windowHandle,
         [](GLFWwindow* t_window, const int t_entered) {
-            event_dispatcher.dispatch(MdciiEventType::MOUSE_ENTER, MouseEnterEvent(t_entered));
+            Enqueue(std::make_shared<MouseEnterEvent>(t_entered));
         }
     );
 
@@ -123,13 +129,146 @@ void mdcii::event::EventManager::SetMouseGlfwCallbacks(GLFWwindow* t_windowHandl
             switch (t_action)
             {
             case GLFW_PRESS:
-                event_dispatcher.dispatch(MdciiEventType::MOUSE_BUTTON_PRESSED, MouseButtonPressedEvent(t_button));
+                Enqueue(std::make_shared<MouseButtonPressedEvent>(t_button));
                 break;
             case GLFW_RELEASE:
-                event_dispatcher.dispatch(MdciiEventType::MOUSE_BUTTON_RELEASED, MouseButtonReleasedEvent(t_button));
+                Enqueue(std::make_shared<MouseButtonReleasedEvent>(t_button));
                 break;
             default:;
             }
         }
     );
 }
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+bool mdcii::event::EventManager::ProcessEvents()
+{
+    if (m_replaying)
+    {
+        // the live input is ignored, the events come from the log
+        event_queue.clearEvents();
+        m_pendingMouseMoved.reset();
+        EnqueueReplayedEvents();
+    }
+    else
+    {
+        FlushMouseMoved();
+    }
+
+    const auto dispatched{ event_queue.process() };
+    frame++;
+
+    return dispatched;
+}
+
+//-------------------------------------------------
+// Record / Replay
+//-------------------------------------------------
+
+void mdcii::event::EventManager::StartRecording(const std::string& t_filePath)
+{
+    Log::MDCII_LOG_DEBUG("[EventManager::StartRecording()] Record input to {}.", t_filePath);
+
+    m_recording = true;
+    m_recordFilePath = t_filePath;
+    m_recordLog = InputLog();
+}
+
+void mdcii::event::EventManager::StopRecording(const int32_t t_width, const int32_t t_height)
+{
+    if (!m_recording)
+    {
+        return;
+    }
+
+    m_recordLog.width = t_width;
+    m_recordLog.height = t_height;
+    m_recordLog.frames = frame;
+    m_recordLog.Save(m_recordFilePath);
+
+    Log::MDCII_LOG_INFO("Recorded {} input events in {} frames to {}.", m_recordLog.records.size(), frame, m_recordFilePath);
+
+    m_recording = false;
+    m_recordLog = InputLog();
+}
+
+void mdcii::event::EventManager::StartReplay(const std::string& t_filePath)
+{
+    Log::MDCII_LOG_DEBUG("[EventManager::StartReplay()] Replay input from {}.", t_filePath);
+
+    m_replayLog.Load(t_filePath);
+    m_replayIndex = 0;
+    m_replaying = true;
+
+    Log::MDCII_LOG_INFO("Replay {} input events in {} frames from {}.", m_replayLog.records.size(), m_replayLog.frames, t_filePath);
+}
+
+bool mdcii::event::EventManager::IsReplayMouseButtonDown(const int t_button)
+{
+    return t_button >= 0 && t_button <= GLFW_MOUSE_BUTTON_LAST && m_replayMouseButtons.at(t_button);
+}
+
+//-------------------------------------------------
+// Enqueue
+//-------------------------------------------------
+
+void mdcii::event::EventManager::Enqueue(const std::shared_ptr<MdciiEvent>& t_event)
+{
+    // keep the order: a button press must see the mouse position before it
+    FlushMouseMoved();
+
+    event_queue.enqueue(t_event->type, t_event);
+    events_received++;
+}
+
+void mdcii::event::EventManager::EnqueueMouseMoved(const std::shared_ptr<MouseMovedEvent>& t_event)
+{
+    m_pendingMouseMoved = t_event;
+    events_received++;
+}
+
+void mdcii::event::EventManager::FlushMouseMoved()
+{
+    if (m_pendingMouseMoved)
+    {
+        event_queue.enqueue(MdciiEventType::MOUSE_MOVED, m_pendingMouseMoved);
+        m_pendingMouseMoved.reset();
+    }
+}
+
+void mdcii::event::EventManager::EnqueueReplayedEvents()
+{
+    const auto& records{ m_replayLog.records };
+    for (; m_replayIndex < records.size() && records[m_replayIndex].frame <= frame; ++m_replayIndex)
+    {
+        const auto& event{ records[m_replayIndex].event };
+        switch (event->type)
+        {
+        case MdciiEventType::MOUSE_MOVED:
+        {
+            const auto& mouseMoved{ static_cast<const MouseMovedEvent&>(*event) };
+            m_replayMousePosition = glm::vec2(mouseMoved.x, mouseMoved.y);
+            break;
+        }
+        case MdciiEventType::MOUSE_BUTTON_PRESSED:
+            if (const auto button{ static_cast<const MouseButtonPressedEvent&>(*event).button }; button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST)
+            {
+                m_replayMouseButtons.at(button) = true;
+            }
+            break;
+        case MdciiEventType::MOUSE_BUTTON_RELEASED:
+            if (const auto button{ static_cast<const MouseButtonReleasedEvent&>(*event).button }; button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST)
+            {
+                m_replayMouseButtons.at(button) = false;
+            }
+            break;
+        default:;
+        }
+
+        event_queue.enqueue(event->type, event);
+        events_received++;
+    }
+}
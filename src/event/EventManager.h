@@ -18,8 +18,13 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
+#include <glm/vec2.hpp>
 #include "Event.h"
+#include "InputLog.h"
 #include "eventpp/eventdispatcher.h"
+#include "eventpp/eventqueue.h"
 #include "ogl/OpenGL.h"
 
 //-------------------------------------------------
@@ -30,6 +35,8 @@ namespace mdcii::event
 {
     /**
      * Static event handling.
+     * The Glfw callbacks only enqueue the events. Once per frame, ProcessEvents()
+     * passes them in order to the listeners of the event_dispatcher.
      */
     class EventManager
     {
@@ -40,6 +47,24 @@ namespace mdcii::event
 
         inline static eventpp::EventDispatcher<MdciiEventType, void(const MdciiEvent&)> event_dispatcher;
 
+        inline static eventpp::EventQueue<MdciiEventType, void(MdciiEventType, const std::shared_ptr<MdciiEvent>&)> event_queue;
+
+        /**
+         * The number of events received from Glfw.
+         */
+        inline static int32_t events_received{ 0 };
+
+        /**
+         * The number of events passed to the event_dispatcher.
+         * Mouse moves within a frame are coalesced, so this can be less than events_received.
+         */
+        inline static int32_t events_dispatched{ 0 };
+
+        /**
+         * The number of processed frames.
+         */
+        inline static uint32_t frame{ 0 };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -53,12 +78,120 @@ namespace mdcii::event
         // Init
         //-------------------------------------------------
 
+        static void InitEventQueue();
         static void SetKeyboardGlfwCallbacks(GLFWwindow* t_windowHandle);
         static void SetMouseGlfwCallbacks(GLFWwindow* t_windowHandle);
 
+        //-------------------------------------------------
+        // Enqueue
+        //-------------------------------------------------
+
+        /**
+         * Enqueues an event. A pending mouse move is enqueued before.
+         *
+         * @param t_event The event to enqueue.
+         */
+        static void Enqueue(const std::shared_ptr<MdciiEvent>& t_event);
+
+        /**
+         * Replaces the pending mouse move.
+         *
+         * @param t_event The new mouse move.
+         */
+        static void EnqueueMouseMoved(const std::shared_ptr<MouseMovedEvent>& t_event);
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Dispatches all events received since the last call.
+         *
+         * @return True if any event was dispatched.
+         */
+        static bool ProcessEvents();
+
+        //-------------------------------------------------
+        // Record / Replay
+        //-------------------------------------------------
+
+        /**
+         * Records all dispatched events from now on.
+         *
+         * @param t_filePath The file written by StopRecording().
+         */
+        static void StartRecording(const std::string& t_filePath);
+
+        /**
+         * Writes the recorded events.
+         *
+         * @param t_width The width of the window.
+         * @param t_height The height of the window.
+         */
+        static void StopRecording(int32_t t_width, int32_t t_height);
+
+        /**
+         * Replaces the input from Glfw with the events of a recorded session.
+         *
+         * @param t_filePath The file written by StopRecording().
+         */
+        static void StartReplay(const std::string& t_filePath);
+
+        [[nodiscard]] static bool IsRecording() { return m_recording; }
+        [[nodiscard]] static bool IsReplaying() { return m_replaying; }
+        [[nodiscard]] static bool IsReplayFinished() { return m_replaying && frame >= m_replayLog.frames; }
+        [[nodiscard]] static const InputLog& GetReplayLog() { return m_replayLog; }
+
+        /**
+         * The mouse position of the replayed events, used instead of polling Glfw.
+         */
+        [[nodiscard]] static const glm::vec2& GetReplayMousePosition() { return m_replayMousePosition; }
+
+        /**
+         * The state of a mouse button of the replayed events, used instead of polling Glfw.
+         *
+         * @param t_button A constant such as GLFW_MOUSE_BUTTON_LEFT.
+         *
+         * @return True if the button is down.
+         */
+        [[nodiscard]] static bool IsReplayMouseButtonDown(int t_button);
+
     protected:
 
     private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The last mouse move that has not yet been enqueued.
+         */
+        inline static std::shared_ptr<MouseMovedEvent> m_pendingMouseMoved;
+
+        inline static bool m_recording{ false };
+        inline static std::string m_recordFilePath;
+        inline static InputLog m_recordLog;
+
+        inline static bool m_replaying{ false };
+        inline static InputLog m_replayLog;
+        inline static std::size_t m_replayIndex{ 0 };
+        inline static glm::vec2 m_replayMousePosition{ 0.0f };
+        inline static std::array<bool, GLFW_MOUSE_BUTTON_LAST + 1> m_replayMouseButtons{};
+
+        //-------------------------------------------------
+        // Enqueue
+        //-------------------------------------------------
+
+        /**
+         * Enqueues the pending mouse move, if any.
+         */
+        static void FlushMouseMoved();
+
+        /**
+         * Enqueues the recorded events of the current frame.
+         */
+        static void EnqueueReplayedEvents();
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -0,0 +1,299 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Event.h"
+#include "MdciiException.h"
+
+//-------------------------------------------------
+// InputLog
+//-------------------------------------------------
+
+namespace mdcii::event
+{
+    /**
+     * An event and the frame in which it was dispatched.
+     */
+    struct InputRecord
+    {
+        uint32_t frame{ 0 };
+        std::shared_ptr<MdciiEvent> event;
+    };
+
+    /**
+     * A recorded input session.
+     *
+     * The binary format starts with a header (magic, version, window size, number of frames).
+     * Each record follows with the frame delta as varint, the event type as one byte
+     * and the payload of the event in the native byte order.
+     */
+    class InputLog
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr std::array<char, 4> MAGIC{ 'M', 'D', 'I', 'L' };
+        static constexpr uint32_t VERSION{ 1 };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The window size while recording. The mouse positions are only valid for this size.
+         */
+        int32_t width{ 0 };
+        int32_t height{ 0 };
+
+        /**
+         * The number of recorded frames.
+         */
+        uint32_t frames{ 0 };
+
+        /**
+         * The events sorted by frame.
+         */
+        std::vector<InputRecord> records;
+
+        //-------------------------------------------------
+        // Write
+        //-------------------------------------------------
+
+        void Write(std::ostream& t_out) const
+        {
+            t_out.write(MAGIC.data(), MAGIC.size());
+            WriteValue(t_out, VERSION);
+            WriteValue(t_out, width);
+            WriteValue(t_out, height);
+            WriteValue(t_out, frames);
+            WriteValue(t_out, static_cast<uint32_t>(records.size()));
+
+            uint32_t lastFrame{ 0 };
+            for (const auto& record : records)
+            {
+                WriteVarint(t_out, record.frame - lastFrame);
+                lastFrame = record.frame;
+
+                WriteValue(t_out, static_cast<uint8_t>(record.event->type));
+                switch (record.event->type)
+                {
+                case MdciiEventType::KEY_PRESSED:
+                {
+                    const auto& event{ static_cast<const KeyPressedEvent&>(*record.event) };
+                    WriteValue(t_out, static_cast<int32_t>(event.key));
+                    WriteValue(t_out, static_cast<int32_t>(event.repeatCount));
+                    break;
+                }
+                case MdciiEventType::KEY_RELEASED:
+                    WriteValue(t_out, static_cast<int32_t>(static_cast<const KeyReleasedEvent&>(*record.event).key));
+                    break;
+                case MdciiEventType::MOUSE_BUTTON_PRESSED:
+                    WriteValue(t_out, static_cast<int32_t>(static_cast<const MouseButtonPressedEvent&>(*record.event).button));
+                    break;
+                case MdciiEventType::MOUSE_BUTTON_RELEASED:
+                    WriteValue(t_out, static_cast<int32_t>(static_cast<const MouseButtonReleasedEvent&>(*record.event).button));
+                    break;
+                case MdciiEventType::MOUSE_MOVED:
+                {
+                    const auto& event{ static_cast<const MouseMovedEvent&>(*record.event) };
+                    WriteValue(t_out, event.x);
+                    WriteValue(t_out, event.y);
+                    break;
+                }
+                case MdciiEventType::MOUSE_SCROLLED:
+                {
+                    const auto& event{ static_cast<const MouseScrolledEvent&>(*record.event) };
+                    WriteValue(t_out, event.xOffset);
+                    WriteValue(t_out, event.yOffset);
+                    break;
+                }
+                case MdciiEventType::MOUSE_ENTER:
+                    WriteValue(t_out, static_cast<uint8_t>(static_cast<const MouseEnterEvent&>(*record.event).enter));
+                    break;
+                default:
+                    throw MDCII_EXCEPTION("[InputLog::Write()] Invalid event type.");
+                }
+            }
+        }
+
+        void Save(const std::string& t_filePath) const
+        {
+            std::ofstream file{ t_filePath, std::ios::binary };
+            if (!file)
+            {
+                throw MDCII_EXCEPTION("[InputLog::Save()] Unable to open file " + t_filePath + ".");
+            }
+
+            Write(file);
+
+            // a full disk is only noticed when the buffer is written
+            file.flush();
+            if (!file)
+            {
+                throw MDCII_EXCEPTION("[InputLog::Save()] Error while writing file " + t_filePath + ".");
+            }
+        }
+
+        //-------------------------------------------------
+        // Read
+        //-------------------------------------------------
+
+        void Read(std::istream& t_in)
+        {
+            std::array<char, 4> magic{};
+            if (!t_in.read(magic.data(), magic.size()) || magic != MAGIC)
+            {
+                throw MDCII_EXCEPTION("[InputLog::Read()] Invalid input log.");
+            }
+
+            if (ReadValue<uint32_t>(t_in) != VERSION)
+            {
+                throw MDCII_EXCEPTION("[InputLog::Read()] Unsupported input log version.");
+            }
+
+            width = ReadValue<int32_t>(t_in);
+            height = ReadValue<int32_t>(t_in);
+            frames = ReadValue<uint32_t>(t_in);
+
+            // the count is not trusted for an allocation, a truncated log throws while reading the records
+            const auto count{ ReadValue<uint32_t>(t_in) };
+            records.clear();
+
+            uint32_t frame{ 0 };
+            for (uint32_t i{ 0 }; i < count; ++i)
+            {
+                frame += ReadVarint(t_in);
+
+                InputRecord record{ frame, nullptr };
+                switch (static_cast<MdciiEventType>(ReadValue<uint8_t>(t_in)))
+                {
+                case MdciiEventType::KEY_PRESSED:
+                {
+                    const auto key{ ReadValue<int32_t>(t_in) };
+                    record.event = std::make_shared<KeyPressedEvent>(key, ReadValue<int32_t>(t_in));
+                    break;
+                }
+                case MdciiEventType::KEY_RELEASED:
+                    record.event = std::make_shared<KeyReleasedEvent>(ReadValue<int32_t>(t_in));
+                    break;
+                case MdciiEventType::MOUSE_BUTTON_PRESSED:
+                    record.event = std::make_shared<MouseButtonPressedEvent>(ReadValue<int32_t>(t_in));
+                    break;
+                case MdciiEventType::MOUSE_BUTTON_RELEASED:
+                    record.event = std::make_shared<MouseButtonReleasedEvent>(ReadValue<int32_t>(t_in));
+                    break;
+                case MdciiEventType::MOUSE_MOVED:
+                {
+                    const auto x{ ReadValue<float>(t_in) };
+                    record.event = std::make_shared<MouseMovedEvent>(x, ReadValue<float>(t_in));
+                    break;
+                }
+                case MdciiEventType::MOUSE_SCROLLED:
+                {
+                    const auto xOffset{ ReadValue<float>(t_in) };
+                    record.event = std::make_shared<MouseScrolledEvent>(xOffset, ReadValue<float>(t_in));
+                    break;
+                }
+                case MdciiEventType::MOUSE_ENTER:
+                    record.event = std::make_shared<MouseEnterEvent>(ReadValue<uint8_t>(t_in) != 0);
+                    break;
+                default:
+                    throw MDCII_EXCEPTION("[InputLog::Read()] Invalid event type.");
+                }
+
+                records.push_back(std::move(record));
+            }
+        }
+
+        void Load(const std::string& t_filePath)
+        {
+            std::ifstream file{ t_filePath, std::ios::binary };
+            if (!file)
+            {
+                throw MDCII_EXCEPTION("[InputLog::Load()] Unable to open file " + t_filePath + ".");
+            }
+
+            Read(file);
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        template<typename T>
+        static void WriteValue(std::ostream& t_out, const T t_value)
+        {
+            t_out.write(reinterpret_cast<const char*>(&t_value), sizeof(T));
+        }
+
+        template<typename T>
+        static T ReadValue(std::istream& t_in)
+        {
+            T value{};
+            if (!t_in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+            {
+                throw MDCII_EXCEPTION("[InputLog::ReadValue()] Unexpected end of input log.");
+            }
+
+            return value;
+        }
+
+        /**
+         * Most events follow within a few frames, so the delta mostly needs one byte.
+         */
+        static void WriteVarint(std::ostream& t_out, uint32_t t_value)
+        {
+            while (t_value >= 0x80)
+            {
+                WriteValue(t_out, static_cast<uint8_t>(t_value | 0x80));
+                t_value >>= 7;
+            }
+
+            WriteValue(t_out, static_cast<uint8_t>(t_value));
+        }
+
+        static uint32_t ReadVarint(std::istream& t_in)
+        {
+            uint32_t value{ 0 };
+            for (auto shift{ 0 }; shift < 35; shift += 7)
+            {
+                const auto byte{ ReadValue<uint8_t>(t_in) };
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return value;
+                }
+            }
+
+            throw MDCII_EXCEPTION("[InputLog::ReadVarint()] Invalid varint.");
+        }
+    };
+}
@@ -109,6 +109,7 @@ void mdcii::file::BshFile::DecodePixelData(const uint32_t t_offset)
     bshTexture->width = width;
     bshTexture->height = height;
     bshTexture->pixel.resize(static_cast<size_t>(width) * height);
+    bshTexture->alphaMask.resize(static_cast<size_t>(bshTexture->GetAlphaMaskStride()) * height);
 
     auto x{ 0 };
     auto y{ 0 };
@@ -142,6 +143,7 @@ void mdcii::file::BshFile::DecodePixelData(const uint32_t t_offset)
         {
             const auto colorIndex{ static_cast<uint8_t>(*(offset += sizeof(uint8_t))) };
             bshTexture->pixel[static_cast<size_t>(y) * width + x] = m_palette[colorIndex];
+            bshTexture->alphaMask[static_cast<size_t>(y) * bshTexture->GetAlphaMaskStride() + x / 64] |= uint64_t{ 1 } << (x % 64);
             x++;
         }
     }
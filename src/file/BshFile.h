@@ -52,6 +52,39 @@ namespace mdcii::file
          * So this graphic is accessible to the Gpu.
          */
         uint32_t textureId{ 0 };
+
+        /**
+         * One bit for each pixel, set if the pixel is not transparent.
+         * Each row starts with a new 64-bit word. Is kept after the pixels are cleared.
+         */
+        std::vector<uint64_t> alphaMask;
+
+        /**
+         * Get the number of 64-bit words in each row of the alphaMask.
+         *
+         * @return The number of words.
+         */
+        [[nodiscard]] uint32_t GetAlphaMaskStride() const { return (width + 63) / 64; }
+
+        /**
+         * Checks whether a pixel is visible.
+         *
+         * @param t_x The x position in the gfx.
+         * @param t_y The y position in the gfx.
+         *
+         * @return False if the pixel is transparent or outside of the gfx.
+         */
+        [[nodiscard]] bool IsOpaque(const int32_t t_x, const int32_t t_y) const
+        {
+            if (t_x < 0 || t_y < 0 || t_x >= static_cast<int32_t>(width) || t_y >= static_cast<int32_t>(height) || alphaMask.empty())
+            {
+                return false;
+            }
+
+            const auto word{ alphaMask[static_cast<size_t>(t_y) * GetAlphaMaskStride() + t_x / 64] };
+
+            return (word >> (t_x % 64)) & 1;
+        }
     };
 
 
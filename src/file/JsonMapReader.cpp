@@ -0,0 +1,335 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <fstream>
+#include "JsonMapReader.h"
+#include "Game.h"
+#include "Log.h"
+#include "MdciiException.h"
+#include "data/json.hpp"
+#include "layer/Tile.h"
+
+//-------------------------------------------------
+// JsonMapSaxHandler
+//-------------------------------------------------
+
+namespace
+{
+    /**
+     * Creates the islands and Tile objects of a Json map from SAX events.
+     * The result is the same as reading the Json value with from_json.
+     */
+    class JsonMapSaxHandler : public nlohmann::json_sax<nlohmann::json>
+    {
+    public:
+        JsonMapSaxHandler(mdcii::file::JsonMapReader& t_reader, const mdcii::file::JsonMapReader::Island_Callback& t_islandCallback)
+            : m_reader{ t_reader }
+            , m_islandCallback{ t_islandCallback }
+        {}
+
+        bool null() override
+        {
+            // a null Tile is a Tile without building
+            if (IsCurrent(Scope::TILES))
+            {
+                m_currentTiles->emplace_back(std::make_shared<mdcii::layer::Tile>());
+            }
+
+            return true;
+        }
+
+        bool boolean(bool) override { return true; }
+
+        bool number_integer(const number_integer_t t_val) override
+        {
+            Number(static_cast<int32_t>(t_val));
+            return true;
+        }
+
+        bool number_unsigned(const number_unsigned_t t_val) override
+        {
+            Number(static_cast<int32_t>(t_val));
+            return true;
+        }
+
+        bool number_float(const number_float_t t_val, const string_t&) override
+        {
+            Number(static_cast<int32_t>(t_val));
+            return true;
+        }
+
+        bool string(string_t& t_val) override
+        {
+            if (IsCurrent(Scope::ROOT) && m_frames.back().key == "version")
+            {
+                // stop before any further island is created
+                if (t_val != mdcii::Game::VERSION)
+                {
+                    throw MDCII_EXCEPTION("[JsonMapSaxHandler::string()] Invalid map file format.");
+                }
+
+                m_reader.version = t_val;
+            }
+
+            return true;
+        }
+
+        bool binary(binary_t&) override { return true; }
+
+        bool start_object(std::size_t) override
+        {
+            auto scope{ Scope::IGNORED };
+            if (m_frames.empty())
+            {
+                scope = Scope::ROOT;
+            }
+            else if (IsCurrent(Scope::ROOT) && m_frames.back().key == "world")
+            {
+                scope = Scope::WORLD;
+            }
+            else if (IsCurrent(Scope::ISLANDS))
+            {
+                scope = Scope::ISLAND;
+                m_island = mdcii::file::JsonMapIsland();
+            }
+            else if (IsCurrent(Scope::LAYERS))
+            {
+                scope = Scope::LAYER;
+            }
+            else if (IsCurrent(Scope::TILES))
+            {
+                scope = Scope::TILE;
+                m_currentTiles->emplace_back(std::make_shared<mdcii::layer::Tile>());
+            }
+
+            m_frames.push_back({ scope, {} });
+
+            return true;
+        }
+
+        bool key(string_t& t_val) override
+        {
+            m_frames.back().key = t_val;
+            return true;
+        }
+
+        bool end_object() override
+        {
+            const auto scope{ m_frames.back().scope };
+            m_frames.pop_back();
+
+            if (scope == Scope::ISLAND)
+            {
+                m_islandCallback(m_island);
+            }
+
+            return true;
+        }
+
+        bool start_array(std::size_t) override
+        {
+            auto scope{ Scope::IGNORED };
+            if (IsCurrent(Scope::ROOT) && m_frames.back().key == "islands")
+            {
+                scope = Scope::ISLANDS;
+            }
+            else if (IsCurrent(Scope::ISLAND) && m_frames.back().key == "layers")
+            {
+                scope = Scope::LAYERS;
+            }
+            else if (IsCurrent(Scope::LAYER))
+            {
+                m_currentTiles = GetTilesByLayerName(m_frames.back().key);
+                if (m_currentTiles)
+                {
+                    scope = Scope::TILES;
+                }
+            }
+
+            m_frames.push_back({ scope, {} });
+
+            return true;
+        }
+
+        bool end_array() override
+        {
+            m_frames.pop_back();
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& t_ex) override
+        {
+            throw MDCII_EXCEPTION("[JsonMapSaxHandler::parse_error()] " + std::string(t_ex.what()));
+        }
+
+    protected:
+
+    private:
+        /**
+         * The meaning of an object or array.
+         */
+        enum class Scope
+        {
+            ROOT,     // the map object
+            WORLD,    // the world object with the world size
+            ISLANDS,  // the array of islands
+            ISLAND,   // an island object
+            LAYERS,   // the array of layers of an island
+            LAYER,    // an object with the layer name as key
+            TILES,    // the array of tiles of a layer
+            TILE,     // a tile object
+            IGNORED   // everything else, e.g. the old "connected" arrays
+        };
+
+        /**
+         * An open object or array with the last read key.
+         */
+        struct Frame
+        {
+            Scope scope;
+            std::string key;
+        };
+
+        mdcii::file::JsonMapReader& m_reader;
+        const mdcii::file::JsonMapReader::Island_Callback& m_islandCallback;
+        std::vector<Frame> m_frames;
+        mdcii::file::JsonMapIsland m_island;
+        std::vector<std::shared_ptr<mdcii::layer::Tile>>* m_currentTiles{ nullptr };
+
+        [[nodiscard]] bool IsCurrent(const Scope t_scope) const
+        {
+            return !m_frames.empty() && m_frames.back().scope == t_scope;
+        }
+
+        std::vector<std::shared_ptr<mdcii::layer::Tile>>* GetTilesByLayerName(const std::string& t_layerName)
+        {
+            if (t_layerName == "coast")
+            {
+                return &m_island.coastTiles;
+            }
+
+            if (t_layerName == "terrain")
+            {
+                return &m_island.terrainTiles;
+            }
+
+            if (t_layerName == "buildings")
+            {
+                return &m_island.buildingsTiles;
+            }
+
+            return nullptr;
+        }
+
+        void Number(const int32_t t_val)
+        {
+            if (m_frames.empty())
+            {
+                return;
+            }
+
+            const auto& [scope, key]{ m_frames.back() };
+
+            if (scope == Scope::WORLD)
+            {
+                if (key == "width")
+                {
+                    m_reader.worldWidth = t_val;
+                }
+                else if (key == "height")
+                {
+                    m_reader.worldHeight = t_val;
+                }
+            }
+            else if (scope == Scope::ISLAND)
+            {
+                if (key == "width")
+                {
+                    m_island.width = t_val;
+                }
+                else if (key == "height")
+                {
+                    m_island.height = t_val;
+                }
+                else if (key == "x")
+                {
+                    m_island.x = t_val;
+                }
+                else if (key == "y")
+                {
+                    m_island.y = t_val;
+                }
+            }
+            else if (scope == Scope::TILE)
+            {
+                auto& tile{ *m_currentTiles->back() };
+                if (key == "id")
+                {
+                    tile.buildingId = t_val;
+                }
+                else if (key == "rotation")
+                {
+                    tile.rotation = mdcii::world::int_to_rotation(t_val);
+                }
+                else if (key == "x")
+                {
+                    tile.x = t_val;
+                }
+                else if (key == "y")
+                {
+                    tile.y = t_val;
+                }
+            }
+        }
+    };
+}
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+mdcii::file::JsonMapReader::JsonMapReader(std::string t_filePath)
+    : m_filePath{ std::move(t_filePath) }
+{
+    Log::MDCII_LOG_DEBUG("[JsonMapReader::JsonMapReader()] Create JsonMapReader.");
+}
+
+mdcii::file::JsonMapReader::~JsonMapReader() noexcept
+{
+    Log::MDCII_LOG_DEBUG("[JsonMapReader::~JsonMapReader()] Destruct JsonMapReader.");
+}
+
+//-------------------------------------------------
+// Read
+//-------------------------------------------------
+
+void mdcii::file::JsonMapReader::Read(const Island_Callback& t_islandCallback)
+{
+    Log::MDCII_LOG_DEBUG("[JsonMapReader::Read()] Start reading Json map {}...", m_filePath);
+
+    std::ifstream file{ m_filePath };
+    if (!file.is_open())
+    {
+        throw MDCII_EXCEPTION("[JsonMapReader::Read()] Error while opening file " + m_filePath + ".");
+    }
+
+    JsonMapSaxHandler handler{ *this, t_islandCallback };
+    nlohmann::json::sax_parse(file, &handler);
+
+    Log::MDCII_LOG_DEBUG("[JsonMapReader::Read()] The Json map was read successfully.");
+}
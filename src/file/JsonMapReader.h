@@ -0,0 +1,158 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+//-------------------------------------------------
+// Forward declarations
+//-------------------------------------------------
+
+namespace mdcii::layer
+{
+    /**
+     * Forward declaration struct Tile.
+     */
+    struct Tile;
+}
+
+//-------------------------------------------------
+// JsonMapReader
+//-------------------------------------------------
+
+namespace mdcii::file
+{
+    //-------------------------------------------------
+    // Types
+    //-------------------------------------------------
+
+    /**
+     * An island read from a Json map.
+     */
+    struct JsonMapIsland
+    {
+        int32_t width{ -1 };
+        int32_t height{ -1 };
+        int32_t x{ -1 };
+        int32_t y{ -1 };
+
+        /**
+         * The Tile objects of the coast layer in Deg0 order.
+         */
+        std::vector<std::shared_ptr<layer::Tile>> coastTiles;
+
+        /**
+         * The Tile objects of the terrain layer in Deg0 order.
+         */
+        std::vector<std::shared_ptr<layer::Tile>> terrainTiles;
+
+        /**
+         * The Tile objects of the buildings layer in Deg0 order.
+         */
+        std::vector<std::shared_ptr<layer::Tile>> buildingsTiles;
+    };
+
+    //-------------------------------------------------
+    // JsonMapReader
+    //-------------------------------------------------
+
+    /**
+     * Reads a Json map with a SAX parser.
+     * The Tile objects are created while the file is parsed, so that no Json value of the whole map is created.
+     */
+    class JsonMapReader
+    {
+    public:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        /**
+         * Called for each completely read island.
+         */
+        using Island_Callback = std::function<void(JsonMapIsland&)>;
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The version of the map.
+         */
+        std::string version;
+
+        /**
+         * The width of the world.
+         */
+        int32_t worldWidth{ -1 };
+
+        /**
+         * The height of the world.
+         */
+        int32_t worldHeight{ -1 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        JsonMapReader() = delete;
+
+        /**
+         * Constructs a new JsonMapReader object.
+         *
+         * @param t_filePath The path to the Json map.
+         */
+        explicit JsonMapReader(std::string t_filePath);
+
+        JsonMapReader(const JsonMapReader& t_other) = delete;
+        JsonMapReader(JsonMapReader&& t_other) noexcept = delete;
+        JsonMapReader& operator=(const JsonMapReader& t_other) = delete;
+        JsonMapReader& operator=(JsonMapReader&& t_other) noexcept = delete;
+
+        ~JsonMapReader() noexcept;
+
+        //-------------------------------------------------
+        // Read
+        //-------------------------------------------------
+
+        /**
+         * Parses the file.
+         * The world size can follow the islands in the file.
+         * Throws as soon as a version other than Game::VERSION is read.
+         *
+         * @param t_islandCallback Called for each island as soon as it has been read.
+         */
+        void Read(const Island_Callback& t_islandCallback);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The path to the Json map.
+         */
+        std::string m_filePath;
+    };
+}
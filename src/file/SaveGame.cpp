@@ -0,0 +1,410 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include <chrono>
+#include <limits>
+#include <random>
+#include <filesystem>
+#include "SaveGame.h"
+#include "MdciiAssert.h"
+#include "JsonMapReader.h"
+#include "world/World.h"
+#include "world/Terrain.h"
+#include "world/Island.h"
+#include "layer/TerrainLayer.h"
+
+//-------------------------------------------------
+// Convert
+//-------------------------------------------------
+
+mdcii::file::SaveGameTile mdcii::file::to_save_game_tile(const layer::Tile& t_tile)
+{
+    if (t_tile.buildingId > std::numeric_limits<int16_t>::max())
+    {
+        throw MDCII_EXCEPTION("[to_save_game_tile()] Invalid building Id " + std::to_string(t_tile.buildingId) + ".");
+    }
+
+    // the tile position is stored relative to the island
+    if (t_tile.x < std::numeric_limits<int8_t>::min() || t_tile.x > std::numeric_limits<int8_t>::max() ||
+        t_tile.y < std::numeric_limits<int8_t>::min() || t_tile.y > std::numeric_limits<int8_t>::max())
+    {
+        throw MDCII_EXCEPTION("[to_save_game_tile()] Invalid tile position " + std::to_string(t_tile.x) + ", " + std::to_string(t_tile.y) + ".");
+    }
+
+    SaveGameTile saveGameTile;
+    saveGameTile.buildingId = static_cast<int16_t>(t_tile.buildingId);
+    saveGameTile.rotation = static_cast<uint8_t>(magic_enum::enum_integer(t_tile.rotation));
+    saveGameTile.x = static_cast<int8_t>(t_tile.x);
+    saveGameTile.y = static_cast<int8_t>(t_tile.y);
+
+    return saveGameTile;
+}
+
+//-------------------------------------------------
+// SaveGameWriter
+//-------------------------------------------------
+
+mdcii::file::SaveGameWriter::SaveGameWriter(std::string t_filePath, const bool t_rle)
+    : m_filePath{ std::move(t_filePath) }
+    , m_rle{ t_rle }
+{
+    Log::MDCII_LOG_DEBUG("[SaveGameWriter::SaveGameWriter()] Create SaveGameWriter.");
+
+    m_file.open(m_filePath, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        throw MDCII_EXCEPTION("[SaveGameWriter::SaveGameWriter()] Error while opening file " + m_filePath + ".");
+    }
+}
+
+mdcii::file::SaveGameWriter::~SaveGameWriter() noexcept
+{
+    Log::MDCII_LOG_DEBUG("[SaveGameWriter::~SaveGameWriter()] Destruct SaveGameWriter.");
+}
+
+void mdcii::file::SaveGameWriter::WriteHeader(const uint64_t t_checkpointId, const int32_t t_worldWidth, const int32_t t_worldHeight, const uint32_t t_nrOfIslands)
+{
+    WriteValue(SAVE_GAME_MAGIC);
+    WriteValue(SAVE_GAME_FORMAT_VERSION);
+    WriteValue(t_checkpointId);
+    WriteValue(t_worldWidth);
+    WriteValue(t_worldHeight);
+    WriteValue(t_nrOfIslands);
+}
+
+void mdcii::file::SaveGameWriter::WriteIsland(const SaveGameIsland& t_island)
+{
+    WriteValue(t_island.width);
+    WriteValue(t_island.height);
+    WriteValue(t_island.x);
+    WriteValue(t_island.y);
+}
+
+void mdcii::file::SaveGameWriter::WriteLayer(const layer::LayerType t_layerType, const std::vector<SaveGameTile>& t_tiles)
+{
+    WriteValue(static_cast<uint8_t>(magic_enum::enum_integer(t_layerType)));
+    WriteValue(static_cast<uint8_t>(m_rle ? SaveGameEncoding::RLE : SaveGameEncoding::RAW));
+    WriteValue(static_cast<uint32_t>(t_tiles.size()));
+
+    if (!m_rle)
+    {
+        for (const auto& tile : t_tiles)
+        {
+            WriteTile(tile);
+        }
+
+        return;
+    }
+
+    auto it{ t_tiles.begin() };
+    while (it != t_tiles.end())
+    {
+        const auto& saveGameTile{ *it };
+
+        uint32_t count{ 1 };
+        while (++it != t_tiles.end() && *it == saveGameTile)
+        {
+            ++count;
+        }
+
+        WriteValue(count);
+        WriteTile(saveGameTile);
+    }
+}
+
+void mdcii::file::SaveGameWriter::Close()
+{
+    m_file.close();
+    if (m_file.fail())
+    {
+        throw MDCII_EXCEPTION("[SaveGameWriter::Close()] Error while writing file " + m_filePath + ".");
+    }
+}
+
+mdcii::file::SaveGameSnapshot mdcii::file::SaveGameWriter::CreateSnapshot(const world::World& t_world)
+{
+    SaveGameSnapshot snapshot;
+    snapshot.worldWidth = t_world.width;
+    snapshot.worldHeight = t_world.height;
+    snapshot.islands.reserve(t_world.terrain->islands.size());
+
+    for (const auto& island : t_world.terrain->islands)
+    {
+        MDCII_ASSERT(island->buildingsLayer->saveGameTiles, "[SaveGameWriter::CreateSnapshot()] Null pointer.")
+
+        snapshot.islands.push_back({
+            { island->width, island->height, island->startWorldX, island->startWorldY },
+            { island->coastLayer->saveGameTiles, island->terrainLayer->saveGameTiles, island->buildingsLayer->saveGameTiles }
+        });
+    }
+
+    return snapshot;
+}
+
+uint64_t mdcii::file::SaveGameWriter::CreateCheckpointId()
+{
+    // the time is mixed in, in case the random device is deterministic
+    std::random_device randomDevice;
+    const auto random{ static_cast<uint64_t>(randomDevice()) << 32 | randomDevice() };
+    const auto time{ static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count()) };
+
+    const auto checkpointId{ random ^ time };
+
+    return checkpointId == NO_CHECKPOINT_ID ? NO_CHECKPOINT_ID + 1 : checkpointId;
+}
+
+void mdcii::file::SaveGameWriter::WriteSnapshot(const std::string& t_filePath, const SaveGameSnapshot& t_snapshot, const bool t_rle)
+{
+    Log::MDCII_LOG_DEBUG("[SaveGameWriter::WriteSnapshot()] Start saving the world in file {}...", t_filePath);
+
+    WriteAndReplace(t_filePath, t_rle, [&t_snapshot](SaveGameWriter& t_writer) {
+        t_writer.WriteHeader(t_snapshot.checkpointId, t_snapshot.worldWidth, t_snapshot.worldHeight, static_cast<uint32_t>(t_snapshot.islands.size()));
+
+        for (const auto& [island, layers] : t_snapshot.islands)
+        {
+            t_writer.WriteIsland(island);
+            t_writer.WriteLayer(layer::LayerType::COAST, *layers[0]);
+            t_writer.WriteLayer(layer::LayerType::TERRAIN, *layers[1]);
+            t_writer.WriteLayer(layer::LayerType::BUILDINGS, *layers[2]);
+        }
+    });
+
+    Log::MDCII_LOG_DEBUG("[SaveGameWriter::WriteSnapshot()] The world has been successfully saved.");
+}
+
+void mdcii::file::SaveGameWriter::SaveWorld(const std::string& t_filePath, const world::World& t_world, const bool t_rle)
+{
+    WriteSnapshot(t_filePath, CreateSnapshot(t_world), t_rle);
+}
+
+void mdcii::file::SaveGameWriter::ConvertJsonMap(const std::string& t_jsonFilePath, const std::string& t_filePath, const bool t_rle)
+{
+    Log::MDCII_LOG_DEBUG("[SaveGameWriter::ConvertJsonMap()] Convert Json map {} into savegame {}.", t_jsonFilePath, t_filePath);
+
+    WriteAndReplace(t_filePath, t_rle, [&t_jsonFilePath](SaveGameWriter& t_writer) {
+        // the world size follows the islands in a Json map, so the header is written again at the end
+        t_writer.WriteHeader(NO_CHECKPOINT_ID, 0, 0, 0);
+
+        uint32_t nrOfIslands{ 0 };
+        JsonMapReader reader{ t_jsonFilePath };
+        reader.Read([&t_writer, &nrOfIslands](JsonMapIsland& t_jsonMapIsland) {
+            if (t_jsonMapIsland.coastTiles.empty() || t_jsonMapIsland.terrainTiles.empty() || t_jsonMapIsland.buildingsTiles.empty())
+            {
+                throw MDCII_EXCEPTION("[SaveGameWriter::ConvertJsonMap()] Missing layer.");
+            }
+
+            t_writer.WriteIsland({ t_jsonMapIsland.width, t_jsonMapIsland.height, t_jsonMapIsland.x, t_jsonMapIsland.y });
+            for (const auto& [layerType, tiles] : {
+                     std::pair{ layer::LayerType::COAST, &t_jsonMapIsland.coastTiles },
+                     std::pair{ layer::LayerType::TERRAIN, &t_jsonMapIsland.terrainTiles },
+                     std::pair{ layer::LayerType::BUILDINGS, &t_jsonMapIsland.buildingsTiles }
+                 })
+            {
+                std::vector<SaveGameTile> saveGameTiles;
+                saveGameTiles.reserve(tiles->size());
+                for (const auto& tile : *tiles)
+                {
+                    saveGameTiles.push_back(to_save_game_tile(*tile));
+                }
+
+                t_writer.WriteLayer(layerType, saveGameTiles);
+            }
+
+            ++nrOfIslands;
+        });
+
+        t_writer.m_file.seekp(0);
+        t_writer.WriteHeader(NO_CHECKPOINT_ID, reader.worldWidth, reader.worldHeight, nrOfIslands);
+    });
+
+    Log::MDCII_LOG_DEBUG("[SaveGameWriter::ConvertJsonMap()] The Json map has been successfully converted.");
+}
+
+void mdcii::file::SaveGameWriter::WriteTile(const SaveGameTile& t_tile)
+{
+    WriteValue(t_tile.buildingId);
+    WriteValue(t_tile.rotation);
+    WriteValue(t_tile.x);
+    WriteValue(t_tile.y);
+}
+
+void mdcii::file::SaveGameWriter::WriteAndReplace(const std::string& t_filePath, const bool t_rle, const std::function<void(SaveGameWriter&)>& t_write)
+{
+    // an interrupted save never destroys the previous savegame
+    const auto tmpFilePath{ t_filePath + ".tmp" };
+
+    try
+    {
+        {
+            SaveGameWriter writer{ tmpFilePath, t_rle };
+            t_write(writer);
+            writer.Close();
+        }
+
+        std::error_code errorCode;
+        std::filesystem::rename(tmpFilePath, t_filePath, errorCode);
+        if (errorCode)
+        {
+            throw MDCII_EXCEPTION("[SaveGameWriter::WriteAndReplace()] Error while replacing file " + t_filePath + ": " + errorCode.message());
+        }
+    }
+    catch (...)
+    {
+        // the writer is closed at this point, so the incomplete file can be removed
+        std::error_code errorCode;
+        std::filesystem::remove(tmpFilePath, errorCode);
+
+        throw;
+    }
+}
+
+//-------------------------------------------------
+// SaveGameReader
+//-------------------------------------------------
+
+mdcii::file::SaveGameReader::SaveGameReader(std::string t_filePath)
+    : m_filePath{ std::move(t_filePath) }
+{
+    Log::MDCII_LOG_DEBUG("[SaveGameReader::SaveGameReader()] Create SaveGameReader.");
+
+    m_file.open(m_filePath, std::ios::binary);
+    if (!m_file.is_open())
+    {
+        throw MDCII_EXCEPTION("[SaveGameReader::SaveGameReader()] Error while opening file " + m_filePath + ".");
+    }
+
+    ReadHeader();
+}
+
+mdcii::file::SaveGameReader::~SaveGameReader() noexcept
+{
+    Log::MDCII_LOG_DEBUG("[SaveGameReader::~SaveGameReader()] Destruct SaveGameReader.");
+}
+
+mdcii::file::SaveGameIsland mdcii::file::SaveGameReader::ReadIsland()
+{
+    SaveGameIsland island;
+    island.width = ReadValue<int32_t>();
+    island.height = ReadValue<int32_t>();
+    island.x = ReadValue<int32_t>();
+    island.y = ReadValue<int32_t>();
+
+    return island;
+}
+
+void mdcii::file::SaveGameReader::ReadLayer(layer::TerrainLayer& t_terrainLayer)
+{
+    const auto saveGameTiles{ ReadTiles(t_terrainLayer.layerType, static_cast<uint32_t>(t_terrainLayer.instancesToRender)) };
+
+    t_terrainLayer.tiles.reserve(saveGameTiles.size());
+    for (const auto& saveGameTile : saveGameTiles)
+    {
+        auto tile{ std::make_unique<layer::Tile>() };
+        tile->buildingId = saveGameTile.buildingId;
+        tile->rotation = world::int_to_rotation(saveGameTile.rotation);
+        tile->x = saveGameTile.x;
+        tile->y = saveGameTile.y;
+        tile->layerType = t_terrainLayer.layerType;
+
+        t_terrainLayer.tiles.emplace_back(std::move(tile));
+    }
+}
+
+std::vector<mdcii::file::SaveGameTile> mdcii::file::SaveGameReader::ReadTiles(const layer::LayerType t_layerType, const uint32_t t_nrOfTiles)
+{
+    if (ReadValue<uint8_t>() != magic_enum::enum_integer(t_layerType))
+    {
+        throw MDCII_EXCEPTION("[SaveGameReader::ReadTiles()] Unexpected layer type in file " + m_filePath + ".");
+    }
+
+    const auto encoding{ magic_enum::enum_cast<SaveGameEncoding>(ReadValue<uint8_t>()) };
+    if (!encoding.has_value())
+    {
+        throw MDCII_EXCEPTION("[SaveGameReader::ReadTiles()] Invalid encoding in file " + m_filePath + ".");
+    }
+
+    const auto nrOfTiles{ ReadValue<uint32_t>() };
+    if (nrOfTiles != t_nrOfTiles)
+    {
+        throw MDCII_EXCEPTION("[SaveGameReader::ReadTiles()] Invalid number of tiles in file " + m_filePath + ".");
+    }
+
+    std::vector<SaveGameTile> saveGameTiles;
+    saveGameTiles.reserve(nrOfTiles);
+
+    auto remaining{ nrOfTiles };
+    while (remaining > 0)
+    {
+        auto count{ 1u };
+        if (encoding.value() == SaveGameEncoding::RLE)
+        {
+            count = ReadValue<uint32_t>();
+            if (count == 0 || count > remaining)
+            {
+                throw MDCII_EXCEPTION("[SaveGameReader::ReadTiles()] Invalid run length in file " + m_filePath + ".");
+            }
+        }
+
+        saveGameTiles.insert(saveGameTiles.end(), count, ReadTile());
+        remaining -= count;
+    }
+
+    return saveGameTiles;
+}
+
+bool mdcii::file::SaveGameReader::IsSaveGameFile(const std::string& t_filePath)
+{
+    std::ifstream file{ t_filePath, std::ios::binary };
+
+    uint32_t magic{ 0 };
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+
+    return file && magic == SAVE_GAME_MAGIC;
+}
+
+mdcii::file::SaveGameTile mdcii::file::SaveGameReader::ReadTile()
+{
+    SaveGameTile tile;
+    tile.buildingId = ReadValue<int16_t>();
+    tile.rotation = ReadValue<uint8_t>();
+    tile.x = ReadValue<int8_t>();
+    tile.y = ReadValue<int8_t>();
+
+    return tile;
+}
+
+void mdcii::file::SaveGameReader::ReadHeader()
+{
+    if (ReadValue<uint32_t>() != SAVE_GAME_MAGIC)
+    {
+        throw MDCII_EXCEPTION("[SaveGameReader::ReadHeader()] The file " + m_filePath + " is not a savegame.");
+    }
+
+    if (const auto version{ ReadValue<uint16_t>() }; version != SAVE_GAME_FORMAT_VERSION)
+    {
+        throw MDCII_EXCEPTION("[SaveGameReader::ReadHeader()] Unsupported savegame format version " + std::to_string(version) + ".");
+    }
+
+    checkpointId = ReadValue<uint64_t>();
+
+    worldWidth = ReadValue<int32_t>();
+    worldHeight = ReadValue<int32_t>();
+    nrOfIslands = ReadValue<uint32_t>();
+
+    Log::MDCII_LOG_DEBUG("[SaveGameReader::ReadHeader()] Checkpoint: {}, world size: {}x{}, islands: {}.", checkpointId, worldWidth, worldHeight, nrOfIslands);
+}
@@ -0,0 +1,486 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <array>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MdciiException.h"
+
+//-------------------------------------------------
+// Forward declarations
+//-------------------------------------------------
+
+namespace mdcii::layer
+{
+    /**
+     * Forward declaration struct Tile.
+     */
+    struct Tile;
+
+    /**
+     * Forward declaration class TerrainLayer.
+     */
+    class TerrainLayer;
+
+    /**
+     * Forward declaration enum class LayerType.
+     */
+    enum class LayerType;
+}
+
+namespace mdcii::world
+{
+    /**
+     * Forward declaration class World.
+     */
+    class World;
+}
+
+//-------------------------------------------------
+// SaveGame
+//-------------------------------------------------
+
+namespace mdcii::file
+{
+    //-------------------------------------------------
+    // Constants
+    //-------------------------------------------------
+
+    /**
+     * The first four bytes of each savegame ("MDC2").
+     */
+    static constexpr uint32_t SAVE_GAME_MAGIC{ 0x3243444D };
+
+    /**
+     * The version of the binary format. Must be increased on every change of the layout.
+     */
+    static constexpr uint16_t SAVE_GAME_FORMAT_VERSION{ 2 };
+
+    /**
+     * The checkpoint Id of a savegame without a journal, e.g. a generated world.
+     * The AutoSave never continues such a savegame with a journal.
+     */
+    static constexpr uint64_t NO_CHECKPOINT_ID{ 0 };
+
+    //-------------------------------------------------
+    // Types
+    //-------------------------------------------------
+
+    /**
+     * How the tiles of a layer are stored.
+     */
+    enum class SaveGameEncoding : uint8_t
+    {
+        RAW, // each tile is stored
+        RLE  // runs of equal tiles are stored as (count, tile)
+    };
+
+    /**
+     * The island values stored in a savegame.
+     */
+    struct SaveGameIsland
+    {
+        int32_t width{ -1 };
+        int32_t height{ -1 };
+        int32_t x{ -1 };
+        int32_t y{ -1 };
+    };
+
+    /**
+     * The Tile values stored in a savegame.
+     * All other Tile values are calculated when the layer is prepared.
+     */
+    struct SaveGameTile
+    {
+        int16_t buildingId{ -1 };
+        uint8_t rotation{ 0 };
+        int8_t x{ 0 };
+        int8_t y{ 0 };
+
+        bool operator==(const SaveGameTile& t_other) const
+        {
+            return buildingId == t_other.buildingId && rotation == t_other.rotation && x == t_other.x && y == t_other.y;
+        }
+
+        bool operator!=(const SaveGameTile& t_other) const
+        {
+            return !(*this == t_other);
+        }
+    };
+
+    /**
+     * An island with the tiles of its coast, terrain and buildings layer.
+     * The tiles are shared with the layers and must not be changed.
+     */
+    struct SaveGameIslandSnapshot
+    {
+        SaveGameIsland island;
+        std::array<std::shared_ptr<const std::vector<SaveGameTile>>, 3> layers;
+    };
+
+    /**
+     * All the data of a savegame. Can be written on any thread.
+     */
+    struct SaveGameSnapshot
+    {
+        uint64_t checkpointId{ 0 };
+        int32_t worldWidth{ -1 };
+        int32_t worldHeight{ -1 };
+        std::vector<SaveGameIslandSnapshot> islands;
+    };
+
+    //-------------------------------------------------
+    // Convert
+    //-------------------------------------------------
+
+    /**
+     * Creates the savegame values of a Tile object.
+     *
+     * @param t_tile The Tile object.
+     *
+     * @return The SaveGameTile object.
+     */
+    [[nodiscard]] SaveGameTile to_save_game_tile(const layer::Tile& t_tile);
+
+    //-------------------------------------------------
+    // SaveGameWriter
+    //-------------------------------------------------
+
+    /**
+     * Writes a versioned binary savegame.
+     *
+     * Layout: header (magic, format version, checkpoint Id, world width, world height, number of islands),
+     * then for each island its values followed by the coast, terrain and buildings layer.
+     * Each layer starts with its LayerType, the SaveGameEncoding and the number of tiles.
+     */
+    class SaveGameWriter
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        SaveGameWriter() = delete;
+
+        /**
+         * Constructs a new SaveGameWriter object and opens the file.
+         *
+         * @param t_filePath The path to the savegame.
+         * @param t_rle True if the layers should be run-length encoded.
+         */
+        SaveGameWriter(std::string t_filePath, bool t_rle);
+
+        SaveGameWriter(const SaveGameWriter& t_other) = delete;
+        SaveGameWriter(SaveGameWriter&& t_other) noexcept = delete;
+        SaveGameWriter& operator=(const SaveGameWriter& t_other) = delete;
+        SaveGameWriter& operator=(SaveGameWriter&& t_other) noexcept = delete;
+
+        ~SaveGameWriter() noexcept;
+
+        //-------------------------------------------------
+        // Write
+        //-------------------------------------------------
+
+        /**
+         * Writes the savegame header.
+         *
+         * @param t_checkpointId Identifies the savegame for its change journal.
+         * @param t_worldWidth The width of the world.
+         * @param t_worldHeight The height of the world.
+         * @param t_nrOfIslands The number of islands that follow.
+         */
+        void WriteHeader(uint64_t t_checkpointId, int32_t t_worldWidth, int32_t t_worldHeight, uint32_t t_nrOfIslands);
+
+        /**
+         * Writes the values of an island. The three layers of the island must follow.
+         *
+         * @param t_island The island values.
+         */
+        void WriteIsland(const SaveGameIsland& t_island);
+
+        /**
+         * Writes the tiles of a layer.
+         *
+         * @param t_layerType The type of the layer.
+         * @param t_tiles The tiles in Deg0 order.
+         */
+        void WriteLayer(layer::LayerType t_layerType, const std::vector<SaveGameTile>& t_tiles);
+
+        /**
+         * Flushes and closes the file.
+         */
+        void Close();
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Takes a snapshot of the world. Only shared pointers to the layer tiles are copied.
+         *
+         * @param t_world The World object.
+         *
+         * @return The SaveGameSnapshot object.
+         */
+        [[nodiscard]] static SaveGameSnapshot CreateSnapshot(const world::World& t_world);
+
+        /**
+         * Creates a random checkpoint Id. Unlike a counter, the Ids of different
+         * sessions writing the same savegame don't repeat.
+         *
+         * @return The new checkpoint Id.
+         */
+        [[nodiscard]] static uint64_t CreateCheckpointId();
+
+        /**
+         * Writes a snapshot into a temporary file, which then replaces the savegame.
+         *
+         * @param t_filePath The path to the savegame.
+         * @param t_snapshot The SaveGameSnapshot object.
+         * @param t_rle True if the layers should be run-length encoded.
+         */
+        static void WriteSnapshot(const std::string& t_filePath, const SaveGameSnapshot& t_snapshot, bool t_rle);
+
+        /**
+         * Writes a whole world into a savegame.
+         *
+         * @param t_filePath The path to the savegame.
+         * @param t_world The World object to save.
+         * @param t_rle True if the layers should be run-length encoded.
+         */
+        static void SaveWorld(const std::string& t_filePath, const world::World& t_world, bool t_rle);
+
+        /**
+         * Converts a Json map into a savegame.
+         *
+         * @param t_jsonFilePath The path to the Json map.
+         * @param t_filePath The path to the savegame.
+         * @param t_rle True if the layers should be run-length encoded.
+         */
+        static void ConvertJsonMap(const std::string& t_jsonFilePath, const std::string& t_filePath, bool t_rle);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The path to the savegame.
+         */
+        std::string m_filePath;
+
+        /**
+         * The output file stream.
+         */
+        std::ofstream m_file;
+
+        /**
+         * True if the layers are run-length encoded.
+         */
+        bool m_rle{ true };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Writes a value in the native byte order.
+         *
+         * @tparam T The type of the value.
+         * @param t_value The value to write.
+         */
+        template<typename T>
+        void WriteValue(const T t_value)
+        {
+            m_file.write(reinterpret_cast<const char*>(&t_value), sizeof(T));
+        }
+
+        /**
+         * Writes a tile record.
+         *
+         * @param t_tile The tile record to write.
+         */
+        void WriteTile(const SaveGameTile& t_tile);
+
+        /**
+         * Writes into a temporary file, which then replaces the savegame.
+         * The temporary file is removed if anything fails.
+         *
+         * @param t_filePath The path to the savegame.
+         * @param t_rle True if the layers should be run-length encoded.
+         * @param t_write Writes the content with the given SaveGameWriter object.
+         */
+        static void WriteAndReplace(const std::string& t_filePath, bool t_rle, const std::function<void(SaveGameWriter&)>& t_write);
+    };
+
+    //-------------------------------------------------
+    // SaveGameReader
+    //-------------------------------------------------
+
+    /**
+     * Reads a binary savegame step by step, so that the tiles
+     * can be stored directly in the layers without a temporary copy of the file.
+     */
+    class SaveGameReader
+    {
+    public:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The width of the world.
+         */
+        int32_t worldWidth{ -1 };
+
+        /**
+         * The height of the world.
+         */
+        int32_t worldHeight{ -1 };
+
+        /**
+         * The number of islands.
+         */
+        uint32_t nrOfIslands{ 0 };
+
+        /**
+         * Identifies the savegame for its change journal.
+         */
+        uint64_t checkpointId{ 0 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        SaveGameReader() = delete;
+
+        /**
+         * Constructs a new SaveGameReader object, opens the file and reads the header.
+         *
+         * @param t_filePath The path to the savegame.
+         */
+        explicit SaveGameReader(std::string t_filePath);
+
+        SaveGameReader(const SaveGameReader& t_other) = delete;
+        SaveGameReader(SaveGameReader&& t_other) noexcept = delete;
+        SaveGameReader& operator=(const SaveGameReader& t_other) = delete;
+        SaveGameReader& operator=(SaveGameReader&& t_other) noexcept = delete;
+
+        ~SaveGameReader() noexcept;
+
+        //-------------------------------------------------
+        // Read
+        //-------------------------------------------------
+
+        /**
+         * Reads the values of the next island.
+         *
+         * @return The island values.
+         */
+        [[nodiscard]] SaveGameIsland ReadIsland();
+
+        /**
+         * Reads the next layer and adds the Tile objects to the given layer.
+         *
+         * @param t_terrainLayer The TerrainLayer object. The LayerType must match the stored type.
+         */
+        void ReadLayer(layer::TerrainLayer& t_terrainLayer);
+
+        /**
+         * Reads and decodes the tile records of the next layer.
+         *
+         * @param t_layerType The expected LayerType.
+         * @param t_nrOfTiles The expected number of tiles.
+         *
+         * @return The tile records.
+         */
+        [[nodiscard]] std::vector<SaveGameTile> ReadTiles(layer::LayerType t_layerType, uint32_t t_nrOfTiles);
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Checks whether a file starts with the savegame magic number.
+         *
+         * @param t_filePath The path to the file.
+         *
+         * @return True or false.
+         */
+        [[nodiscard]] static bool IsSaveGameFile(const std::string& t_filePath);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The path to the savegame.
+         */
+        std::string m_filePath;
+
+        /**
+         * The input file stream.
+         */
+        std::ifstream m_file;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Reads a value in the native byte order.
+         *
+         * @tparam T The type of the value.
+         *
+         * @return The value.
+         */
+        template<typename T>
+        T ReadValue()
+        {
+            T value{};
+            if (!m_file.read(reinterpret_cast<char*>(&value), sizeof(T)))
+            {
+                throw MDCII_EXCEPTION("[SaveGameReader::ReadValue()] Unexpected end of file " + m_filePath + ".");
+            }
+
+            return value;
+        }
+
+        /**
+         * Reads a tile record.
+         *
+         * @return The tile record.
+         */
+        [[nodiscard]] SaveGameTile ReadTile();
+
+        /**
+         * Reads the header of the file.
+         */
+        void ReadHeader();
+    };
+}
@@ -0,0 +1,254 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#include <algorithm>
+#include <filesystem>
+#include "SaveGameJournal.h"
+#include "Log.h"
+#include "world/Terrain.h"
+#include "world/Island.h"
+#include "layer/TerrainLayer.h"
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+namespace
+{
+    template<typename T>
+    void write_value(std::ofstream& t_file, const T t_value)
+    {
+        t_file.write(reinterpret_cast<const char*>(&t_value), sizeof(T));
+    }
+
+    template<typename T>
+    bool read_value(std::ifstream& t_file, T& t_value)
+    {
+        return static_cast<bool>(t_file.read(reinterpret_cast<char*>(&t_value), sizeof(T)));
+    }
+
+    mdcii::layer::TerrainLayer& get_layer(const mdcii::world::Island& t_island, const mdcii::layer::LayerType t_layerType)
+    {
+        switch (t_layerType)
+        {
+        case mdcii::layer::LayerType::COAST:
+            return *t_island.coastLayer;
+        case mdcii::layer::LayerType::TERRAIN:
+            return *t_island.terrainLayer;
+        case mdcii::layer::LayerType::BUILDINGS:
+            return *t_island.buildingsLayer;
+        default:
+            throw MDCII_EXCEPTION("[get_layer()] Invalid layer type.");
+        }
+    }
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+std::string mdcii::file::SaveGameJournal::GetFilePath(const std::string& t_saveGameFilePath)
+{
+    return t_saveGameFilePath + ".journal";
+}
+
+//-------------------------------------------------
+// Changes
+//-------------------------------------------------
+
+std::vector<mdcii::file::SaveGameJournalEntry> mdcii::file::SaveGameJournal::TakeChanges(world::Terrain& t_terrain)
+{
+    std::vector<SaveGameJournalEntry> entries;
+
+    for (auto i{ 0u }; i < t_terrain.islands.size(); ++i)
+    {
+        for (const auto layerType : { layer::LayerType::COAST, layer::LayerType::TERRAIN, layer::LayerType::BUILDINGS })
+        {
+            auto& terrainLayer{ get_layer(*t_terrain.islands.at(i), layerType) };
+            auto& changes{ terrainLayer.changedSaveGameTiles };
+            if (changes.empty())
+            {
+                continue;
+            }
+
+            // a tile changed several times is stored only once
+            std::sort(changes.begin(), changes.end());
+            changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+
+            for (const auto index : changes)
+            {
+                entries.push_back({
+                    static_cast<uint16_t>(i),
+                    static_cast<uint8_t>(magic_enum::enum_integer(layerType)),
+                    static_cast<uint32_t>(index),
+                    terrainLayer.saveGameTiles->at(index)
+                });
+            }
+
+            changes.clear();
+        }
+    }
+
+    return entries;
+}
+
+//-------------------------------------------------
+// Read / Write
+//-------------------------------------------------
+
+void mdcii::file::SaveGameJournal::Append(const std::string& t_filePath, const uint64_t t_checkpointId, const std::vector<SaveGameJournalEntry>& t_entries)
+{
+    const auto exists{ std::filesystem::exists(t_filePath) };
+    if (exists)
+    {
+        std::ifstream file{ t_filePath, std::ios::binary };
+
+        uint32_t magic{ 0 };
+        uint16_t version{ 0 };
+        uint64_t checkpointId{ 0 };
+        if (!read_value(file, magic) || !read_value(file, version) || !read_value(file, checkpointId) ||
+            magic != SAVE_GAME_JOURNAL_MAGIC || version != SAVE_GAME_JOURNAL_FORMAT_VERSION || checkpointId != t_checkpointId)
+        {
+            throw MDCII_EXCEPTION("[SaveGameJournal::Append()] The journal " + t_filePath + " does not belong to the savegame.");
+        }
+    }
+
+    std::ofstream file{ t_filePath, std::ios::binary | std::ios::app };
+    if (!file.is_open())
+    {
+        throw MDCII_EXCEPTION("[SaveGameJournal::Append()] Error while opening file " + t_filePath + ".");
+    }
+
+    if (!exists)
+    {
+        write_value(file, SAVE_GAME_JOURNAL_MAGIC);
+        write_value(file, SAVE_GAME_JOURNAL_FORMAT_VERSION);
+        write_value(file, t_checkpointId);
+    }
+
+    write_value(file, static_cast<uint32_t>(t_entries.size()));
+    for (const auto& entry : t_entries)
+    {
+        write_value(file, entry.island);
+        write_value(file, entry.layerType);
+        write_value(file, entry.tileIndex);
+        write_value(file, entry.tile.buildingId);
+        write_value(file, entry.tile.rotation);
+        write_value(file, entry.tile.x);
+        write_value(file, entry.tile.y);
+    }
+
+    file.flush();
+    if (!file)
+    {
+        throw MDCII_EXCEPTION("[SaveGameJournal::Append()] Error while writing file " + t_filePath + ".");
+    }
+
+    Log::MDCII_LOG_DEBUG("[SaveGameJournal::Append()] {} changes appended to journal {}.", t_entries.size(), t_filePath);
+}
+
+std::vector<mdcii::file::SaveGameJournalEntry> mdcii::file::SaveGameJournal::Read(const std::string& t_filePath, const uint64_t t_checkpointId)
+{
+    std::vector<SaveGameJournalEntry> entries;
+
+    std::ifstream file{ t_filePath, std::ios::binary };
+    if (!file.is_open())
+    {
+        return entries;
+    }
+
+    uint32_t magic{ 0 };
+    uint16_t version{ 0 };
+    uint64_t checkpointId{ 0 };
+    if (!read_value(file, magic) || !read_value(file, version) || !read_value(file, checkpointId) ||
+        magic != SAVE_GAME_JOURNAL_MAGIC || version != SAVE_GAME_JOURNAL_FORMAT_VERSION)
+    {
+        throw MDCII_EXCEPTION("[SaveGameJournal::Read()] The file " + t_filePath + " is not a valid journal.");
+    }
+
+    if (checkpointId != t_checkpointId)
+    {
+        Log::MDCII_LOG_WARN("[SaveGameJournal::Read()] The journal {} belongs to another savegame and is ignored.", t_filePath);
+        return entries;
+    }
+
+    file.seekg(0, std::ios::end);
+    const auto fileSize{ static_cast<uint64_t>(file.tellg()) };
+    file.seekg(sizeof(magic) + sizeof(version) + sizeof(checkpointId));
+
+    uint32_t nrOfEntries{ 0 };
+    while (read_value(file, nrOfEntries))
+    {
+        // an interrupted save leaves an incomplete block, so the number of entries can't be trusted
+        if (nrOfEntries * SAVE_GAME_JOURNAL_ENTRY_SIZE > fileSize - static_cast<uint64_t>(file.tellg()))
+        {
+            Log::MDCII_LOG_WARN("[SaveGameJournal::Read()] Incomplete block in journal {} is ignored.", t_filePath);
+            return entries;
+        }
+
+        std::vector<SaveGameJournalEntry> block(nrOfEntries);
+        for (auto& entry : block)
+        {
+            if (!read_value(file, entry.island) || !read_value(file, entry.layerType) || !read_value(file, entry.tileIndex) ||
+                !read_value(file, entry.tile.buildingId) || !read_value(file, entry.tile.rotation) ||
+                !read_value(file, entry.tile.x) || !read_value(file, entry.tile.y))
+            {
+                // an interrupted save leaves an incomplete block
+                Log::MDCII_LOG_WARN("[SaveGameJournal::Read()] Incomplete block in journal {} is ignored.", t_filePath);
+                return entries;
+            }
+        }
+
+        entries.insert(entries.end(), block.begin(), block.end());
+    }
+
+    Log::MDCII_LOG_DEBUG("[SaveGameJournal::Read()] {} changes read from journal {}.", entries.size(), t_filePath);
+
+    return entries;
+}
+
+void mdcii::file::SaveGameJournal::Replay(const std::vector<SaveGameJournalEntry>& t_entries, world::Terrain& t_terrain)
+{
+    for (const auto& entry : t_entries)
+    {
+        const auto layerType{ magic_enum::enum_cast<layer::LayerType>(entry.layerType) };
+        if (entry.island >= t_terrain.islands.size() || !layerType.has_value())
+        {
+            throw MDCII_EXCEPTION("[SaveGameJournal::Replay()] Invalid journal entry.");
+        }
+
+        ReplayEntry(entry, get_layer(*t_terrain.islands.at(entry.island), layerType.value()).tiles);
+    }
+
+    Log::MDCII_LOG_DEBUG("[SaveGameJournal::Replay()] {} changes replayed.", t_entries.size());
+}
+
+void mdcii::file::SaveGameJournal::ReplayEntry(const SaveGameJournalEntry& t_entry, const std::vector<std::shared_ptr<layer::Tile>>& t_tiles)
+{
+    if (t_entry.tileIndex >= t_tiles.size())
+    {
+        throw MDCII_EXCEPTION("[SaveGameJournal::ReplayEntry()] Invalid tile index in journal entry.");
+    }
+
+    auto& tile{ *t_tiles.at(t_entry.tileIndex) };
+    tile.buildingId = t_entry.tile.buildingId;
+    tile.rotation = world::int_to_rotation(t_entry.tile.rotation);
+    tile.x = t_entry.tile.x;
+    tile.y = t_entry.tile.y;
+}
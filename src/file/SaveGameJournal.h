@@ -0,0 +1,181 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "SaveGame.h"
+
+//-------------------------------------------------
+// Forward declarations
+//-------------------------------------------------
+
+namespace mdcii::world
+{
+    /**
+     * Forward declaration class Terrain.
+     */
+    class Terrain;
+}
+
+namespace mdcii::layer
+{
+    /**
+     * Forward declaration struct Tile.
+     */
+    struct Tile;
+}
+
+//-------------------------------------------------
+// SaveGameJournal
+//-------------------------------------------------
+
+namespace mdcii::file
+{
+    //-------------------------------------------------
+    // Constants
+    //-------------------------------------------------
+
+    /**
+     * The first four bytes of each journal ("MDCJ").
+     */
+    static constexpr uint32_t SAVE_GAME_JOURNAL_MAGIC{ 0x4A43444D };
+
+    /**
+     * The version of the binary journal format.
+     */
+    static constexpr uint16_t SAVE_GAME_JOURNAL_FORMAT_VERSION{ 2 };
+
+    /**
+     * The size of an entry in the journal file.
+     */
+    static constexpr auto SAVE_GAME_JOURNAL_ENTRY_SIZE{ sizeof(uint16_t) + sizeof(uint8_t) + sizeof(uint32_t) + sizeof(int16_t) + 3 * sizeof(uint8_t) };
+
+    //-------------------------------------------------
+    // Types
+    //-------------------------------------------------
+
+    /**
+     * A changed tile since the last full savegame.
+     */
+    struct SaveGameJournalEntry
+    {
+        uint16_t island{ 0 };
+        uint8_t layerType{ 0 };
+        uint32_t tileIndex{ 0 };
+        SaveGameTile tile;
+    };
+
+    //-------------------------------------------------
+    // SaveGameJournal
+    //-------------------------------------------------
+
+    /**
+     * Stores the changes since the last full savegame (checkpoint) in a file next to it.
+     *
+     * Layout: header (magic, format version, checkpoint Id),
+     * then appended blocks of the number of entries followed by the entries.
+     * A journal is only replayed on the savegame with the same checkpoint Id.
+     */
+    class SaveGameJournal
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        SaveGameJournal() = delete;
+        SaveGameJournal(const SaveGameJournal& t_other) = delete;
+        SaveGameJournal(SaveGameJournal&& t_other) noexcept = delete;
+        SaveGameJournal& operator=(const SaveGameJournal& t_other) = delete;
+        SaveGameJournal& operator=(SaveGameJournal&& t_other) noexcept = delete;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * Gets the path to the journal of a savegame.
+         *
+         * @param t_saveGameFilePath The path to the savegame.
+         *
+         * @return The path to the journal.
+         */
+        [[nodiscard]] static std::string GetFilePath(const std::string& t_saveGameFilePath);
+
+        //-------------------------------------------------
+        // Changes
+        //-------------------------------------------------
+
+        /**
+         * Collects the changed tiles of all layers since the last call.
+         * Each tile is only taken once with its current values.
+         *
+         * @param t_terrain The Terrain object.
+         *
+         * @return The journal entries.
+         */
+        [[nodiscard]] static std::vector<SaveGameJournalEntry> TakeChanges(world::Terrain& t_terrain);
+
+        //-------------------------------------------------
+        // Read / Write
+        //-------------------------------------------------
+
+        /**
+         * Appends a block of entries. Creates the journal if it does not exist.
+         *
+         * @param t_filePath The path to the journal.
+         * @param t_checkpointId The checkpoint Id of the savegame.
+         * @param t_entries The entries to append.
+         */
+        static void Append(const std::string& t_filePath, uint64_t t_checkpointId, const std::vector<SaveGameJournalEntry>& t_entries);
+
+        /**
+         * Reads all entries of a journal. An incomplete last block is ignored.
+         *
+         * @param t_filePath The path to the journal.
+         * @param t_checkpointId The checkpoint Id of the loaded savegame.
+         *
+         * @return The entries or an empty vector if there is no journal for the savegame.
+         */
+        [[nodiscard]] static std::vector<SaveGameJournalEntry> Read(const std::string& t_filePath, uint64_t t_checkpointId);
+
+        /**
+         * Applies the entries on the Tile objects of the loaded islands.
+         * Must be called before the islands are prepared for rendering.
+         *
+         * @param t_entries The journal entries.
+         * @param t_terrain The Terrain object.
+         */
+        static void Replay(const std::vector<SaveGameJournalEntry>& t_entries, world::Terrain& t_terrain);
+
+        /**
+         * Applies an entry on the Tile objects of a layer.
+         *
+         * @param t_entry The journal entry.
+         * @param t_tiles The Tile objects of the layer the entry belongs to.
+         */
+        static void ReplayEntry(const SaveGameJournalEntry& t_entry, const std::vector<std::shared_ptr<layer::Tile>>& t_tiles);
+
+    protected:
+
+    private:
+    };
+}
@@ -22,6 +22,7 @@
 #include "ogl/buffer/Ssbo.h"
 #include "world/World.h"
 #include "eventpp/utilities/argumentadapter.h"
+#include "profiler/Profiler.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -84,6 +85,8 @@ int32_t mdcii::layer::GameLayer::GetMapIndex(const glm::ivec2& t_position, const
 
 void mdcii::layer::GameLayer::PrepareCpuDataForRendering()
 {
+    MDCII_PROFILE_SCOPE("GameLayer::PrepareCpuDataForRendering")
+
     CreateTiles();
     SortTiles();
 
@@ -94,6 +97,8 @@ void mdcii::layer::GameLayer::PrepareCpuDataForRendering()
 
 void mdcii::layer::GameLayer::PrepareGpuDataForRendering()
 {
+    MDCII_PROFILE_SCOPE("GameLayer::PrepareGpuDataForRendering")
+
     StoreModelMatricesInGpu();
     StoreGfxNumbersInGpu();
     StoreBuildingIdsInGpu();
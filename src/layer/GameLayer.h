@@ -131,6 +131,11 @@ namespace mdcii::layer
          */
         int32_t instancesToRender{ -1 };
 
+        /**
+         * The position of the first instance of an island layer in the Ssbos shared by all islands.
+         */
+        int32_t baseInstance{ 0 };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -21,6 +21,8 @@
 #include "state/State.h"
 #include "file/OriginalResourcesManager.h"
 #include "renderer/RenderUtils.h"
+#include "ogl/buffer/Ssbo.h"
+#include "profiler/Profiler.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -37,6 +39,36 @@ mdcii::layer::GridLayer::~GridLayer() noexcept
     Log::MDCII_LOG_DEBUG("[GridLayer::~GridLayer()] Destruct GridLayer.");
 }
 
+//-------------------------------------------------
+// Highlights
+//-------------------------------------------------
+
+void mdcii::layer::GridLayer::StoreHighlightsInGpu(const std::vector<bool>& t_highlights, const world::Zoom t_zoom, const world::Rotation t_rotation)
+{
+    MDCII_PROFILE_SCOPE("GridLayer::StoreHighlightsInGpu")
+
+    std::vector<glm::mat4> matrices;
+    for (const auto& tile : sortedTiles.at(magic_enum::enum_integer(t_rotation)))
+    {
+        const auto index{ static_cast<size_t>(tile->islandYDeg0) * width + tile->islandXDeg0 };
+        if (index < t_highlights.size() && t_highlights[index])
+        {
+            matrices.emplace_back(CreateModelMatrix(*tile, t_zoom, t_rotation));
+        }
+    }
+
+    if (!highlightsSsbo)
+    {
+        highlightsSsbo = std::make_unique<ogl::buffer::Ssbo>("Highlights_Ssbo");
+    }
+
+    highlightsSsbo->Bind();
+    ogl::buffer::Ssbo::StoreData(static_cast<uint32_t>(matrices.size()) * sizeof(glm::mat4), matrices.data());
+    ogl::buffer::Ssbo::Unbind();
+
+    highlightsToRender = static_cast<int32_t>(matrices.size());
+}
+
 //-------------------------------------------------
 // Override
 //-------------------------------------------------
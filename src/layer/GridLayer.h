@@ -43,6 +43,16 @@ namespace mdcii::layer
          */
         std::array<std::vector<std::shared_ptr<Tile>>, world::NR_OF_ROTATIONS> sortedTiles;
 
+        /**
+         * The model matrices of the highlighted tiles for a single zoom and rotation.
+         */
+        std::unique_ptr<ogl::buffer::Ssbo> highlightsSsbo;
+
+        /**
+         * The number of highlighted tiles.
+         */
+        int32_t highlightsToRender{ 0 };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -64,6 +74,19 @@ namespace mdcii::layer
 
         ~GridLayer() noexcept override;
 
+        //-------------------------------------------------
+        // Highlights
+        //-------------------------------------------------
+
+        /**
+         * Stores the model matrices of the highlighted tiles in the highlightsSsbo.
+         *
+         * @param t_highlights A flag for each island position (row-major, width * height).
+         * @param t_zoom The zoom for which to create the model matrices.
+         * @param t_rotation The rotation for which to create the model matrices.
+         */
+        void StoreHighlightsInGpu(const std::vector<bool>& t_highlights, world::Zoom t_zoom, world::Rotation t_rotation);
+
     protected:
 
     private:
@@ -22,7 +22,6 @@
 #include "world/Island.h"
 #include "world/World.h"
 #include "file/OriginalResourcesManager.h"
-#include "ogl/buffer/Ssbo.h"
 #include "renderer/RenderUtils.h"
 
 void mdcii::layer::to_json(nlohmann::json& t_json, const std::shared_ptr<Tile>& t_tile)
@@ -33,8 +32,7 @@ void mdcii::layer::to_json(nlohmann::json& t_json, const std::shared_ptr<Tile>&
             { "id", t_tile->buildingId },
             { "rotation", magic_enum::enum_integer(t_tile->rotation) },
             { "x", t_tile->x },
-            { "y", t_tile->y },
-            { "connected", t_tile->connectedTiles }
+            { "y", t_tile->y }
         };
     }
     else
@@ -43,36 +41,6 @@ void mdcii::layer::to_json(nlohmann::json& t_json, const std::shared_ptr<Tile>&
     }
 }
 
-void mdcii::layer::from_json(const nlohmann::json& t_json, Tile& t_tile)
-{
-    if (t_json.count("id"))
-    {
-        t_json.at("id").get_to(t_tile.buildingId);
-    }
-
-    if (t_json.count("rotation"))
-    {
-        auto r{ 0 };
-        t_json.at("rotation").get_to(r);
-        t_tile.rotation = world::int_to_rotation(r);
-    }
-
-    if (t_json.count("x"))
-    {
-        t_json.at("x").get_to(t_tile.x);
-    }
-
-    if (t_json.count("y"))
-    {
-        t_json.at("y").get_to(t_tile.y);
-    }
-
-    if (t_json.count("connected"))
-    {
-        t_json.at("connected").get_to(t_tile.connectedTiles);
-    }
-}
-
 //-------------------------------------------------
 // Ctors. / Dtor.
 //-------------------------------------------------
@@ -109,17 +77,18 @@ mdcii::layer::TerrainLayer::~TerrainLayer() noexcept
 // Tiles
 //-------------------------------------------------
 
-void mdcii::layer::TerrainLayer::CreateTilesFromJson(const nlohmann::json& t_json)
+void mdcii::layer::TerrainLayer::SetTiles(std::vector<std::shared_ptr<Tile>> t_tiles)
 {
-    Log::MDCII_LOG_DEBUG("[TerrainLayer::CreateTilesFromJson()] Create Tile objects from Json.");
+    Log::MDCII_LOG_DEBUG("[TerrainLayer::SetTiles()] Set {} Tile objects.", t_tiles.size());
 
-    for (const auto& [k, v] : t_json.items())
+    tiles = std::move(t_tiles);
+    for (const auto& tile : tiles)
     {
-        AddTileFromJson(v);
+        tile->layerType = layerType;
     }
 
-    MDCII_ASSERT(!tiles.empty(), "[TerrainLayer::CreateTilesFromJson()] Missing Tile objects.")
-    MDCII_ASSERT(instancesToRender == static_cast<int32_t>(tiles.size()), "[TerrainLayer::CreateTilesFromJson()] Invalid map data.")
+    MDCII_ASSERT(!tiles.empty(), "[TerrainLayer::SetTiles()] Missing Tile objects.")
+    MDCII_ASSERT(instancesToRender == static_cast<int32_t>(tiles.size()), "[TerrainLayer::SetTiles()] Invalid map data.")
 }
 
 const mdcii::layer::Tile& mdcii::layer::TerrainLayer::GetTile(const int32_t t_x, const int32_t t_y) const
@@ -163,6 +132,35 @@ void mdcii::layer::TerrainLayer::StoreTile(std::unique_ptr<Tile> t_tile)
     });
 }
 
+void mdcii::layer::TerrainLayer::CreateSaveGameTiles()
+{
+    MDCII_ASSERT(!tiles.empty(), "[TerrainLayer::CreateSaveGameTiles()] Missing Tile objects.")
+
+    saveGameTiles = std::make_shared<std::vector<file::SaveGameTile>>();
+    saveGameTiles->reserve(tiles.size());
+    for (const auto& tile : tiles)
+    {
+        saveGameTiles->push_back(file::to_save_game_tile(*tile));
+    }
+
+    changedSaveGameTiles.clear();
+}
+
+void mdcii::layer::TerrainLayer::UpdateSaveGameTile(const Tile& t_tile)
+{
+    MDCII_ASSERT(saveGameTiles, "[TerrainLayer::UpdateSaveGameTile()] Null pointer.")
+
+    // a snapshot still holds the current values
+    if (saveGameTiles.use_count() > 1)
+    {
+        saveGameTiles = std::make_shared<std::vector<file::SaveGameTile>>(*saveGameTiles);
+    }
+
+    const auto index{ GetMapIndex(t_tile.islandXDeg0, t_tile.islandYDeg0, world::Rotation::DEG0) };
+    saveGameTiles->at(index) = file::to_save_game_tile(t_tile);
+    changedSaveGameTiles.push_back(index);
+}
+
 void mdcii::layer::TerrainLayer::PreCalcTile(Tile& t_tile) const
 {
     // pre-calculate the position on the screen for each zoom and each rotation
@@ -463,38 +461,3 @@ void mdcii::layer::TerrainLayer::CreateBuildingIdsContainer()
     buildingIds = ids;
 }
 
-void mdcii::layer::TerrainLayer::StoreGfxNumbersInGpu()
-{
-    Log::MDCII_LOG_DEBUG("[TerrainLayer::StoreGfxNumbersInGpu()] Store gfx numbers container in Gpu memory.");
-
-    MDCII_ASSERT(!gfxNumbers.empty(), "[TerrainLayer::StoreGfxNumbersInGpu()] Invalid gfx numbers container size.")
-    MDCII_ASSERT(!gfxNumbersSsbo, "[TerrainLayer::StoreGfxNumbersInGpu()] Invalid gfx numbers Ssbo pointer.")
-
-    gfxNumbersSsbo = std::make_unique<ogl::buffer::Ssbo>("GfxNumbers_Ssbo");
-    gfxNumbersSsbo->Bind();
-    ogl::buffer::Ssbo::StoreData(static_cast<uint32_t>(gfxNumbers.size()) * sizeof(glm::ivec4), gfxNumbers.data());
-    ogl::buffer::Ssbo::Unbind();
-}
-
-void mdcii::layer::TerrainLayer::StoreBuildingIdsInGpu()
-{
-    Log::MDCII_LOG_DEBUG("[TerrainLayer::StoreBuildingIdsInGpu()] Store Building Ids container in Gpu memory.");
-
-    MDCII_ASSERT(!buildingIds.empty(), "[TerrainLayer::StoreBuildingIdsInGpu()] Invalid Building Ids container size.")
-    MDCII_ASSERT(!buildingIdsSsbo, "[TerrainLayer::StoreBuildingIdsInGpu()] Invalid Building Ids Ssbo pointer.")
-
-    buildingIdsSsbo = std::make_unique<ogl::buffer::Ssbo>("BuildingIds_Ssbo");
-    buildingIdsSsbo->Bind();
-    ogl::buffer::Ssbo::StoreData(static_cast<uint32_t>(buildingIds.size()) * sizeof(glm::ivec4), buildingIds.data());
-    ogl::buffer::Ssbo::Unbind();
-}
-
-//-------------------------------------------------
-// Helper
-//-------------------------------------------------
-
-void mdcii::layer::TerrainLayer::AddTileFromJson(const nlohmann::json& t_json)
-{
-    tiles.emplace_back(std::make_unique<Tile>(t_json.get<Tile>()));
-    tiles.back()->layerType = layerType;
-}
@@ -20,6 +20,7 @@
 
 #include "GameLayer.h"
 #include "Tile.h"
+#include "file/SaveGame.h"
 
 //-------------------------------------------------
 // Forward declarations
@@ -44,7 +45,6 @@ namespace mdcii::layer
     //-------------------------------------------------
 
     void to_json(nlohmann::json& t_json, const std::shared_ptr<Tile>& t_tile);
-    void from_json(const nlohmann::json& t_json, Tile& t_tile);
 
     //-------------------------------------------------
     // TerrainLayer
@@ -80,6 +80,17 @@ namespace mdcii::layer
          */
         std::unordered_map<glm::ivec3, int32_t> instanceIds;
 
+        /**
+         * The savegame values of all Tile objects in the order DEG0.
+         * Running saves share the vector, so it is copied before a change (copy-on-write).
+         */
+        std::shared_ptr<std::vector<file::SaveGameTile>> saveGameTiles;
+
+        /**
+         * The indices of the savegame values changed since the last save.
+         */
+        std::vector<int32_t> changedSaveGameTiles;
+
         /**
          * To store the gfx number for each instance.
          * x = gfx for rot0
@@ -98,16 +109,6 @@ namespace mdcii::layer
          */
         std::vector<glm::ivec4> buildingIds;
 
-        /**
-         * A Ssbo containing the gfx number for each instance.
-         */
-        std::unique_ptr<ogl::buffer::Ssbo> gfxNumbersSsbo;
-
-        /**
-         * A Ssbo containing the Building Id number for each instance.
-         */
-        std::unique_ptr<ogl::buffer::Ssbo> buildingIdsSsbo;
-
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -136,11 +137,11 @@ namespace mdcii::layer
         //-------------------------------------------------
 
         /**
-         * Creates the Tile objects from a Json value.
+         * Takes the Tile objects read from a map.
          *
-         * @param t_json The Json value.
+         * @param t_tiles The Tile objects in Deg0 order.
          */
-        void CreateTilesFromJson(const nlohmann::json& t_json);
+        void SetTiles(std::vector<std::shared_ptr<Tile>> t_tiles);
 
         /**
          * Returns a Tile object.
@@ -184,6 +185,18 @@ namespace mdcii::layer
          */
         void StoreTile(std::unique_ptr<Tile> t_tile);
 
+        /**
+         * Creates the savegame values of all Tile objects.
+         */
+        void CreateSaveGameTiles();
+
+        /**
+         * Updates the savegame values of a changed Tile object.
+         *
+         * @param t_tile The changed Tile object.
+         */
+        void UpdateSaveGameTile(const Tile& t_tile);
+
         /**
          * Adds some pre-calculations to every Tile object of the Layer,
          * which are necessary to render the Tile on the screen.
@@ -259,19 +272,5 @@ namespace mdcii::layer
         void CreateModelMatricesContainer() override;
         void CreateGfxNumbersContainer() override;
         void CreateBuildingIdsContainer() override;
-
-        void StoreGfxNumbersInGpu() override;
-        void StoreBuildingIdsInGpu() override;
-
-        //-------------------------------------------------
-        // Helper
-        //-------------------------------------------------
-
-        /**
-         * Adds a Tile pointer from a given Json value.
-         *
-         * @param t_json The Json value.
-         */
-        void AddTileFromJson(const nlohmann::json& t_json);
     };
 }
@@ -55,7 +55,7 @@ void mdcii::layer::Tile::ResetBuildingInfo()
     x = 0;
     y = 0;
     gfxs = {};
-    connectedTiles = {};
+    placedBuildingIndex = world::BuildingRegistry::NO_PLACED_BUILDING;
 }
 
 //-------------------------------------------------
@@ -137,20 +137,5 @@ void mdcii::layer::Tile::RenderImGui() const
         ImGui::TreePop();
     }
 
-    if (connectedTiles.empty())
-    {
-        ImGui::Text("Connected tiles: none");
-    }
-    else
-    {
-        if (ImGui::TreeNode("Connected tiles"))
-        {
-            for (const auto tileIndex : connectedTiles)
-            {
-                ImGui::Text("Connected tile index: %d", tileIndex);
-            }
-
-            ImGui::TreePop();
-        }
-    }
+    ImGui::Text("Placed building index: %d", placedBuildingIndex);
 }
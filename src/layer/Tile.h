@@ -20,6 +20,7 @@
 
 #include "world/Rotation.h"
 #include "world/Zoom.h"
+#include "world/BuildingRegistry.h"
 
 //-------------------------------------------------
 // Tile
@@ -124,9 +125,9 @@ namespace mdcii::layer
         std::vector<int32_t> gfxs{};
 
         /**
-         * If a building requires more than 1x1 tiles, all indices are stored here.
+         * The index of the building in the BuildingRegistry of the island.
          */
-        std::vector<int32_t> connectedTiles{};
+        int32_t placedBuildingIndex{ world::BuildingRegistry::NO_PLACED_BUILDING };
 
         /**
          * The parent LayerType.
@@ -19,7 +19,6 @@
 #pragma once
 
 #include "GameLayer.h"
-#include "Tile.h"
 
 //-------------------------------------------------
 // WorldLayer
@@ -29,61 +28,39 @@ namespace mdcii::layer
 {
     /**
      * The WorldLayer contains all the data to render the deep water area of the world.
+     * No Tile objects are created. The water tiles of the visible area are generated
+     * in the shader from the instance Id and the island grid.
      */
     class WorldLayer : public GameLayer
     {
     public:
         //-------------------------------------------------
-        // Member
+        // Constants
         //-------------------------------------------------
 
         /**
-         * Contains all Tile pointers in the order DEG0.
-         */
-        std::vector<std::shared_ptr<Tile>> tiles;
-
-        /**
-         * A vector of Tile pointers for each rotation.
-         * The Tile pointers are in the correct order for rendering.
+         * Each water tile is based on this Building Id.
          */
-        std::array<std::vector<std::shared_ptr<Tile>>, world::NR_OF_ROTATIONS> sortedTiles;
-
-        /**
-         * This allows the Instance Id to be determined for each (rotated) position in the world.
-         * x = worldX
-         * y = worldY
-         * z = rotation as Int
-         * result/value = The Instance Id
-         */
-        std::unordered_map<glm::ivec3, int32_t> instanceIds;
+        static constexpr auto WATER_BUILDING_ID{ 1201 };
 
         /**
-         * To store the gfx number for each instance.
-         * x = gfx for rot0
-         * y = gfx for rot90
-         * z = gfx for rot180
-         * w = gfx for rot270
+         * Each water tile is based on this gfx number.
          */
-        std::vector<glm::ivec4> gfxNumbers;
+        static constexpr auto WATER_GFX{ 758 };
 
-        /**
-         * To store the Building Id for each instance.
-         * x = building for rot0
-         * y = building for rot90
-         * z = building for rot180
-         * w = building for rot270
-         */
-        std::vector<glm::ivec4> buildingIds;
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
 
         /**
-         * A Ssbo containing the gfx number for each instance.
+         * The size of the water gfx for each zoom.
          */
-        std::unique_ptr<ogl::buffer::Ssbo> gfxNumbersSsbo;
+        std::array<glm::vec2, world::NR_OF_ZOOMS> waterSizes{};
 
         /**
-         * A Ssbo containing the Building Id number for each instance.
+         * A Ssbo containing the island index of each world position.
          */
-        std::unique_ptr<ogl::buffer::Ssbo> buildingIdsSsbo;
+        std::unique_ptr<ogl::buffer::Ssbo> islandGridSsbo;
 
         //-------------------------------------------------
         // Ctors. / Dtor.
@@ -110,46 +87,17 @@ namespace mdcii::layer
 
     private:
         //-------------------------------------------------
-        // Constants
+        // Override
         //-------------------------------------------------
 
         /**
-         * Each model matrix is based on this Building Id.
+         * There are no model matrices. Only the size of the water gfx is determined for each zoom.
          */
-        static constexpr auto WATER_BUILDING_ID{ 1201 };
-
-        /**
-         * Each model matrix is based on this gfx number.
-         */
-        static constexpr auto WATER_GFX{ 758 };
-
-        //-------------------------------------------------
-        // Override
-        //-------------------------------------------------
-
-        void CreateTiles() override;
-        void SortTiles() override;
-
         void CreateModelMatricesContainer() override;
-        void CreateGfxNumbersContainer() override;
-        void CreateBuildingIdsContainer() override;
-
-        void StoreGfxNumbersInGpu() override;
-        void StoreBuildingIdsInGpu() override;
-
-        //-------------------------------------------------
-        // Helper
-        //-------------------------------------------------
 
         /**
-         * Creates a model matrix for a given Tile object.
-         *
-         * @param t_tile The Tile object.
-         * @param t_zoom The zoom for which to create the model matrix.
-         * @param t_rotation The rotation for which to create the model matrix.
-         *
-         * @return The model matrix.
+         * Stores the island grid in the Gpu instead of model matrices.
          */
-        [[nodiscard]] glm::mat4 CreateModelMatrix(const Tile& t_tile, world::Zoom t_zoom, world::Rotation t_rotation) const;
+        void StoreModelMatricesInGpu() override;
     };
 }
@@ -0,0 +1,404 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "StateCache.h"
+#include "MdciiAssert.h"
+
+//-------------------------------------------------
+// Device
+//-------------------------------------------------
+
+namespace mdcii::ogl
+{
+    //-------------------------------------------------
+    // Types
+    //-------------------------------------------------
+
+    enum class BufferTarget
+    {
+        ARRAY,
+        SHADER_STORAGE,
+        UNIFORM,
+        DRAW_INDIRECT
+    };
+
+    enum class BufferUsage
+    {
+        STATIC_DRAW,
+        DYNAMIC_DRAW
+    };
+
+    enum class AttributeType
+    {
+        FLOAT,
+        INT
+    };
+
+    /**
+     * A draw command in a draw indirect buffer, laid out as expected by glMultiDrawArraysIndirect.
+     */
+    struct DrawArraysIndirectCommand
+    {
+        uint32_t count{ 0 };
+        uint32_t instanceCount{ 0 };
+        uint32_t first{ 0 };
+        uint32_t baseInstance{ 0 };
+    };
+
+    static_assert(sizeof(DrawArraysIndirectCommand) == 16);
+
+    /**
+     * The counters of a Device, e.g. to compare the upload volume of two builds.
+     */
+    struct DeviceStatistics
+    {
+        int64_t bufferUploads{ 0 };
+        int64_t bytesUploaded{ 0 };
+        int64_t drawCalls{ 0 };
+        int64_t instancesDrawn{ 0 };
+        int64_t bufferBindings{ 0 };
+        int64_t stateChanges{ 0 };
+        int64_t skippedStateChanges{ 0 };
+
+        DeviceStatistics operator-(const DeviceStatistics& t_other) const
+        {
+            return {
+                bufferUploads - t_other.bufferUploads,
+                bytesUploaded - t_other.bytesUploaded,
+                drawCalls - t_other.drawCalls,
+                instancesDrawn - t_other.instancesDrawn,
+                bufferBindings - t_other.bufferBindings,
+                stateChanges - t_other.stateChanges,
+                skippedStateChanges - t_other.skippedStateChanges
+            };
+        }
+    };
+
+    //-------------------------------------------------
+    // Device
+    //-------------------------------------------------
+
+    /**
+     * A thin layer over the OpenGL calls of the buffer wrappers and renderers.
+     * The GlDevice calls OpenGL, the RecordingDevice only records the calls,
+     * so that the renderers can be tested and benchmarked without a Gpu context.
+     * Binds which would not change the state are skipped by a StateCache.
+     */
+    class Device
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The value of GL_TRIANGLES, so that the callers don't need the OpenGL headers.
+         */
+        static constexpr uint32_t DRAW_MODE_TRIANGLES{ 0x0004 };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The counters since the last reset.
+         */
+        DeviceStatistics statistics;
+
+        /**
+         * The counters of the last finished frame.
+         */
+        DeviceStatistics frameStatistics;
+
+        /**
+         * Skips binds which would not change the state if true.
+         */
+        bool useStateCache{ true };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Device() = default;
+
+        Device(const Device& t_other) = delete;
+        Device(Device&& t_other) noexcept = delete;
+        Device& operator=(const Device& t_other) = delete;
+        Device& operator=(Device&& t_other) noexcept = delete;
+
+        virtual ~Device() noexcept = default;
+
+        //-------------------------------------------------
+        // Current device
+        //-------------------------------------------------
+
+        /**
+         * Get the device used by the buffer wrappers and renderers.
+         *
+         * @return The current Device object.
+         */
+        static Device& Get()
+        {
+            MDCII_ASSERT(m_current, "[Device::Get()] No device was set.")
+            return *m_current;
+        }
+
+        /**
+         * Sets the device used by the buffer wrappers and renderers.
+         *
+         * @param t_device The new Device object.
+         */
+        static void Set(std::unique_ptr<Device> t_device)
+        {
+            m_current = std::move(t_device);
+        }
+
+        //-------------------------------------------------
+        // Frame
+        //-------------------------------------------------
+
+        /**
+         * Stores the counters of the finished frame in frameStatistics.
+         */
+        void EndFrame()
+        {
+            frameStatistics = statistics - m_frameStart;
+            m_frameStart = statistics;
+        }
+
+        /**
+         * Sets all counters to zero.
+         */
+        void ResetStatistics()
+        {
+            statistics = {};
+            frameStatistics = {};
+            m_frameStart = {};
+        }
+
+        //-------------------------------------------------
+        // State
+        //-------------------------------------------------
+
+        /**
+         * Forgets the shadowed state. Must be called after code outside
+         * the Device, e.g. the ImGui backend, has changed the bindings.
+         */
+        void InvalidateState()
+        {
+            m_stateCache.Invalidate();
+        }
+
+        void UseProgram(const uint32_t t_id)
+        {
+            if (Changes(m_stateCache.SetProgram(t_id)))
+            {
+                IssueUseProgram(t_id);
+            }
+        }
+
+        /**
+         * Must be called before a program is deleted.
+         *
+         * @param t_id The program handle.
+         */
+        void ForgetProgram(const uint32_t t_id)
+        {
+            m_stateCache.ForgetProgram(t_id);
+        }
+
+        /**
+         * Activates a texture unit.
+         *
+         * @param t_unit The texture unit, e.g. GL_TEXTURE0.
+         */
+        void ActiveTexture(const uint32_t t_unit)
+        {
+            if (Changes(m_stateCache.SetActiveTexture(t_unit)))
+            {
+                IssueActiveTexture(t_unit);
+            }
+        }
+
+        /**
+         * Binds a texture to the active texture unit.
+         *
+         * @param t_target The texture target, e.g. GL_TEXTURE_2D.
+         * @param t_id The texture handle.
+         */
+        void BindTexture(const uint32_t t_target, const uint32_t t_id)
+        {
+            if (Changes(m_stateCache.SetTexture(t_target, t_id)))
+            {
+                IssueBindTexture(t_target, t_id);
+            }
+        }
+
+        /**
+         * Must be called before a texture is deleted.
+         *
+         * @param t_id The texture handle.
+         */
+        void ForgetTexture(const uint32_t t_id)
+        {
+            m_stateCache.ForgetTexture(t_id);
+        }
+
+        //-------------------------------------------------
+        // Buffers
+        //-------------------------------------------------
+
+        [[nodiscard]] virtual uint32_t CreateBuffer() = 0;
+
+        void DeleteBuffer(const uint32_t t_id)
+        {
+            m_stateCache.ForgetBuffer(t_id);
+            IssueDeleteBuffer(t_id);
+        }
+
+        void BindBuffer(const BufferTarget t_target, const uint32_t t_id)
+        {
+            if (Changes(m_stateCache.SetBuffer(static_cast<int32_t>(t_target), t_id)))
+            {
+                IssueBindBuffer(t_target, t_id);
+            }
+        }
+
+        void BindBufferBase(const BufferTarget t_target, const uint32_t t_index, const uint32_t t_id)
+        {
+            if (Changes(m_stateCache.SetBufferBase(static_cast<int32_t>(t_target), t_index, t_id)))
+            {
+                statistics.bufferBindings++;
+                IssueBindBufferBase(t_target, t_index, t_id);
+            }
+        }
+
+        virtual void BufferData(BufferTarget t_target, uint32_t t_size, const void* t_data, BufferUsage t_usage) = 0;
+        virtual void BufferSubData(BufferTarget t_target, int32_t t_offset, uint32_t t_size, const void* t_data) = 0;
+
+        //-------------------------------------------------
+        // Vertex arrays
+        //-------------------------------------------------
+
+        [[nodiscard]] virtual uint32_t CreateVertexArray() = 0;
+
+        void DeleteVertexArray(const uint32_t t_id)
+        {
+            m_stateCache.ForgetVertexArray(t_id);
+            IssueDeleteVertexArray(t_id);
+        }
+
+        void BindVertexArray(const uint32_t t_id)
+        {
+            if (Changes(m_stateCache.SetVertexArray(t_id)))
+            {
+                IssueBindVertexArray(t_id);
+            }
+        }
+
+        /**
+         * Enables and describes a vertex attribute of the bound array buffer.
+         *
+         * @param t_index The index of the attribute.
+         * @param t_components The number of components, e.g. 2 for a vec2.
+         * @param t_type The type of the components.
+         * @param t_stride The size of a vertex in bytes.
+         * @param t_offset The offset of the attribute in bytes.
+         * @param t_divisor The number of instances which share a value, 0 if the attribute advances per vertex.
+         */
+        virtual void VertexAttribute(uint32_t t_index, int32_t t_components, AttributeType t_type, int32_t t_stride, uint64_t t_offset, uint32_t t_divisor) = 0;
+
+        //-------------------------------------------------
+        // Draw
+        //-------------------------------------------------
+
+        virtual void DrawArrays(uint32_t t_drawMode, int32_t t_first, int32_t t_count) = 0;
+        virtual void DrawArraysInstanced(uint32_t t_drawMode, int32_t t_first, int32_t t_count, int32_t t_instances) = 0;
+
+        /**
+         * Draws the commands of the bound draw indirect buffer with a single call.
+         *
+         * @param t_drawMode The OpenGL primitive type to draw.
+         * @param t_drawCount The number of commands.
+         * @param t_instances The number of instances of all commands, only used for the statistics.
+         */
+        virtual void MultiDrawArraysIndirect(uint32_t t_drawMode, int32_t t_drawCount, int64_t t_instances) = 0;
+
+    protected:
+        //-------------------------------------------------
+        // Issue
+        //-------------------------------------------------
+
+        // only called if the StateCache has seen a change
+
+        virtual void IssueUseProgram(uint32_t t_id) = 0;
+        virtual void IssueActiveTexture(uint32_t t_unit) = 0;
+        virtual void IssueBindTexture(uint32_t t_target, uint32_t t_id) = 0;
+        virtual void IssueDeleteBuffer(uint32_t t_id) = 0;
+        virtual void IssueBindBuffer(BufferTarget t_target, uint32_t t_id) = 0;
+        virtual void IssueBindBufferBase(BufferTarget t_target, uint32_t t_index, uint32_t t_id) = 0;
+        virtual void IssueDeleteVertexArray(uint32_t t_id) = 0;
+        virtual void IssueBindVertexArray(uint32_t t_id) = 0;
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        inline static std::unique_ptr<Device> m_current;
+
+        /**
+         * The shadowed bindings.
+         */
+        StateCache m_stateCache;
+
+        /**
+         * The counters at the start of the current frame.
+         */
+        DeviceStatistics m_frameStart;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Counts a state change.
+         *
+         * @param t_changed True if the StateCache has seen a change.
+         *
+         * @return True if the call has to be issued.
+         */
+        bool Changes(const bool t_changed)
+        {
+            if (t_changed || !useStateCache)
+            {
+                statistics.stateChanges++;
+                return true;
+            }
+
+            statistics.skippedStateChanges++;
+
+            return false;
+        }
+    };
+}
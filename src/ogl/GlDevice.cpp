@@ -0,0 +1,190 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#include "GlDevice.h"
+#include "OpenGL.h"
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+namespace
+{
+    GLenum ToGl(const mdcii::ogl::BufferTarget t_target)
+    {
+        switch (t_target)
+        {
+        case mdcii::ogl::BufferTarget::ARRAY:
+            return GL_ARRAY_BUFFER;
+        case mdcii::ogl::BufferTarget::SHADER_STORAGE:
+            return GL_SHADER_STORAGE_BUFFER;
+        case mdcii::ogl::BufferTarget::UNIFORM:
+            return GL_UNIFORM_BUFFER;
+        default:
+            return GL_DRAW_INDIRECT_BUFFER;
+        }
+    }
+
+    GLenum ToGl(const mdcii::ogl::BufferUsage t_usage)
+    {
+        return t_usage == mdcii::ogl::BufferUsage::STATIC_DRAW ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW;
+    }
+}
+
+//-------------------------------------------------
+// Buffers
+//-------------------------------------------------
+
+uint32_t mdcii::ogl::GlDevice::CreateBuffer()
+{
+    uint32_t id{ 0 };
+    glGenBuffers(1, &id);
+
+    return id;
+}
+
+void mdcii::ogl::GlDevice::BufferData(const BufferTarget t_target, const uint32_t t_size, const void* t_data, const BufferUsage t_usage)
+{
+    if (t_data)
+    {
+        statistics.bufferUploads++;
+        statistics.bytesUploaded += t_size;
+    }
+
+    glBufferData(ToGl(t_target), t_size, t_data, ToGl(t_usage));
+}
+
+void mdcii::ogl::GlDevice::BufferSubData(const BufferTarget t_target, const int32_t t_offset, const uint32_t t_size, const void* t_data)
+{
+    statistics.bufferUploads++;
+    statistics.bytesUploaded += t_size;
+
+    glBufferSubData(ToGl(t_target), t_offset, t_size, t_data);
+}
+
+//-------------------------------------------------
+// Vertex arrays
+//-------------------------------------------------
+
+uint32_t mdcii::ogl::GlDevice::CreateVertexArray()
+{
+    uint32_t id{ 0 };
+    glGenVertexArrays(1, &id);
+
+    return id;
+}
+
+void mdcii::ogl::GlDevice::VertexAttribute(
+    const uint32_t t_index,
+    const int32_t t_components,
+    const AttributeType t_type,
+    const int32_t t_stride,
+    const uint64_t t_offset,
+    const uint32_t t_divisor
+)
+{
+    glEnableVertexAttribArray(t_index);
+
+    if (t_type == AttributeType::FLOAT)
+    {
+        glVertexAttribPointer(t_index, t_components, GL_FLOAT, GL_FALSE, t_stride, reinterpret_cast<void*>(t_offset)); // NOLINT(performance-no-int-to-ptr)
+    }
+    else
+    {
+        glVertexAttribIPointer(t_index, t_components, GL_INT, t_stride, reinterpret_cast<void*>(t_offset)); // NOLINT(performance-no-int-to-ptr)
+    }
+
+    if (t_divisor > 0)
+    {
+        glVertexAttribDivisor(t_index, t_divisor);
+    }
+}
+
+//-------------------------------------------------
+// Draw
+//-------------------------------------------------
+
+void mdcii::ogl::GlDevice::DrawArrays(const uint32_t t_drawMode, const int32_t t_first, const int32_t t_count)
+{
+    statistics.drawCalls++;
+    statistics.instancesDrawn++;
+
+    glDrawArrays(t_drawMode, t_first, t_count);
+}
+
+void mdcii::ogl::GlDevice::DrawArraysInstanced(const uint32_t t_drawMode, const int32_t t_first, const int32_t t_count, const int32_t t_instances)
+{
+    statistics.drawCalls++;
+    statistics.instancesDrawn += t_instances;
+
+    glDrawArraysInstanced(t_drawMode, t_first, t_count, t_instances);
+}
+
+void mdcii::ogl::GlDevice::MultiDrawArraysIndirect(const uint32_t t_drawMode, const int32_t t_drawCount, const int64_t t_instances)
+{
+    statistics.drawCalls++;
+    statistics.instancesDrawn += t_instances;
+
+    // the commands are tightly packed from the start of the bound draw indirect buffer
+    glMultiDrawArraysIndirect(t_drawMode, nullptr, t_drawCount, 0);
+}
+
+//-------------------------------------------------
+// Issue
+//-------------------------------------------------
+
+void mdcii::ogl::GlDevice::IssueUseProgram(const uint32_t t_id)
+{
+    glUseProgram(t_id);
+}
+
+void mdcii::ogl::GlDevice::IssueActiveTexture(const uint32_t t_unit)
+{
+    glActiveTexture(t_unit);
+}
+
+void mdcii::ogl::GlDevice::IssueBindTexture(const uint32_t t_target, const uint32_t t_id)
+{
+    glBindTexture(t_target, t_id);
+}
+
+void mdcii::ogl::GlDevice::IssueDeleteBuffer(const uint32_t t_id)
+{
+    glDeleteBuffers(1, &t_id);
+}
+
+void mdcii::ogl::GlDevice::IssueBindBuffer(const BufferTarget t_target, const uint32_t t_id)
+{
+    glBindBuffer(ToGl(t_target), t_id);
+}
+
+void mdcii::ogl::GlDevice::IssueBindBufferBase(const BufferTarget t_target, const uint32_t t_index, const uint32_t t_id)
+{
+    glBindBufferBase(ToGl(t_target), t_index, t_id);
+}
+
+void mdcii::ogl::GlDevice::IssueDeleteVertexArray(const uint32_t t_id)
+{
+    glDeleteVertexArrays(1, &t_id);
+}
+
+void mdcii::ogl::GlDevice::IssueBindVertexArray(const uint32_t t_id)
+{
+    glBindVertexArray(t_id);
+}
@@ -0,0 +1,88 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include "Device.h"
+
+//-------------------------------------------------
+// GlDevice
+//-------------------------------------------------
+
+namespace mdcii::ogl
+{
+    /**
+     * Passes all calls to OpenGL. Needs a current OpenGL context.
+     */
+    class GlDevice : public Device
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        GlDevice() = default;
+
+        GlDevice(const GlDevice& t_other) = delete;
+        GlDevice(GlDevice&& t_other) noexcept = delete;
+        GlDevice& operator=(const GlDevice& t_other) = delete;
+        GlDevice& operator=(GlDevice&& t_other) noexcept = delete;
+
+        ~GlDevice() noexcept override = default;
+
+        //-------------------------------------------------
+        // Buffers
+        //-------------------------------------------------
+
+        [[nodiscard]] uint32_t CreateBuffer() override;
+        void BufferData(BufferTarget t_target, uint32_t t_size, const void* t_data, BufferUsage t_usage) override;
+        void BufferSubData(BufferTarget t_target, int32_t t_offset, uint32_t t_size, const void* t_data) override;
+
+        //-------------------------------------------------
+        // Vertex arrays
+        //-------------------------------------------------
+
+        [[nodiscard]] uint32_t CreateVertexArray() override;
+        void VertexAttribute(uint32_t t_index, int32_t t_components, AttributeType t_type, int32_t t_stride, uint64_t t_offset, uint32_t t_divisor) override;
+
+        //-------------------------------------------------
+        // Draw
+        //-------------------------------------------------
+
+        void DrawArrays(uint32_t t_drawMode, int32_t t_first, int32_t t_count) override;
+        void DrawArraysInstanced(uint32_t t_drawMode, int32_t t_first, int32_t t_count, int32_t t_instances) override;
+        void MultiDrawArraysIndirect(uint32_t t_drawMode, int32_t t_drawCount, int64_t t_instances) override;
+
+    protected:
+        //-------------------------------------------------
+        // Issue
+        //-------------------------------------------------
+
+        void IssueUseProgram(uint32_t t_id) override;
+        void IssueActiveTexture(uint32_t t_unit) override;
+        void IssueBindTexture(uint32_t t_target, uint32_t t_id) override;
+        void IssueDeleteBuffer(uint32_t t_id) override;
+        void IssueBindBuffer(BufferTarget t_target, uint32_t t_id) override;
+        void IssueBindBufferBase(BufferTarget t_target, uint32_t t_index, uint32_t t_id) override;
+        void IssueDeleteVertexArray(uint32_t t_id) override;
+        void IssueBindVertexArray(uint32_t t_id) override;
+
+    private:
+    };
+}
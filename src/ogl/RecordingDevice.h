@@ -0,0 +1,252 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Device.h"
+
+//-------------------------------------------------
+// RecordingDevice
+//-------------------------------------------------
+
+namespace mdcii::ogl
+{
+    /**
+     * A device without a Gpu. Hands out fake handles, counts the work
+     * and optionally records each call, so that the buffer wrappers
+     * and renderers can run in tests and without an OpenGL context.
+     */
+    class RecordingDevice : public Device
+    {
+    public:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * Records every call as a line like "DrawArraysInstanced 4 0 6 100" if true.
+         */
+        bool recordCommands{ false };
+
+        /**
+         * The recorded calls.
+         */
+        std::vector<std::string> commands;
+
+        /**
+         * The number of buffers which are currently not deleted.
+         */
+        int32_t liveBuffers{ 0 };
+
+        /**
+         * The number of vertex arrays which are currently not deleted.
+         */
+        int32_t liveVertexArrays{ 0 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        RecordingDevice() = default;
+
+        explicit RecordingDevice(const bool t_recordCommands)
+            : recordCommands{ t_recordCommands }
+        {}
+
+        RecordingDevice(const RecordingDevice& t_other) = delete;
+        RecordingDevice(RecordingDevice&& t_other) noexcept = delete;
+        RecordingDevice& operator=(const RecordingDevice& t_other) = delete;
+        RecordingDevice& operator=(RecordingDevice&& t_other) noexcept = delete;
+
+        ~RecordingDevice() noexcept override = default;
+
+        //-------------------------------------------------
+        // Reset
+        //-------------------------------------------------
+
+        /**
+         * Clears the statistics, the shadowed state and the recorded calls. The handles stay valid.
+         */
+        void Reset()
+        {
+            ResetStatistics();
+            commands.clear();
+            InvalidateState();
+        }
+
+        //-------------------------------------------------
+        // Buffers
+        //-------------------------------------------------
+
+        [[nodiscard]] uint32_t CreateBuffer() override
+        {
+            liveBuffers++;
+            Record("CreateBuffer", m_nextId);
+
+            return m_nextId++;
+        }
+
+        void BufferData(const BufferTarget t_target, const uint32_t t_size, const void* t_data, const BufferUsage t_usage) override
+        {
+            if (t_data)
+            {
+                statistics.bufferUploads++;
+                statistics.bytesUploaded += t_size;
+            }
+
+            Record("BufferData", static_cast<int64_t>(t_target), t_size, static_cast<int64_t>(t_usage));
+        }
+
+        void BufferSubData(const BufferTarget t_target, const int32_t t_offset, const uint32_t t_size, const void*) override
+        {
+            statistics.bufferUploads++;
+            statistics.bytesUploaded += t_size;
+
+            Record("BufferSubData", static_cast<int64_t>(t_target), t_offset, t_size);
+        }
+
+        //-------------------------------------------------
+        // Vertex arrays
+        //-------------------------------------------------
+
+        [[nodiscard]] uint32_t CreateVertexArray() override
+        {
+            liveVertexArrays++;
+            Record("CreateVertexArray", m_nextId);
+
+            return m_nextId++;
+        }
+
+        void VertexAttribute(
+            const uint32_t t_index,
+            const int32_t t_components,
+            const AttributeType t_type,
+            const int32_t t_stride,
+            const uint64_t t_offset,
+            const uint32_t t_divisor
+        ) override
+        {
+            Record("VertexAttribute", t_index, t_components, static_cast<int64_t>(t_type), t_stride, static_cast<int64_t>(t_offset), t_divisor);
+        }
+
+        //-------------------------------------------------
+        // Draw
+        //-------------------------------------------------
+
+        void DrawArrays(const uint32_t t_drawMode, const int32_t t_first, const int32_t t_count) override
+        {
+            statistics.drawCalls++;
+            statistics.instancesDrawn++;
+
+            Record("DrawArrays", t_drawMode, t_first, t_count);
+        }
+
+        void DrawArraysInstanced(const uint32_t t_drawMode, const int32_t t_first, const int32_t t_count, const int32_t t_instances) override
+        {
+            statistics.drawCalls++;
+            statistics.instancesDrawn += t_instances;
+
+            Record("DrawArraysInstanced", t_drawMode, t_first, t_count, t_instances);
+        }
+
+        void MultiDrawArraysIndirect(const uint32_t t_drawMode, const int32_t t_drawCount, const int64_t t_instances) override
+        {
+            statistics.drawCalls++;
+            statistics.instancesDrawn += t_instances;
+
+            Record("MultiDrawArraysIndirect", t_drawMode, t_drawCount, t_instances);
+        }
+
+    protected:
+        //-------------------------------------------------
+        // Issue
+        //-------------------------------------------------
+
+        void IssueUseProgram(const uint32_t t_id) override
+        {
+            Record("UseProgram", t_id);
+        }
+
+        void IssueActiveTexture(const uint32_t t_unit) override
+        {
+            Record("ActiveTexture", t_unit);
+        }
+
+        void IssueBindTexture(const uint32_t t_target, const uint32_t t_id) override
+        {
+            Record("BindTexture", t_target, t_id);
+        }
+
+        void IssueDeleteBuffer(const uint32_t t_id) override
+        {
+            liveBuffers--;
+            Record("DeleteBuffer", t_id);
+        }
+
+        void IssueBindBuffer(const BufferTarget t_target, const uint32_t t_id) override
+        {
+            Record("BindBuffer", static_cast<int64_t>(t_target), t_id);
+        }
+
+        void IssueBindBufferBase(const BufferTarget t_target, const uint32_t t_index, const uint32_t t_id) override
+        {
+            Record("BindBufferBase", static_cast<int64_t>(t_target), t_index, t_id);
+        }
+
+        void IssueDeleteVertexArray(const uint32_t t_id) override
+        {
+            liveVertexArrays--;
+            Record("DeleteVertexArray", t_id);
+        }
+
+        void IssueBindVertexArray(const uint32_t t_id) override
+        {
+            Record("BindVertexArray", t_id);
+        }
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The next fake handle. Zero is never handed out, like in OpenGL.
+         */
+        uint32_t m_nextId{ 1 };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        template<typename... T>
+        void Record(const std::string& t_name, const T... t_args)
+        {
+            if (!recordCommands)
+            {
+                return;
+            }
+
+            auto command{ t_name };
+            ((command += ' ' + std::to_string(static_cast<int64_t>(t_args))), ...);
+            commands.push_back(std::move(command));
+        }
+    };
+}
@@ -0,0 +1,231 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+
+//-------------------------------------------------
+// StateCache
+//-------------------------------------------------
+
+namespace mdcii::ogl
+{
+    /**
+     * Shadows the bound program, vertex array, buffers and textures,
+     * so that a Device can skip calls which would not change anything.
+     * Each Set function returns true if the call has to be issued.
+     */
+    class StateCache
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * Marks a binding whose current value is not known, e.g. after foreign code has changed the state.
+         */
+        static constexpr uint32_t UNKNOWN{ std::numeric_limits<uint32_t>::max() };
+
+        static constexpr auto MAX_BUFFER_TARGETS{ 4 };
+        static constexpr auto MAX_BUFFER_BINDINGS{ 16 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        StateCache()
+        {
+            Invalidate();
+        }
+
+        StateCache(const StateCache& t_other) = delete;
+        StateCache(StateCache&& t_other) noexcept = delete;
+        StateCache& operator=(const StateCache& t_other) = delete;
+        StateCache& operator=(StateCache&& t_other) noexcept = delete;
+
+        ~StateCache() noexcept = default;
+
+        //-------------------------------------------------
+        // Set
+        //-------------------------------------------------
+
+        bool SetProgram(const uint32_t t_id)
+        {
+            return Set(m_program, t_id);
+        }
+
+        bool SetVertexArray(const uint32_t t_id)
+        {
+            return Set(m_vertexArray, t_id);
+        }
+
+        bool SetBuffer(const int32_t t_target, const uint32_t t_id)
+        {
+            return Set(m_buffers.at(t_target), t_id);
+        }
+
+        bool SetBufferBase(const int32_t t_target, const uint32_t t_index, const uint32_t t_id)
+        {
+            // an issued indexed binding also changes the generic binding of the target,
+            // a skipped one leaves it as it is
+            if (t_index >= MAX_BUFFER_BINDINGS || Set(m_bufferBases.at(t_target).at(t_index), t_id))
+            {
+                m_buffers.at(t_target) = t_id;
+                return true;
+            }
+
+            return false;
+        }
+
+        bool SetActiveTexture(const uint32_t t_unit)
+        {
+            return Set(m_activeTexture, t_unit);
+        }
+
+        /**
+         * Binds a texture to the active texture unit.
+         *
+         * @param t_target The texture target, e.g. GL_TEXTURE_2D.
+         * @param t_id The texture handle.
+         *
+         * @return True if the call has to be issued.
+         */
+        bool SetTexture(const uint32_t t_target, const uint32_t t_id)
+        {
+            // the unit the texture goes to is unknown, so nothing can be said about it
+            if (m_activeTexture == UNKNOWN)
+            {
+                return true;
+            }
+
+            const auto key{ static_cast<uint64_t>(m_activeTexture) << 32 | t_target };
+            if (const auto it{ m_textures.find(key) }; it != m_textures.end() && it->second == t_id)
+            {
+                return false;
+            }
+
+            m_textures[key] = t_id;
+
+            return true;
+        }
+
+        //-------------------------------------------------
+        // Forget
+        //-------------------------------------------------
+
+        /**
+         * Must be called before a buffer is deleted, because its handle can be reused.
+         *
+         * @param t_id The buffer handle.
+         */
+        void ForgetBuffer(const uint32_t t_id)
+        {
+            for (auto t{ 0 }; t < MAX_BUFFER_TARGETS; ++t)
+            {
+                Forget(m_buffers.at(t), t_id);
+                for (auto& binding : m_bufferBases.at(t))
+                {
+                    Forget(binding, t_id);
+                }
+            }
+        }
+
+        void ForgetVertexArray(const uint32_t t_id)
+        {
+            Forget(m_vertexArray, t_id);
+        }
+
+        void ForgetProgram(const uint32_t t_id)
+        {
+            Forget(m_program, t_id);
+        }
+
+        void ForgetTexture(const uint32_t t_id)
+        {
+            for (auto it{ m_textures.begin() }; it != m_textures.end();)
+            {
+                it = it->second == t_id ? m_textures.erase(it) : std::next(it);
+            }
+        }
+
+        /**
+         * Forgets all bindings. Must be called after code outside the Device has changed the state.
+         */
+        void Invalidate()
+        {
+            m_program = UNKNOWN;
+            m_vertexArray = UNKNOWN;
+            m_activeTexture = UNKNOWN;
+            m_buffers.fill(UNKNOWN);
+            for (auto& bindings : m_bufferBases)
+            {
+                bindings.fill(UNKNOWN);
+            }
+            m_textures.clear();
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        uint32_t m_program{ UNKNOWN };
+        uint32_t m_vertexArray{ UNKNOWN };
+        uint32_t m_activeTexture{ UNKNOWN };
+        std::array<uint32_t, MAX_BUFFER_TARGETS> m_buffers{};
+        std::array<std::array<uint32_t, MAX_BUFFER_BINDINGS>, MAX_BUFFER_TARGETS> m_bufferBases{};
+
+        /**
+         * The bound textures by texture unit (high bits) and target (low bits).
+         */
+        std::unordered_map<uint64_t, uint32_t> m_textures;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        static bool Set(uint32_t& t_binding, const uint32_t t_id)
+        {
+            if (t_binding == t_id)
+            {
+                return false;
+            }
+
+            t_binding = t_id;
+
+            return true;
+        }
+
+        static void Forget(uint32_t& t_binding, const uint32_t t_id)
+        {
+            if (t_binding == t_id)
+            {
+                t_binding = UNKNOWN;
+            }
+        }
+    };
+}
@@ -17,7 +17,9 @@
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <cstdlib>
 #include "Window.h"
+#include "GlDevice.h"
 #include "Game.h"
 #include "Log.h"
 #include "MdciiException.h"
@@ -29,7 +31,8 @@
 // Ctors. / Dtor.
 //-------------------------------------------------
 
-mdcii::ogl::Window::Window()
+mdcii::ogl::Window::Window(const bool t_headless)
+    : headless{ t_headless }
 {
     Log::MDCII_LOG_DEBUG("[Window::Window()] Create Window.");
 
@@ -98,11 +101,21 @@ bool mdcii::ogl::Window::IsKeyPressed(const int t_keyCode) const
 
 bool mdcii::ogl::Window::IsMouseButtonPressed(const int t_button) const
 {
+    if (event::EventManager::IsReplaying())
+    {
+        return event::EventManager::IsReplayMouseButtonDown(t_button);
+    }
+
     return glfwGetMouseButton(m_windowHandle, t_button) == GLFW_PRESS;
 }
 
 glm::vec2 mdcii::ogl::Window::GetMousePosition() const
 {
+    if (event::EventManager::IsReplaying())
+    {
+        return event::EventManager::GetReplayMousePosition();
+    }
+
     double x;
     double y;
     glfwGetCursorPos(m_windowHandle, &x, &y);
@@ -117,6 +130,19 @@ void mdcii::ogl::Window::ImGuiBegin()
 {
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
+
+    // ImGui polls the mouse itself, so the replayed state must replace it
+    if (event::EventManager::IsReplaying())
+    {
+        auto& io{ ImGui::GetIO() };
+        const auto& position{ event::EventManager::GetReplayMousePosition() };
+        io.MousePos = ImVec2(position.x, position.y);
+        for (auto i{ 0 }; i < IM_ARRAYSIZE(io.MouseDown); ++i)
+        {
+            io.MouseDown[i] = event::EventManager::IsReplayMouseButtonDown(i);
+        }
+    }
+
     ImGui::NewFrame();
 }
 
@@ -124,6 +150,9 @@ void mdcii::ogl::Window::ImGuiEnd()
 {
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+    // the ImGui backend binds its own program, buffers and texture
+    Device::Get().InvalidateState();
 }
 
 //-------------------------------------------------
@@ -149,12 +178,14 @@ void mdcii::ogl::Window::LoadConfig()
 
     width = Game::INI.Get<int>("window", "width");
     height = Game::INI.Get<int>("window", "height");
+    vsync = Game::INI.Get<bool>("window", "vsync");
 
     width = std::max(width, MIN_WIDTH);
     height = std::max(height, MIN_HEIGHT);
 
     Log::MDCII_LOG_INFO("Game window width: {}", width);
     Log::MDCII_LOG_INFO("Game window height: {}", height);
+    Log::MDCII_LOG_INFO("Game window vsync: {}", vsync);
 }
 
 void mdcii::ogl::Window::InitWindow()
@@ -168,6 +199,15 @@ void mdcii::ogl::Window::InitWindow()
         }
     );
 
+#if !defined(_WIN64) && (GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4))
+    // Without a display, use the null platform and an offscreen OSMesa context.
+    if (headless && !std::getenv("DISPLAY") && !std::getenv("WAYLAND_DISPLAY"))
+    {
+        Log::MDCII_LOG_INFO("No display found. Use the GLFW null platform with OSMesa.");
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
+#endif
+
     // Initialize GLFW.
     if (!glfwInit())
     {
@@ -175,8 +215,8 @@ void mdcii::ogl::Window::InitWindow()
     }
 
     glfwDefaultWindowHints();
-    glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
-    glfwWindowHint(GLFW_FOCUSED, GL_TRUE);
+    glfwWindowHint(GLFW_VISIBLE, headless ? GL_FALSE : GL_TRUE);
+    glfwWindowHint(GLFW_FOCUSED, headless ? GL_FALSE : GL_TRUE);
     glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
@@ -184,6 +224,13 @@ void mdcii::ogl::Window::InitWindow()
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
     glfwWindowHint(GLFW_SAMPLES, 4);
 
+#if !defined(_WIN64) && (GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4))
+    if (glfwGetPlatform() == GLFW_PLATFORM_NULL)
+    {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+    }
+#endif
+
     // Create the GLFW window.
     m_windowHandle = glfwCreateWindow(width, height, m_title.c_str(), nullptr, nullptr);
     if (!m_windowHandle)
@@ -192,19 +239,26 @@ void mdcii::ogl::Window::InitWindow()
         throw MDCII_EXCEPTION("[Window::InitWindow()] Failed to create the GLFW window.");
     }
 
-    // Get the resolution of the primary monitor.
-    const auto* primaryMonitor{ glfwGetVideoMode(glfwGetPrimaryMonitor()) };
-    if (!primaryMonitor)
+    // There may be no monitor in headless mode.
+    if (!headless)
     {
-        throw MDCII_EXCEPTION("[Window::InitWindow()] Unable to get the primary monitor.");
-    }
+        // Get the resolution of the primary monitor.
+        const auto* primaryMonitor{ glfwGetVideoMode(glfwGetPrimaryMonitor()) };
+        if (!primaryMonitor)
+        {
+            throw MDCII_EXCEPTION("[Window::InitWindow()] Unable to get the primary monitor.");
+        }
 
-    // Center our window.
-    glfwSetWindowPos(GetWindowHandle(), (primaryMonitor->width - width) / 2, (primaryMonitor->height - height) / 2);
+        // Center our window.
+        glfwSetWindowPos(GetWindowHandle(), (primaryMonitor->width - width) / 2, (primaryMonitor->height - height) / 2);
+    }
 
     // Make the OpenGL context current.
     glfwMakeContextCurrent(GetWindowHandle());
 
+    // Don't wait for the vertical sync when measuring frame times.
+    glfwSwapInterval(vsync && !headless ? 1 : 0);
+
     // Update viewport.
     glViewport(0, 0, width, height);
 
@@ -215,6 +269,9 @@ void mdcii::ogl::Window::InitWindow()
         throw MDCII_EXCEPTION("[Window::InitWindow()] Unable to initialize GLEW." + std::string(reinterpret_cast<const char*>(glewGetErrorString(err))));
     }
 
+    // The buffer wrappers and renderers call OpenGL through the device.
+    Device::Set(std::make_unique<GlDevice>());
+
     // Print out some information about the graphics drivers.
     Log::MDCII_LOG_INFO("OpenGL version: {}", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
     Log::MDCII_LOG_INFO("GLSL version: {}", reinterpret_cast<const char*>(glGetString(GL_SHADING_LANGUAGE_VERSION)));
@@ -222,7 +279,10 @@ void mdcii::ogl::Window::InitWindow()
     Log::MDCII_LOG_INFO("Renderer: {}", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
 
     // Make the window visible.
-    glfwShowWindow(GetWindowHandle());
+    if (!headless)
+    {
+        glfwShowWindow(GetWindowHandle());
+    }
 }
 
 void mdcii::ogl::Window::InitProjectionMatrix()
@@ -253,6 +313,7 @@ void mdcii::ogl::Window::InitInputCallbacks() const
 {
     Log::MDCII_LOG_DEBUG("[Window::InitInputCallbacks()] Initializing input callbacks.");
 
+    event::EventManager::InitEventQueue();
     event::EventManager::SetKeyboardGlfwCallbacks(m_windowHandle);
     event::EventManager::SetMouseGlfwCallbacks(m_windowHandle);
 }
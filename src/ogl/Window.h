@@ -70,11 +70,26 @@ namespace mdcii::ogl
          */
         int32_t height{ MIN_HEIGHT };
 
+        /**
+         * True if the window is never shown, e.g. for benchmarks.
+         */
+        bool headless{ false };
+
+        /**
+         * True if the buffer swaps wait for the vertical sync.
+         */
+        bool vsync{ true };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
 
-        Window();
+        /**
+         * Constructs a new Window object.
+         *
+         * @param t_headless True to create an invisible window.
+         */
+        explicit Window(bool t_headless = false);
 
         Window(const Window& t_other) = delete;
         Window(Window&& t_other) noexcept = delete;
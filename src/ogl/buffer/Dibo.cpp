@@ -0,0 +1,105 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include "Dibo.h"
+#include "MdciiAssert.h"
+#include "ogl/Device.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+mdcii::ogl::buffer::Dibo::Dibo()
+{
+    Log::MDCII_LOG_DEBUG("[Dibo::Dibo()] Create Dibo.");
+
+    CreateId();
+}
+
+mdcii::ogl::buffer::Dibo::Dibo(std::string t_name)
+    : name{ std::move(t_name) }
+{
+    Log::MDCII_LOG_DEBUG("[Dibo::Dibo()] Create Dibo {}.", name);
+
+    CreateId();
+}
+
+mdcii::ogl::buffer::Dibo::~Dibo() noexcept
+{
+    Log::MDCII_LOG_DEBUG("[Dibo::~Dibo()] Destruct Dibo.");
+
+    CleanUp();
+}
+
+//-------------------------------------------------
+// Bind / unbind
+//-------------------------------------------------
+
+void mdcii::ogl::buffer::Dibo::Bind() const
+{
+    MDCII_ASSERT(id, "[Dibo::Bind()] Invalid Dibo handle.")
+    Device::Get().BindBuffer(BufferTarget::DRAW_INDIRECT, id);
+}
+
+void mdcii::ogl::buffer::Dibo::Unbind()
+{
+    Device::Get().BindBuffer(BufferTarget::DRAW_INDIRECT, 0);
+}
+
+//-------------------------------------------------
+// Data
+//-------------------------------------------------
+
+void mdcii::ogl::buffer::Dibo::StoreData(const uint32_t t_size, const void* t_data)
+{
+    Device::Get().BufferData(BufferTarget::DRAW_INDIRECT, t_size, t_data, BufferUsage::DYNAMIC_DRAW);
+}
+
+void mdcii::ogl::buffer::Dibo::StoreSubData(const int32_t t_offset, const uint32_t t_size, const void* t_data)
+{
+    Device::Get().BufferSubData(BufferTarget::DRAW_INDIRECT, t_offset, t_size, t_data);
+}
+
+//-------------------------------------------------
+// Create
+//-------------------------------------------------
+
+void mdcii::ogl::buffer::Dibo::CreateId()
+{
+    id = Device::Get().CreateBuffer();
+    MDCII_ASSERT(id, "[Dibo::CreateId()] Error while creating a new Dibo handle.")
+
+    Log::MDCII_LOG_DEBUG("[Dibo::CreateId()] A new Dibo handle was created. The Id is {}.", id);
+}
+
+//-------------------------------------------------
+// Clean up
+//-------------------------------------------------
+
+void mdcii::ogl::buffer::Dibo::CleanUp() const
+{
+    Log::MDCII_LOG_DEBUG("[Dibo::CleanUp()] Clean up Dibo {} Id {}.", name, id);
+
+    Unbind();
+
+    if (id)
+    {
+        Device::Get().DeleteBuffer(id);
+        Log::MDCII_LOG_DEBUG("[Dibo::CleanUp()] Dibo {} Id {} was deleted.", name, id);
+    }
+}
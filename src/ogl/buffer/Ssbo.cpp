@@ -18,7 +18,7 @@
 
 #include "Ssbo.h"
 #include "MdciiAssert.h"
-#include "ogl/OpenGL.h"
+#include "ogl/Device.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -53,12 +53,18 @@ mdcii::ogl::buffer::Ssbo::~Ssbo() noexcept
 void mdcii::ogl::buffer::Ssbo::Bind() const
 {
     MDCII_ASSERT(id, "[Ssbo::Bind()] Invalid Ssbo handle.")
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, id);
+    Device::Get().BindBuffer(BufferTarget::SHADER_STORAGE, id);
 }
 
 void mdcii::ogl::buffer::Ssbo::Unbind()
 {
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    Device::Get().BindBuffer(BufferTarget::SHADER_STORAGE, 0);
+}
+
+void mdcii::ogl::buffer::Ssbo::BindBase(const uint32_t t_index) const
+{
+    MDCII_ASSERT(id, "[Ssbo::BindBase()] Invalid Ssbo handle.")
+    Device::Get().BindBufferBase(BufferTarget::SHADER_STORAGE, t_index, id);
 }
 
 //-------------------------------------------------
@@ -67,12 +73,12 @@ void mdcii::ogl::buffer::Ssbo::Unbind()
 
 void mdcii::ogl::buffer::Ssbo::StoreData(const uint32_t t_size, const void* t_data)
 {
-    glBufferData(GL_SHADER_STORAGE_BUFFER, t_size, t_data, GL_DYNAMIC_DRAW);
+    Device::Get().BufferData(BufferTarget::SHADER_STORAGE, t_size, t_data, BufferUsage::DYNAMIC_DRAW);
 }
 
 void mdcii::ogl::buffer::Ssbo::StoreSubData(const int32_t t_offset, const uint32_t t_size, const void* t_data)
 {
-    glBufferSubData(GL_SHADER_STORAGE_BUFFER, t_offset, t_size, t_data);
+    Device::Get().BufferSubData(BufferTarget::SHADER_STORAGE, t_offset, t_size, t_data);
 }
 
 //-------------------------------------------------
@@ -81,7 +87,7 @@ void mdcii::ogl::buffer::Ssbo::StoreSubData(const int32_t t_offset, const uint32
 
 void mdcii::ogl::buffer::Ssbo::CreateId()
 {
-    glGenBuffers(1, &id);
+    id = Device::Get().CreateBuffer();
     MDCII_ASSERT(id, "[Ssbo::CreateId()] Error while creating a new Ssbo handle.")
 
     Log::MDCII_LOG_DEBUG("[Ssbo::CreateId()] A new Ssbo handle was created. The Id is {}.", id);
@@ -99,7 +105,7 @@ void mdcii::ogl::buffer::Ssbo::CleanUp() const
 
     if (id)
     {
-        glDeleteBuffers(1, &id);
+        Device::Get().DeleteBuffer(id);
         Log::MDCII_LOG_DEBUG("[Ssbo::CleanUp()] Ssbo {} Id {} was deleted.", name, id);
     }
 }
@@ -76,6 +76,13 @@ namespace mdcii::ogl::buffer
          */
         static void Unbind();
 
+        /**
+         * Binds this Ssbo handle to an indexed binding point of the shader storage.
+         *
+         * @param t_index The index of the binding point.
+         */
+        void BindBase(uint32_t t_index) const;
+
         //-------------------------------------------------
         // Data
         //-------------------------------------------------
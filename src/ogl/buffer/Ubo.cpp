@@ -0,0 +1,111 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#include "Ubo.h"
+#include "MdciiAssert.h"
+#include "ogl/Device.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+mdcii::ogl::buffer::Ubo::Ubo()
+{
+    Log::MDCII_LOG_DEBUG("[Ubo::Ubo()] Create Ubo.");
+
+    CreateId();
+}
+
+mdcii::ogl::buffer::Ubo::Ubo(std::string t_name)
+    : name{ std::move(t_name) }
+{
+    Log::MDCII_LOG_DEBUG("[Ubo::Ubo()] Create Ubo {}.", name);
+
+    CreateId();
+}
+
+mdcii::ogl::buffer::Ubo::~Ubo() noexcept
+{
+    Log::MDCII_LOG_DEBUG("[Ubo::~Ubo()] Destruct Ubo.");
+
+    CleanUp();
+}
+
+//-------------------------------------------------
+// Bind / unbind
+//-------------------------------------------------
+
+void mdcii::ogl::buffer::Ubo::Bind() const
+{
+    MDCII_ASSERT(id, "[Ubo::Bind()] Invalid Ubo handle.")
+    Device::Get().BindBuffer(BufferTarget::UNIFORM, id);
+}
+
+void mdcii::ogl::buffer::Ubo::Unbind()
+{
+    Device::Get().BindBuffer(BufferTarget::UNIFORM, 0);
+}
+
+void mdcii::ogl::buffer::Ubo::BindBase(const uint32_t t_index) const
+{
+    MDCII_ASSERT(id, "[Ubo::BindBase()] Invalid Ubo handle.")
+    Device::Get().BindBufferBase(BufferTarget::UNIFORM, t_index, id);
+}
+
+//-------------------------------------------------
+// Data
+//-------------------------------------------------
+
+void mdcii::ogl::buffer::Ubo::StoreData(const uint32_t t_size, const void* t_data)
+{
+    Device::Get().BufferData(BufferTarget::UNIFORM, t_size, t_data, BufferUsage::DYNAMIC_DRAW);
+}
+
+void mdcii::ogl::buffer::Ubo::StoreSubData(const int32_t t_offset, const uint32_t t_size, const void* t_data)
+{
+    Device::Get().BufferSubData(BufferTarget::UNIFORM, t_offset, t_size, t_data);
+}
+
+//-------------------------------------------------
+// Create
+//-------------------------------------------------
+
+void mdcii::ogl::buffer::Ubo::CreateId()
+{
+    id = Device::Get().CreateBuffer();
+    MDCII_ASSERT(id, "[Ubo::CreateId()] Error while creating a new Ubo handle.")
+
+    Log::MDCII_LOG_DEBUG("[Ubo::CreateId()] A new Ubo handle was created. The Id is {}.", id);
+}
+
+//-------------------------------------------------
+// Clean up
+//-------------------------------------------------
+
+void mdcii::ogl::buffer::Ubo::CleanUp() const
+{
+    Log::MDCII_LOG_DEBUG("[Ubo::CleanUp()] Clean up Ubo {} Id {}.", name, id);
+
+    Unbind();
+
+    if (id)
+    {
+        Device::Get().DeleteBuffer(id);
+        Log::MDCII_LOG_DEBUG("[Ubo::CleanUp()] Ubo {} Id {} was deleted.", name, id);
+    }
+}
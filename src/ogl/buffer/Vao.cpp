@@ -20,7 +20,7 @@
 #include "Vbo.h"
 #include "Ssbo.h"
 #include "MdciiAssert.h"
-#include "ogl/OpenGL.h"
+#include "ogl/Device.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -47,12 +47,12 @@ mdcii::ogl::buffer::Vao::~Vao() noexcept
 void mdcii::ogl::buffer::Vao::Bind() const
 {
     MDCII_ASSERT(id, "[Vao::Bind()] Invalid Vao handle.")
-    glBindVertexArray(id);
+    Device::Get().BindVertexArray(id);
 }
 
 void mdcii::ogl::buffer::Vao::Unbind()
 {
-    glBindVertexArray(0);
+    Device::Get().BindVertexArray(0);
 }
 
 //-------------------------------------------------
@@ -62,7 +62,7 @@ void mdcii::ogl::buffer::Vao::Unbind()
 void mdcii::ogl::buffer::Vao::DrawPrimitives(const uint32_t t_drawMode, const int32_t t_first) const
 {
     MDCII_ASSERT(drawCount, "[Vao::DrawPrimitives()] Invalid draw count.")
-    glDrawArrays(t_drawMode, t_first, drawCount);
+    Device::Get().DrawArrays(t_drawMode, t_first, drawCount);
 }
 
 void mdcii::ogl::buffer::Vao::DrawPrimitives(const uint32_t t_drawMode) const
@@ -72,13 +72,13 @@ void mdcii::ogl::buffer::Vao::DrawPrimitives(const uint32_t t_drawMode) const
 
 void mdcii::ogl::buffer::Vao::DrawPrimitives() const
 {
-    DrawPrimitives(GL_TRIANGLES);
+    DrawPrimitives(Device::DRAW_MODE_TRIANGLES);
 }
 
 void mdcii::ogl::buffer::Vao::DrawInstanced(const uint32_t t_drawMode, const int32_t t_first, const int32_t t_instances) const
 {
     MDCII_ASSERT(drawCount, "[Vao::DrawInstanced()] Invalid draw count.")
-    glDrawArraysInstanced(t_drawMode, t_first, drawCount, t_instances);
+    Device::Get().DrawArraysInstanced(t_drawMode, t_first, drawCount, t_instances);
 }
 
 [[maybe_unused]] void mdcii::ogl::buffer::Vao::DrawInstanced(const uint32_t t_drawMode, const int32_t t_instances) const
@@ -88,7 +88,13 @@ void mdcii::ogl::buffer::Vao::DrawInstanced(const uint32_t t_drawMode, const int
 
 void mdcii::ogl::buffer::Vao::DrawInstanced(const int32_t t_instances) const
 {
-    DrawInstanced(GL_TRIANGLES, 0, t_instances);
+    DrawInstanced(Device::DRAW_MODE_TRIANGLES, 0, t_instances);
+}
+
+void mdcii::ogl::buffer::Vao::MultiDrawIndirect(const int32_t t_commands, const int64_t t_instances) const
+{
+    MDCII_ASSERT(drawCount, "[Vao::MultiDrawIndirect()] Invalid draw count.")
+    Device::Get().MultiDrawArraysIndirect(Device::DRAW_MODE_TRIANGLES, t_commands, t_instances);
 }
 
 //-------------------------------------------------
@@ -97,7 +103,7 @@ void mdcii::ogl::buffer::Vao::DrawInstanced(const int32_t t_instances) const
 
 void mdcii::ogl::buffer::Vao::CreateId()
 {
-    glGenVertexArrays(1, &id);
+    id = Device::Get().CreateVertexArray();
     MDCII_ASSERT(id, "[Vao::CreateId()] Error while creating a new Vao handle.")
 
     Log::MDCII_LOG_DEBUG("[Vao::CreateId()] A new Vao handle was created. The Id is {}.", id);
@@ -115,7 +121,7 @@ void mdcii::ogl::buffer::Vao::CleanUp() const
 
     if (id)
     {
-        glDeleteVertexArrays(1, &id);
+        Device::Get().DeleteVertexArray(id);
         Log::MDCII_LOG_DEBUG("[Vao::CleanUp()] Vao Id {} was deleted.", id);
     }
 }
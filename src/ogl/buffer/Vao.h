@@ -137,6 +137,14 @@ namespace mdcii::ogl::buffer
          */
         void DrawInstanced(int32_t t_instances) const;
 
+        /**
+         * Draws the commands of the bound Dibo with a single call.
+         *
+         * @param t_commands The number of commands.
+         * @param t_instances The number of instances of all commands.
+         */
+        void MultiDrawIndirect(int32_t t_commands, int64_t t_instances) const;
+
     protected:
 
     private:
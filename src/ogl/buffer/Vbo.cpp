@@ -18,7 +18,7 @@
 
 #include "Vbo.h"
 #include "MdciiAssert.h"
-#include "ogl/OpenGL.h"
+#include "ogl/Device.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -45,12 +45,12 @@ mdcii::ogl::buffer::Vbo::~Vbo() noexcept
 void mdcii::ogl::buffer::Vbo::Bind() const
 {
     MDCII_ASSERT(id, "[Vbo::Bind()] Invalid Vbo handle.")
-    glBindBuffer(GL_ARRAY_BUFFER, id);
+    Device::Get().BindBuffer(BufferTarget::ARRAY, id);
 }
 
 void mdcii::ogl::buffer::Vbo::Unbind()
 {
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    Device::Get().BindBuffer(BufferTarget::ARRAY, 0);
 }
 
 //-------------------------------------------------
@@ -59,17 +59,17 @@ void mdcii::ogl::buffer::Vbo::Unbind()
 
 void mdcii::ogl::buffer::Vbo::ReserveMemory(const uint32_t t_size)
 {
-    glBufferData(GL_ARRAY_BUFFER, t_size, nullptr, GL_DYNAMIC_DRAW);
+    Device::Get().BufferData(BufferTarget::ARRAY, t_size, nullptr, BufferUsage::DYNAMIC_DRAW);
 }
 
 void mdcii::ogl::buffer::Vbo::StoreStaticData(const uint32_t t_size, const void* t_data)
 {
-    glBufferData(GL_ARRAY_BUFFER, t_size, t_data, GL_STATIC_DRAW);
+    Device::Get().BufferData(BufferTarget::ARRAY, t_size, t_data, BufferUsage::STATIC_DRAW);
 }
 
 void mdcii::ogl::buffer::Vbo::StoreData(const int32_t t_offset, const uint32_t t_size, const void* t_data)
 {
-    glBufferSubData(GL_ARRAY_BUFFER, t_offset, t_size, t_data);
+    Device::Get().BufferSubData(BufferTarget::ARRAY, t_offset, t_size, t_data);
 }
 
 //-------------------------------------------------
@@ -84,20 +84,14 @@ void mdcii::ogl::buffer::Vbo::AddFloatAttribute(
     const bool t_instancing
 )
 {
-    glEnableVertexAttribArray(t_index);
-    glVertexAttribPointer(
+    Device::Get().VertexAttribute(
         t_index,
         t_nrOfFloatComponents,
-        GL_FLOAT,
-        GL_FALSE,
+        AttributeType::FLOAT,
         t_nrOfAllFloats * static_cast<int32_t>(sizeof(float)),
-        reinterpret_cast<uintptr_t*>(t_startPoint * sizeof(float)) // NOLINT(performance-no-int-to-ptr)
+        t_startPoint * sizeof(float),
+        t_instancing ? 1 : 0
     );
-
-    if (t_instancing)
-    {
-        glVertexAttribDivisor(t_index, 1);
-    }
 }
 
 void mdcii::ogl::buffer::Vbo::AddIntAttribute(
@@ -105,22 +99,17 @@ void mdcii::ogl::buffer::Vbo::AddIntAttribute(
     const int32_t t_nrOfIntComponents,
     const int32_t t_nrOfAllInts,
     const uint64_t t_startPoint,
-    const bool t_instancing
+    const uint32_t t_divisor
 )
 {
-    glEnableVertexAttribArray(t_index);
-    glVertexAttribIPointer(
+    Device::Get().VertexAttribute(
         t_index,
         t_nrOfIntComponents,
-        GL_INT,
+        AttributeType::INT,
         t_nrOfAllInts * static_cast<int32_t>(sizeof(int32_t)),
-        reinterpret_cast<uintptr_t*>(t_startPoint * sizeof(int32_t)) // NOLINT(performance-no-int-to-ptr)
+        t_startPoint * sizeof(int32_t),
+        t_divisor
     );
-
-    if (t_instancing)
-    {
-        glVertexAttribDivisor(t_index, 1);
-    }
 }
 
 //-------------------------------------------------
@@ -129,7 +118,7 @@ void mdcii::ogl::buffer::Vbo::AddIntAttribute(
 
 void mdcii::ogl::buffer::Vbo::CreateId()
 {
-    glGenBuffers(1, &id);
+    id = Device::Get().CreateBuffer();
     MDCII_ASSERT(id, "[Vbo::CreateId()] Error while creating a new Vbo handle.")
 
     Log::MDCII_LOG_DEBUG("[Vbo::CreateId()] A new Vbo handle was created. The Id is {}.", id);
@@ -147,7 +136,7 @@ void mdcii::ogl::buffer::Vbo::CleanUp() const
 
     if (id)
     {
-        glDeleteBuffers(1, &id);
+        Device::Get().DeleteBuffer(id);
         Log::MDCII_LOG_DEBUG("[Vbo::CleanUp()] Vbo Id {} was deleted.", id);
     }
 }
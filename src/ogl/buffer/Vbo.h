@@ -124,14 +124,14 @@ namespace mdcii::ogl::buffer
          * @param t_nrOfIntComponents The size of the vertex attribute.
          * @param t_nrOfAllInts The space between consecutive vertex attributes.
          * @param t_startPoint The offset of where the position data begins in the buffer.
-         * @param t_instancing Call glVertexAttribDivisor if true.
+         * @param t_divisor The number of instances which share a value, 0 if the attribute advances per vertex.
          */
         static void AddIntAttribute(
             uint32_t t_index,
             int32_t t_nrOfIntComponents,
             int32_t t_nrOfAllInts,
             uint64_t t_startPoint,
-            bool t_instancing
+            uint32_t t_divisor
         );
 
     protected:
@@ -0,0 +1,265 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+#include "Log.h"
+
+//-------------------------------------------------
+// ProgramBinaryCache
+//-------------------------------------------------
+
+namespace mdcii::ogl::resource
+{
+    /**
+     * A linked shader program as returned by glGetProgramBinary.
+     */
+    struct ProgramBinary
+    {
+        uint32_t format{ 0 };
+        std::vector<char> data;
+    };
+
+    /**
+     * Stores linked shader programs on disk, so that a program doesn't have to be compiled on every start.
+     *
+     * A binary is only valid for the driver that created it and for the exact shader sources.
+     * Both are hashed into a key which is stored in front of the binary. If the key doesn't match,
+     * the binary is ignored and the program must be compiled again.
+     */
+    class ProgramBinaryCache
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr std::array<char, 4> MAGIC{ 'M', 'D', 'P', 'B' };
+        static constexpr uint32_t VERSION{ 1 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        ProgramBinaryCache(ProgramBinaryCache&& t_other) noexcept = delete;
+        ProgramBinaryCache(const ProgramBinaryCache& t_other) = delete;
+        ProgramBinaryCache& operator=(const ProgramBinaryCache& t_other) = delete;
+        ProgramBinaryCache& operator=(ProgramBinaryCache&& t_other) noexcept = delete;
+
+        //-------------------------------------------------
+        // Key
+        //-------------------------------------------------
+
+        /**
+         * Creates the key of a program. Defines injected into the sources are part of the key,
+         * because the whole source text is hashed.
+         *
+         * @param t_vertexShaderCode The vertex shader code.
+         * @param t_fragmentShaderCode The fragment shader code.
+         * @param t_driver The vendor, renderer and version strings of the driver.
+         *
+         * @return A FNV-1a hash over all arguments.
+         */
+        static uint64_t CreateKey(const std::string& t_vertexShaderCode, const std::string& t_fragmentShaderCode, const std::string& t_driver)
+        {
+            auto hash{ FNV_OFFSET_BASIS };
+            for (const auto* part : { &t_vertexShaderCode, &t_fragmentShaderCode, &t_driver })
+            {
+                for (const auto c : *part)
+                {
+                    hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+                }
+
+                // separates the parts, so that moving text from one part to the next changes the key
+                hash = (hash ^ 0xFF) * FNV_PRIME;
+            }
+
+            return hash;
+        }
+
+        /**
+         * Creates the file name of a program, e.g. shader/world -> shader_world.bin
+         *
+         * @param t_path The path to the shader files.
+         *
+         * @return The file name in the cache directory.
+         */
+        static std::string CreateFileName(std::string t_path)
+        {
+            for (auto& c : t_path)
+            {
+                if (c == '/' || c == '\\')
+                {
+                    c = '_';
+                }
+            }
+
+            return t_path + ".bin";
+        }
+
+        //-------------------------------------------------
+        // Write
+        //-------------------------------------------------
+
+        static void Write(std::ostream& t_out, const uint64_t t_key, const ProgramBinary& t_binary)
+        {
+            t_out.write(MAGIC.data(), MAGIC.size());
+            WriteValue(t_out, VERSION);
+            WriteValue(t_out, t_key);
+            WriteValue(t_out, t_binary.format);
+            WriteValue(t_out, static_cast<uint32_t>(t_binary.data.size()));
+            t_out.write(t_binary.data.data(), static_cast<std::streamsize>(t_binary.data.size()));
+        }
+
+        /**
+         * Writes a program to the cache directory. The directory is created if necessary.
+         * A failure is only logged, the program is compiled again on the next start.
+         *
+         * @param t_filePath The path of the cache file.
+         * @param t_key The key of the program.
+         * @param t_binary The program binary.
+         *
+         * @return True if the file was written.
+         */
+        static bool Save(const std::string& t_filePath, const uint64_t t_key, const ProgramBinary& t_binary)
+        {
+            std::error_code errorCode;
+            std::filesystem::create_directories(std::filesystem::path(t_filePath).parent_path(), errorCode);
+
+            std::ofstream file{ t_filePath, std::ios::binary };
+            if (!file)
+            {
+                Log::MDCII_LOG_WARN("[ProgramBinaryCache::Save()] Unable to open file {}.", t_filePath);
+                return false;
+            }
+
+            Write(file, t_key, t_binary);
+
+            return static_cast<bool>(file);
+        }
+
+        //-------------------------------------------------
+        // Read
+        //-------------------------------------------------
+
+        /**
+         * Reads a program.
+         *
+         * @param t_in The input stream.
+         * @param t_key The expected key of the program.
+         *
+         * @return The program binary or nothing if the data is invalid or outdated.
+         */
+        static std::optional<ProgramBinary> Read(std::istream& t_in, const uint64_t t_key)
+        {
+            std::array<char, 4> magic{};
+            if (!t_in.read(magic.data(), magic.size()) || magic != MAGIC)
+            {
+                return std::nullopt;
+            }
+
+            uint32_t version{ 0 };
+            uint64_t key{ 0 };
+            if (!ReadValue(t_in, version) || version != VERSION || !ReadValue(t_in, key) || key != t_key)
+            {
+                return std::nullopt;
+            }
+
+            ProgramBinary binary;
+            uint32_t size{ 0 };
+            if (!ReadValue(t_in, binary.format) || !ReadValue(t_in, size) || size == 0)
+            {
+                return std::nullopt;
+            }
+
+            binary.data.resize(size);
+            if (!t_in.read(binary.data.data(), size))
+            {
+                return std::nullopt;
+            }
+
+            return binary;
+        }
+
+        /**
+         * Reads a program from the cache directory.
+         *
+         * @param t_filePath The path of the cache file.
+         * @param t_key The expected key of the program.
+         *
+         * @return The program binary or nothing if there is no valid file.
+         */
+        static std::optional<ProgramBinary> Load(const std::string& t_filePath, const uint64_t t_key)
+        {
+            std::ifstream file{ t_filePath, std::ios::binary };
+            if (!file)
+            {
+                return std::nullopt;
+            }
+
+            auto binary{ Read(file, t_key) };
+            if (!binary)
+            {
+                Log::MDCII_LOG_DEBUG("[ProgramBinaryCache::Load()] The file {} is invalid or outdated.", t_filePath);
+            }
+
+            return binary;
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        static constexpr uint64_t FNV_OFFSET_BASIS{ 14695981039346656037ull };
+        static constexpr uint64_t FNV_PRIME{ 1099511628211ull };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        ProgramBinaryCache() = default;
+        ~ProgramBinaryCache() noexcept = default;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        template<typename T>
+        static void WriteValue(std::ostream& t_out, const T t_value)
+        {
+            t_out.write(reinterpret_cast<const char*>(&t_value), sizeof(T));
+        }
+
+        template<typename T>
+        static bool ReadValue(std::istream& t_in, T& t_value)
+        {
+            return static_cast<bool>(t_in.read(reinterpret_cast<char*>(&t_value), sizeof(T)));
+        }
+    };
+}
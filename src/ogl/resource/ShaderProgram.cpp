@@ -16,12 +16,57 @@
 // along with this program; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
+#include <chrono>
 #include <glm/gtc/type_ptr.hpp>
 #include "ShaderProgram.h"
+#include "ProgramBinaryCache.h"
 #include "ogl/OpenGL.h"
+#include "ogl/Device.h"
 #include "MdciiAssert.h"
 #include "ResourceUtil.h"
 
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+namespace
+{
+    /**
+     * The driver which has to create the cached binaries.
+     */
+    const std::string& GetDriver()
+    {
+        static const std::string driver{ [] {
+            std::string result;
+            for (const auto name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+            {
+                const auto* value{ glGetString(name) };
+                result += value ? reinterpret_cast<const char*>(value) : "";
+                result += '\n';
+            }
+
+            return result;
+        }() };
+
+        return driver;
+    }
+
+    /**
+     * Binaries are only cached if enabled and if the driver supports at least one binary format.
+     */
+    bool UseBinaryCache()
+    {
+        static const auto use{ [] {
+            auto nrOfFormats{ 0 };
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &nrOfFormats);
+
+            return mdcii::Game::INI.Get<bool>("shader", "binary_cache") && nrOfFormats > 0;
+        }() };
+
+        return use;
+    }
+}
+
 //-------------------------------------------------
 // Ctors. / Dtor.
 //-------------------------------------------------
@@ -47,57 +92,97 @@ mdcii::ogl::resource::ShaderProgram::~ShaderProgram() noexcept
 
 void mdcii::ogl::resource::ShaderProgram::Bind() const
 {
-    glUseProgram(id);
+    Device::Get().UseProgram(id);
 }
 
 void mdcii::ogl::resource::ShaderProgram::Unbind()
 {
-    glUseProgram(0);
+    Device::Get().UseProgram(0);
 }
 
 //-------------------------------------------------
 // Set uniforms
 //-------------------------------------------------
 
+void mdcii::ogl::resource::ShaderProgram::SetUniform(const UniformHandle<int32_t> t_uniform, const int32_t t_value) const
+{
+    glUniform1i(t_uniform.location, t_value);
+}
+
+void mdcii::ogl::resource::ShaderProgram::SetUniform(const UniformHandle<float> t_uniform, const float t_value) const
+{
+    glUniform1f(t_uniform.location, t_value);
+}
+
+void mdcii::ogl::resource::ShaderProgram::SetUniform(const UniformHandle<bool> t_uniform, const bool t_value) const
+{
+    // if value == true load 1 else 0 as float
+    glUniform1f(t_uniform.location, t_value ? 1.0f : 0.0f);
+}
+
+void mdcii::ogl::resource::ShaderProgram::SetUniform(const UniformHandle<glm::vec2> t_uniform, const glm::vec2& t_value) const
+{
+    glUniform2f(t_uniform.location, t_value.x, t_value.y);
+}
+
+void mdcii::ogl::resource::ShaderProgram::SetUniform(const UniformHandle<glm::vec3> t_uniform, const glm::vec3& t_value) const
+{
+    glUniform3f(t_uniform.location, t_value.x, t_value.y, t_value.z);
+}
+
+void mdcii::ogl::resource::ShaderProgram::SetUniform(const UniformHandle<glm::vec4> t_uniform, const glm::vec4& t_value) const
+{
+    glUniform4f(t_uniform.location, t_value.x, t_value.y, t_value.z, t_value.w);
+}
+
+void mdcii::ogl::resource::ShaderProgram::SetUniform(const UniformHandle<glm::mat4> t_uniform, const glm::mat4& t_value) const
+{
+    glUniformMatrix4fv(t_uniform.location, 1, GL_FALSE, value_ptr(t_value));
+}
+
+void mdcii::ogl::resource::ShaderProgram::SetUniform(const UniformHandle<glm::mat3> t_uniform, const glm::mat3& t_value) const
+{
+    glUniformMatrix3fv(t_uniform.location, 1, GL_FALSE, value_ptr(t_value));
+}
+
 void mdcii::ogl::resource::ShaderProgram::SetUniform(const std::string& t_uniformName, const int32_t t_value) const
 {
-    glUniform1i(m_uniforms.at(t_uniformName), t_value);
+    SetUniform(GetUniformHandle<int32_t>(t_uniformName), t_value);
 }
 
 void mdcii::ogl::resource::ShaderProgram::SetUniform(const std::string& t_uniformName, const float t_value) const
 {
-    glUniform1f(m_uniforms.at(t_uniformName), t_value);
+    SetUniform(GetUniformHandle<float>(t_uniformName), t_value);
 }
 
 void mdcii::ogl::resource::ShaderProgram::SetUniform(const std::string& t_uniformName, const bool t_value) const
 {
-    // if value == true load 1 else 0 as float
-    glUniform1f(m_uniforms.at(t_uniformName), t_value ? 1.0f : 0.0f);
+    SetUniform(GetUniformHandle<bool>(t_uniformName), t_value);
 }
 
 void mdcii::ogl::resource::ShaderProgram::SetUniform(const std::string& t_uniformName, const glm::vec2& t_value) const
 {
-    glUniform2f(m_uniforms.at(t_uniformName), t_value.x, t_value.y);
+    SetUniform(GetUniformHandle<glm::vec2>(t_uniformName), t_value);
 }
 
 void mdcii::ogl::resource::ShaderProgram::SetUniform(const std::string& t_uniformName, const glm::vec3& t_value) const
 {
-    glUniform3f(m_uniforms.at(t_uniformName), t_value.x, t_value.y, t_value.z);
+    SetUniform(GetUniformHandle<glm::vec3>(t_uniformName), t_value);
 }
 
 void mdcii::ogl::resource::ShaderProgram::SetUniform(const std::string& t_uniformName, const glm::vec4& t_value) const
 {
-    glUniform4f(m_uniforms.at(t_uniformName), t_value.x, t_value.y, t_value.z, t_value.w);
+    SetUniform(GetUniformHandle<glm::vec4>(t_uniformName), t_value);
 }
 
 void mdcii::ogl::resource::ShaderProgram::SetUniform(const std::string& t_uniformName, const glm::mat4& t_value) const
 {
-    glUniformMatrix4fv(m_uniforms.at(t_uniformName), 1, GL_FALSE, value_ptr(t_value));
+    SetUniform(GetUniformHandle<glm::mat4>(t_uniformName), t_value);
 }
 
 void mdcii::ogl::resource::ShaderProgram::SetUniform(const std::string& t_uniformName, const glm::mat3& t_value) const
 {
-    glUniformMatrix3fv(m_uniforms.at(t_uniformName), 1, GL_FALSE, value_ptr(t_value));
+    SetUniform(GetUniformHandle<glm::mat3>(t_uniformName), t_value);
 }
 
 void mdcii::ogl::resource::ShaderProgram::SetUniform(const std::string& t_uniformName, const std::vector<int32_t>& t_container) const
@@ -118,13 +203,46 @@ void mdcii::ogl::resource::ShaderProgram::SetUniform(const std::string& t_unifor
 
 void mdcii::ogl::resource::ShaderProgram::Init()
 {
+    const auto start{ std::chrono::steady_clock::now() };
+
     CreateId();
 
-    AddVertexShader(ResourceUtil::ReadShaderFile(m_path + "/Vertex.vert"));
-    AddFragmentShader(ResourceUtil::ReadShaderFile(m_path + "/Fragment.frag"));
+    const auto vertexShaderCode{ ResourceUtil::ReadShaderFile(m_path + "/Vertex.vert") };
+    const auto fragmentShaderCode{ ResourceUtil::ReadShaderFile(m_path + "/Fragment.frag") };
+
+    FindUniforms(vertexShaderCode);
+    FindUniforms(fragmentShaderCode);
+
+    const auto useCache{ UseBinaryCache() };
+    const auto key{ useCache ? ProgramBinaryCache::CreateKey(vertexShaderCode, fragmentShaderCode, GetDriver()) : 0 };
+    const auto fromCache{ useCache && LoadBinary(key) };
+
+    if (!fromCache)
+    {
+        AddVertexShader(vertexShaderCode);
+        AddFragmentShader(fragmentShaderCode);
+
+        if (useCache)
+        {
+            glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+
+        LinkAndValidateProgram();
+
+        if (useCache)
+        {
+            SaveBinary(key);
+        }
+    }
 
-    LinkAndValidateProgram();
     AddFoundUniforms();
+
+    Log::MDCII_LOG_INFO(
+        "[ShaderProgram::Init()] Shader program {} {} in {:.3f} ms.",
+        m_path,
+        fromCache ? "loaded from cache" : "compiled",
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+    );
 }
 
 //-------------------------------------------------
@@ -212,6 +330,12 @@ void mdcii::ogl::resource::ShaderProgram::FindUniforms(const std::string& t_shad
         const auto end{ t_shaderCode.find_first_of(';', begin) };
         const auto uniformLine{ t_shaderCode.substr(begin, end - begin) };
 
+        // a uniform block like "uniform frame { ... };"
+        if (uniformLine.find('{') != std::string::npos)
+        {
+            continue;
+        }
+
         const auto uniformNamePos{ uniformLine.find_first_of(' ') + 1 };
         auto uniformName{ uniformLine.substr(uniformNamePos, uniformLine.length()) };
         const auto uniformType{ uniformLine.substr(0, uniformNamePos - 1) };
@@ -250,8 +374,6 @@ uint32_t mdcii::ogl::resource::ShaderProgram::AddShader(const std::string& t_sha
     CheckCompileStatus(shaderId);
     glAttachShader(id, shaderId);
 
-    FindUniforms(t_shaderCode);
-
     return shaderId;
 }
 
@@ -322,6 +444,60 @@ void mdcii::ogl::resource::ShaderProgram::LinkAndValidateProgram() const
     }
 }
 
+//-------------------------------------------------
+// Binary cache
+//-------------------------------------------------
+
+std::string mdcii::ogl::resource::ShaderProgram::GetBinaryFilePath() const
+{
+    return Game::RESOURCES_REL_PATH + Game::INI.Get<std::string>("shader", "binary_cache_path") + ProgramBinaryCache::CreateFileName(m_path);
+}
+
+bool mdcii::ogl::resource::ShaderProgram::LoadBinary(const uint64_t t_key) const
+{
+    const auto binary{ ProgramBinaryCache::Load(GetBinaryFilePath(), t_key) };
+    if (!binary)
+    {
+        return false;
+    }
+
+    glProgramBinary(id, binary->format, binary->data.data(), static_cast<int32_t>(binary->data.size()));
+
+    // the driver may reject a binary even if the key matches, e.g. after an update with the same version string
+    auto isLinked{ GL_FALSE };
+    glGetProgramiv(id, GL_LINK_STATUS, &isLinked);
+    if (isLinked == GL_FALSE)
+    {
+        Log::MDCII_LOG_DEBUG("[ShaderProgram::LoadBinary()] The driver rejected the cached binary of {}.", m_path);
+        return false;
+    }
+
+    return true;
+}
+
+void mdcii::ogl::resource::ShaderProgram::SaveBinary(const uint64_t t_key) const
+{
+    auto length{ 0 };
+    glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    ProgramBinary binary;
+    binary.data.resize(length);
+
+    GLenum format{ 0 };
+    glGetProgramBinary(id, length, &length, &format, binary.data.data());
+    binary.format = format;
+    binary.data.resize(length);
+
+    if (ProgramBinaryCache::Save(GetBinaryFilePath(), t_key, binary))
+    {
+        Log::MDCII_LOG_DEBUG("[ShaderProgram::SaveBinary()] The binary of {} with {} bytes was cached.", m_path, length);
+    }
+}
+
 //-------------------------------------------------
 // Uniforms
 //-------------------------------------------------
@@ -359,6 +535,7 @@ void mdcii::ogl::resource::ShaderProgram::CleanUp() const
 
     if (id)
     {
+        Device::Get().ForgetProgram(id);
         glDeleteProgram(id);
         Log::MDCII_LOG_DEBUG("[ShaderProgram::CleanUp()] Shader Program Id {} was deleted.", id);
     }
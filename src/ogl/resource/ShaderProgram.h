@@ -29,6 +29,23 @@
 
 namespace mdcii::ogl::resource
 {
+    //-------------------------------------------------
+    // UniformHandle
+    //-------------------------------------------------
+
+    /**
+     * The resolved location of a uniform. The type selects the matching SetUniform overload.
+     */
+    template<typename T>
+    struct UniformHandle
+    {
+        int32_t location{ -1 };
+    };
+
+    //-------------------------------------------------
+    // ShaderProgram
+    //-------------------------------------------------
+
     /**
      * Creates and represents a shader program with a vertex and a fragment shader.
      */
@@ -78,10 +95,37 @@ namespace mdcii::ogl::resource
          */
         static void Unbind();
 
+        //-------------------------------------------------
+        // Uniform handles
+        //-------------------------------------------------
+
+        /**
+         * Resolves the location of a uniform once, so that a draw call
+         * doesn't need to look up the uniform by its name.
+         *
+         * @param t_uniformName The name of the uniform.
+         *
+         * @return The handle of the uniform.
+         */
+        template<typename T>
+        [[nodiscard]] UniformHandle<T> GetUniformHandle(const std::string& t_uniformName) const
+        {
+            return { m_uniforms.at(t_uniformName) };
+        }
+
         //-------------------------------------------------
         // Set uniforms
         //-------------------------------------------------
 
+        void SetUniform(UniformHandle<int32_t> t_uniform, int32_t t_value) const;
+        void SetUniform(UniformHandle<float> t_uniform, float t_value) const;
+        void SetUniform(UniformHandle<bool> t_uniform, bool t_value) const;
+        void SetUniform(UniformHandle<glm::vec2> t_uniform, const glm::vec2& t_value) const;
+        void SetUniform(UniformHandle<glm::vec3> t_uniform, const glm::vec3& t_value) const;
+        void SetUniform(UniformHandle<glm::vec4> t_uniform, const glm::vec4& t_value) const;
+        void SetUniform(UniformHandle<glm::mat4> t_uniform, const glm::mat4& t_value) const;
+        void SetUniform(UniformHandle<glm::mat3> t_uniform, const glm::mat3& t_value) const;
+
         void SetUniform(const std::string& t_uniformName, int32_t t_value) const;
         void SetUniform(const std::string& t_uniformName, float t_value) const;
         void SetUniform(const std::string& t_uniformName, bool t_value) const;
@@ -150,6 +194,7 @@ namespace mdcii::ogl::resource
 
         /**
          * Generates the shader program.
+         * If possible, the program is loaded from the binary cache.
          */
         void Init();
 
@@ -210,6 +255,7 @@ namespace mdcii::ogl::resource
 
         /**
          * Stores all uniforms in m_foundUniforms.
+         * Uniform blocks are skipped, they are bound by their binding point.
          *
          * @param t_shaderCode The shader code.
          */
@@ -235,6 +281,33 @@ namespace mdcii::ogl::resource
          */
         void LinkAndValidateProgram() const;
 
+        //-------------------------------------------------
+        // Binary cache
+        //-------------------------------------------------
+
+        /**
+         * Gets the path of the cached binary of this program.
+         *
+         * @return The path of the cache file.
+         */
+        [[nodiscard]] std::string GetBinaryFilePath() const;
+
+        /**
+         * Loads the program from a cached binary instead of compiling the shaders.
+         *
+         * @param t_key The key of the current sources and driver.
+         *
+         * @return False if there is no valid binary, the shaders must be compiled then.
+         */
+        bool LoadBinary(uint64_t t_key) const;
+
+        /**
+         * Stores the binary of the linked program.
+         *
+         * @param t_key The key of the current sources and driver.
+         */
+        void SaveBinary(uint64_t t_key) const;
+
         //-------------------------------------------------
         // Uniforms
         //-------------------------------------------------
@@ -21,6 +21,7 @@
 #include "MdciiAssert.h"
 #include "MdciiException.h"
 #include "ogl/OpenGL.h"
+#include "ogl/Device.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -58,19 +59,19 @@ mdcii::ogl::resource::Texture::~Texture() noexcept
 
 void mdcii::ogl::resource::Texture::Bind() const
 {
-    glBindTexture(GL_TEXTURE_2D, id);
+    Device::Get().BindTexture(GL_TEXTURE_2D, id);
 }
 
 void mdcii::ogl::resource::Texture::Unbind()
 {
-    glBindTexture(GL_TEXTURE_2D, 0);
+    Device::Get().BindTexture(GL_TEXTURE_2D, 0);
 }
 
 void mdcii::ogl::resource::Texture::BindForReading(const uint32_t t_textureUnit) const
 {
     // make sure that the OpenGL constants are used here
     MDCII_ASSERT(t_textureUnit >= GL_TEXTURE0 && t_textureUnit <= GL_TEXTURE15, "[Texture::BindForReading()] Invalid texture unit value.")
-    glActiveTexture(t_textureUnit);
+    Device::Get().ActiveTexture(t_textureUnit);
     Bind();
 }
 
@@ -134,6 +135,7 @@ void mdcii::ogl::resource::Texture::CleanUp() const
 
     if (id)
     {
+        Device::Get().ForgetTexture(id);
         glDeleteTextures(1, &id);
         Log::MDCII_LOG_DEBUG("[Texture::CleanUp()] Texture Id {} was deleted.", id);
     }
@@ -19,6 +19,7 @@
 #include "TextureUtils.h"
 #include "MdciiAssert.h"
 #include "ogl/OpenGL.h"
+#include "ogl/Device.h"
 
 //-------------------------------------------------
 // Generate && delete
@@ -38,6 +39,7 @@ void mdcii::ogl::resource::TextureUtils::DeleteTexture(const uint32_t t_textureI
 {
     if (t_textureId)
     {
+        Device::Get().ForgetTexture(t_textureId);
         glDeleteTextures(1, &t_textureId);
     }
 }
@@ -117,7 +119,7 @@ void mdcii::ogl::resource::TextureUtils::Bind(const uint32_t t_textureId, const
     // make sure that the OpenGL constants are used here
     MDCII_ASSERT(t_target == GL_TEXTURE_2D || t_target == GL_TEXTURE_3D || t_target == GL_TEXTURE_CUBE_MAP || t_target == GL_TEXTURE_2D_ARRAY, "[TextureUtils::Bind()] Invalid texture target.")
 
-    glBindTexture(t_target, t_textureId);
+    Device::Get().BindTexture(t_target, t_textureId);
 }
 
 void mdcii::ogl::resource::TextureUtils::Bind(const uint32_t t_textureId)
@@ -130,7 +132,7 @@ void mdcii::ogl::resource::TextureUtils::Unbind(const uint32_t t_target)
     // make sure that the OpenGL constants are used here
     MDCII_ASSERT(t_target == GL_TEXTURE_2D || t_target == GL_TEXTURE_3D || t_target == GL_TEXTURE_CUBE_MAP || t_target == GL_TEXTURE_2D_ARRAY, "[TextureUtils::Unbind()] Invalid texture target.")
 
-    glBindTexture(t_target, 0);
+    Device::Get().BindTexture(t_target, 0);
 }
 
 void mdcii::ogl::resource::TextureUtils::Unbind()
@@ -143,7 +145,7 @@ void mdcii::ogl::resource::TextureUtils::BindForReading(const uint32_t t_texture
     // make sure that the OpenGL constants are used here
     MDCII_ASSERT(t_textureUnit >= GL_TEXTURE0 && t_textureUnit <= GL_TEXTURE15, "[TextureUtils::BindForReading()] Invalid texture unit value.")
 
-    glActiveTexture(t_textureUnit);
+    Device::Get().ActiveTexture(t_textureUnit);
     Bind(t_textureId, t_target);
 }
 
@@ -0,0 +1,238 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "Aabb.h"
+
+namespace mdcii::physics
+{
+    //-------------------------------------------------
+    // Overlap
+    //-------------------------------------------------
+
+    /**
+     * Checks whether two Aabbs are closer than a given margin.
+     *
+     * @param t_a The first Aabb.
+     * @param t_b The second Aabb.
+     * @param t_margin The required distance between the Aabbs.
+     *
+     * @return True if the Aabbs overlap or are too close.
+     */
+    inline bool aabb_vs_aabb_with_margin(const Aabb& t_a, const Aabb& t_b, const int32_t t_margin)
+    {
+        return
+            t_a.position.x < t_b.position.x + t_b.size.x + t_margin &&
+            t_b.position.x < t_a.position.x + t_a.size.x + t_margin &&
+            t_a.position.y < t_b.position.y + t_b.size.y + t_margin &&
+            t_b.position.y < t_a.position.y + t_a.size.y + t_margin;
+    }
+
+    //-------------------------------------------------
+    // Sweep and prune
+    //-------------------------------------------------
+
+    /**
+     * Checks a set of Aabbs for overlaps with sweep and prune.
+     * The Aabbs are sorted along the x axis, so that only Aabbs
+     * with overlapping x intervals are tested, each pair once.
+     *
+     * @param t_aabbs The Aabbs to be checked.
+     * @param t_margin The required distance between the Aabbs.
+     *
+     * @return True if at least two Aabbs overlap or are too close.
+     */
+    inline bool has_overlap(const std::vector<Aabb>& t_aabbs, const int32_t t_margin = 0)
+    {
+        std::vector<size_t> order(t_aabbs.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&t_aabbs](const size_t t_a, const size_t t_b) {
+            return t_aabbs[t_a].position.x < t_aabbs[t_b].position.x;
+        });
+
+        std::vector<size_t> active;
+        for (const auto i : order)
+        {
+            const auto& aabb{ t_aabbs[i] };
+
+            // Aabbs that end before the current one starts can't overlap any following
+            active.erase(std::remove_if(active.begin(), active.end(), [&](const size_t t_j) {
+                return t_aabbs[t_j].position.x + t_aabbs[t_j].size.x + t_margin <= aabb.position.x;
+            }), active.end());
+
+            for (const auto j : active)
+            {
+                if (aabb_vs_aabb_with_margin(aabb, t_aabbs[j], t_margin))
+                {
+                    return true;
+                }
+            }
+
+            active.push_back(i);
+        }
+
+        return false;
+    }
+
+    //-------------------------------------------------
+    // UniformGrid
+    //-------------------------------------------------
+
+    /**
+     * A uniform grid to find Aabbs near a position without testing all Aabbs.
+     */
+    class UniformGrid
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        UniformGrid() = delete;
+
+        /**
+         * Constructs a new UniformGrid object.
+         *
+         * @param t_width The width of the area.
+         * @param t_height The height of the area.
+         * @param t_cellSize The width and height of a cell.
+         */
+        UniformGrid(const int32_t t_width, const int32_t t_height, const int32_t t_cellSize)
+            : m_cellSize{ std::max(t_cellSize, 1) }
+            , m_cellsX{ std::max(t_width, 1) / m_cellSize + 1 }
+            , m_cellsY{ std::max(t_height, 1) / m_cellSize + 1 }
+            , m_cells(static_cast<size_t>(m_cellsX) * m_cellsY)
+        {}
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Adds an Aabb to all cells it covers.
+         *
+         * @param t_aabb The Aabb to add.
+         */
+        void Insert(const Aabb& t_aabb)
+        {
+            const auto index{ m_aabbs.size() };
+            m_aabbs.push_back(t_aabb);
+
+            const auto [startX, startY, endX, endY]{ GetCellRange(t_aabb, 0) };
+            for (auto y{ startY }; y <= endY; ++y)
+            {
+                for (auto x{ startX }; x <= endX; ++x)
+                {
+                    m_cells[static_cast<size_t>(y) * m_cellsX + x].push_back(index);
+                }
+            }
+        }
+
+        /**
+         * Checks whether an Aabb overlaps or is too close to an inserted Aabb.
+         *
+         * @param t_aabb The Aabb to be checked.
+         * @param t_margin The required distance between the Aabbs.
+         *
+         * @return True or false.
+         */
+        [[nodiscard]] bool Overlaps(const Aabb& t_aabb, const int32_t t_margin = 0) const
+        {
+            const auto [startX, startY, endX, endY]{ GetCellRange(t_aabb, t_margin) };
+            for (auto y{ startY }; y <= endY; ++y)
+            {
+                for (auto x{ startX }; x <= endX; ++x)
+                {
+                    for (const auto index : m_cells[static_cast<size_t>(y) * m_cellsX + x])
+                    {
+                        if (aabb_vs_aabb_with_margin(t_aabb, m_aabbs[index], t_margin))
+                        {
+                            return true;
+                        }
+                    }
+                }
+            }
+
+            return false;
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The width and height of a cell.
+         */
+        int32_t m_cellSize;
+
+        /**
+         * The number of cells in x direction.
+         */
+        int32_t m_cellsX;
+
+        /**
+         * The number of cells in y direction.
+         */
+        int32_t m_cellsY;
+
+        /**
+         * The indices of the Aabbs in each cell.
+         */
+        std::vector<std::vector<size_t>> m_cells;
+
+        /**
+         * The inserted Aabbs.
+         */
+        std::vector<Aabb> m_aabbs;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Gets the first and last cell covered by an Aabb enlarged by a margin.
+         *
+         * @param t_aabb The Aabb.
+         * @param t_margin The margin around the Aabb.
+         *
+         * @return The first x, first y, last x and last y cell.
+         */
+        [[nodiscard]] std::array<int32_t, 4> GetCellRange(const Aabb& t_aabb, const int32_t t_margin) const
+        {
+            const auto toCell{ [this](const int32_t t_value, const int32_t t_nrOfCells) {
+                return std::clamp(t_value / m_cellSize, 0, t_nrOfCells - 1);
+            } };
+
+            return {
+                toCell(t_aabb.position.x - t_margin, m_cellsX),
+                toCell(t_aabb.position.y - t_margin, m_cellsY),
+                toCell(t_aabb.position.x + t_aabb.size.x + t_margin - 1, m_cellsX),
+                toCell(t_aabb.position.y + t_aabb.size.y + t_margin - 1, m_cellsY)
+            };
+        }
+    };
+}
@@ -0,0 +1,97 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+//-------------------------------------------------
+// FrameStatistics
+//-------------------------------------------------
+
+namespace mdcii::profiler
+{
+    /**
+     * Summarizes a series of frame times.
+     */
+    struct FrameStatistics
+    {
+        int32_t count{ 0 };
+        double total{ 0.0 };
+        double min{ 0.0 };
+        double max{ 0.0 };
+        double mean{ 0.0 };
+        double median{ 0.0 };
+        double p95{ 0.0 };
+        double p99{ 0.0 };
+    };
+
+    /**
+     * Get the value below which the given percentage of the sorted times lie (nearest rank).
+     *
+     * @param t_sortedTimes The times in ascending order.
+     * @param t_percent The percentage from 0 to 100.
+     *
+     * @return The percentile.
+     */
+    inline double percentile(const std::vector<double>& t_sortedTimes, const double t_percent)
+    {
+        if (t_sortedTimes.empty())
+        {
+            return 0.0;
+        }
+
+        const auto rank{ static_cast<size_t>(std::ceil(t_percent / 100.0 * static_cast<double>(t_sortedTimes.size()))) };
+
+        return t_sortedTimes[std::clamp<size_t>(rank, 1, t_sortedTimes.size()) - 1];
+    }
+
+    /**
+     * Calculates the statistics of a series of frame times.
+     *
+     * @param t_times The frame times in any unit.
+     *
+     * @return The FrameStatistics object in the unit of the times.
+     */
+    inline FrameStatistics calc_frame_statistics(std::vector<double> t_times)
+    {
+        FrameStatistics statistics;
+        if (t_times.empty())
+        {
+            return statistics;
+        }
+
+        std::sort(t_times.begin(), t_times.end());
+
+        statistics.count = static_cast<int32_t>(t_times.size());
+        statistics.total = std::accumulate(t_times.begin(), t_times.end(), 0.0);
+        statistics.min = t_times.front();
+        statistics.max = t_times.back();
+        statistics.mean = statistics.total / static_cast<double>(t_times.size());
+        statistics.median = percentile(t_times, 50.0);
+        statistics.p95 = percentile(t_times, 95.0);
+        statistics.p99 = percentile(t_times, 99.0);
+
+        return statistics;
+    }
+}
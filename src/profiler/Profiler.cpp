@@ -0,0 +1,313 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#include <imgui.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include "Profiler.h"
+#include "Log.h"
+#include "ogl/OpenGL.h"
+#include "data/json.hpp"
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+namespace
+{
+    const auto PROFILER_START{ std::chrono::steady_clock::now() };
+
+    uint32_t CurrentThreadId()
+    {
+        return static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()) & 0xFFFF);
+    }
+}
+
+//-------------------------------------------------
+// Frame
+//-------------------------------------------------
+
+void mdcii::profiler::Profiler::BeginFrame()
+{
+    std::lock_guard lock{ m_mutex };
+
+    m_currentFrame.cpuSamples.clear();
+    m_currentFrame.gpuSamples.clear();
+    m_currentFrame.start = Now();
+    m_currentFrame.duration = 0;
+}
+
+void mdcii::profiler::Profiler::EndFrame()
+{
+    // read the queries issued in the previous frame
+    const auto readIndex{ (m_frameIndex + 1) % 2 };
+    for (auto& [name, timer] : m_gpuTimers)
+    {
+        if (!timer.issued[readIndex])
+        {
+            continue;
+        }
+
+        GLint available{ 0 };
+        glGetQueryObjectiv(timer.queries[readIndex], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available)
+        {
+            GLuint64 elapsed{ 0 };
+            glGetQueryObjectui64v(timer.queries[readIndex], GL_QUERY_RESULT, &elapsed);
+            timer.milliseconds = static_cast<double>(elapsed) / 1.0e6;
+            timer.issued[readIndex] = false;
+        }
+    }
+
+    std::lock_guard lock{ m_mutex };
+
+    for (const auto& [name, timer] : m_gpuTimers)
+    {
+        m_currentFrame.gpuSamples.push_back({ name, timer.milliseconds });
+    }
+
+    m_currentFrame.duration = Now() - m_currentFrame.start;
+    m_lastFrame = m_currentFrame;
+
+    m_recordedFrames.push_back(m_currentFrame);
+    if (m_recordedFrames.size() > static_cast<size_t>(MAX_RECORDED_FRAMES))
+    {
+        m_recordedFrames.pop_front();
+    }
+
+    m_frameIndex++;
+}
+
+//-------------------------------------------------
+// Cpu
+//-------------------------------------------------
+
+int64_t mdcii::profiler::Profiler::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - PROFILER_START).count();
+}
+
+int32_t& mdcii::profiler::Profiler::GetDepth()
+{
+    thread_local int32_t depth{ 0 };
+    return depth;
+}
+
+void mdcii::profiler::Profiler::AddCpuSample(const CpuSample& t_sample)
+{
+    thread_local const auto threadId{ CurrentThreadId() };
+
+    std::lock_guard lock{ m_mutex };
+
+    auto& sample{ m_currentFrame.cpuSamples.emplace_back(t_sample) };
+    sample.threadId = threadId;
+}
+
+//-------------------------------------------------
+// Gpu
+//-------------------------------------------------
+
+bool mdcii::profiler::Profiler::BeginGpuPass(const std::string_view t_name)
+{
+    if (m_gpuPassActive)
+    {
+        return false;
+    }
+
+    auto& timer{ m_gpuTimers[t_name] };
+    if (timer.queries[0] == 0)
+    {
+        glGenQueries(2, timer.queries.data());
+    }
+
+    const auto writeIndex{ m_frameIndex % 2 };
+    if (timer.issued[writeIndex])
+    {
+        // the result of two frames ago was never read; skip this frame instead of stalling
+        return false;
+    }
+
+    glBeginQuery(GL_TIME_ELAPSED, timer.queries[writeIndex]);
+    timer.issued[writeIndex] = true;
+    m_gpuPassActive = true;
+
+    return true;
+}
+
+void mdcii::profiler::Profiler::EndGpuPass()
+{
+    glEndQuery(GL_TIME_ELAPSED);
+    m_gpuPassActive = false;
+}
+
+void mdcii::profiler::Profiler::CleanUp()
+{
+    Log::MDCII_LOG_DEBUG("[Profiler::CleanUp()] CleanUp profiler.");
+
+    for (auto& [name, timer] : m_gpuTimers)
+    {
+        glDeleteQueries(2, timer.queries.data());
+    }
+
+    m_gpuTimers.clear();
+}
+
+//-------------------------------------------------
+// Export
+//-------------------------------------------------
+
+bool mdcii::profiler::Profiler::ExportChromeTrace(const std::string& t_filePath)
+{
+    Log::MDCII_LOG_DEBUG("[Profiler::ExportChromeTrace()] Export {} frames to {}.", m_recordedFrames.size(), t_filePath);
+
+    auto events{ nlohmann::json::array() };
+
+    {
+        std::lock_guard lock{ m_mutex };
+
+        for (const auto& frame : m_recordedFrames)
+        {
+            events.push_back({
+                { "name", "Frame" },
+                { "ph", "X" },
+                { "ts", static_cast<double>(frame.start) / 1.0e3 },
+                { "dur", static_cast<double>(frame.duration) / 1.0e3 },
+                { "pid", 0 },
+                { "tid", 0 },
+            });
+
+            for (const auto& sample : frame.cpuSamples)
+            {
+                events.push_back({
+                    { "name", std::string(sample.name) },
+                    { "ph", "X" },
+                    { "ts", static_cast<double>(sample.start) / 1.0e3 },
+                    { "dur", static_cast<double>(sample.duration) / 1.0e3 },
+                    { "pid", 0 },
+                    { "tid", sample.threadId },
+                });
+            }
+
+            for (const auto& sample : frame.gpuSamples)
+            {
+                events.push_back({
+                    { "name", "GPU " + std::string(sample.name) },
+                    { "ph", "C" },
+                    { "ts", static_cast<double>(frame.start) / 1.0e3 },
+                    { "pid", 0 },
+                    { "args", { { "ms", sample.milliseconds } } },
+                });
+            }
+        }
+    }
+
+    std::ofstream file{ t_filePath };
+    if (!file)
+    {
+        Log::MDCII_LOG_WARN("[Profiler::ExportChromeTrace()] Unable to open file {}.", t_filePath);
+        return false;
+    }
+
+    file << nlohmann::json{ { "traceEvents", events }, { "displayTimeUnit", "ms" } };
+
+    return true;
+}
+
+//-------------------------------------------------
+// ImGui
+//-------------------------------------------------
+
+void mdcii::profiler::Profiler::RenderImGui()
+{
+    static constexpr auto ROW_HEIGHT{ 18.0f };
+
+    Frame frame;
+    {
+        std::lock_guard lock{ m_mutex };
+        frame = m_lastFrame;
+    }
+
+    ImGui::Begin("Profiler");
+
+    ImGui::Text("Frame: %.3f ms", static_cast<double>(frame.duration) / 1.0e6);
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome trace"))
+    {
+        ExportChromeTrace("mdcii_trace.json");
+    }
+
+    if (ImGui::CollapsingHeader("Gpu passes", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        for (const auto& sample : frame.gpuSamples)
+        {
+            ImGui::Text("%.*s: %.3f ms", static_cast<int>(sample.name.size()), sample.name.data(), sample.milliseconds);
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Cpu timeline", ImGuiTreeNodeFlags_DefaultOpen) && frame.duration > 0)
+    {
+        auto maxDepth{ 0 };
+        for (const auto& sample : frame.cpuSamples)
+        {
+            maxDepth = std::max(maxDepth, sample.depth);
+        }
+
+        const auto origin{ ImGui::GetCursorScreenPos() };
+        const auto width{ std::max(ImGui::GetContentRegionAvail().x, 100.0f) };
+        const auto height{ static_cast<float>(maxDepth + 1) * ROW_HEIGHT };
+        const auto scale{ width / static_cast<float>(frame.duration) };
+        auto* drawList{ ImGui::GetWindowDrawList() };
+        const auto mouse{ ImGui::GetIO().MousePos };
+
+        ImGui::InvisibleButton("##timeline", ImVec2(width, height));
+
+        for (const auto& sample : frame.cpuSamples)
+        {
+            const ImVec2 min{
+                origin.x + static_cast<float>(sample.start - frame.start) * scale,
+                origin.y + static_cast<float>(sample.depth) * ROW_HEIGHT
+            };
+            const ImVec2 max{
+                std::max(min.x + 1.0f, min.x + static_cast<float>(sample.duration) * scale),
+                min.y + ROW_HEIGHT - 1.0f
+            };
+
+            const auto hash{ static_cast<uint32_t>(std::hash<std::string_view>{}(sample.name)) };
+            const auto color{ IM_COL32(80 + (hash & 0x7F), 80 + ((hash >> 8) & 0x7F), 80 + ((hash >> 16) & 0x7F), 255) };
+
+            drawList->AddRectFilled(min, max, color);
+            if (max.x - min.x > 40.0f)
+            {
+                drawList->PushClipRect(min, max, true);
+                drawList->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32_WHITE, sample.name.data(), sample.name.data() + sample.name.size());
+                drawList->PopClipRect();
+            }
+
+            if (ImGui::IsItemHovered() && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+            {
+                ImGui::SetTooltip("%.*s: %.3f ms", static_cast<int>(sample.name.size()), sample.name.data(), static_cast<double>(sample.duration) / 1.0e6);
+            }
+        }
+    }
+
+    ImGui::End();
+}
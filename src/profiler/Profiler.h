@@ -0,0 +1,319 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+//-------------------------------------------------
+// Macros
+//-------------------------------------------------
+
+#ifdef MDCII_PROFILING
+    #define MDCII_PROFILE_CONCAT_INNER(a, b) a##b
+    #define MDCII_PROFILE_CONCAT(a, b) MDCII_PROFILE_CONCAT_INNER(a, b)
+    #define MDCII_PROFILE_SCOPE(name) const mdcii::profiler::CpuScope MDCII_PROFILE_CONCAT(mdciiCpuScope, __LINE__){ name };
+    #define MDCII_PROFILE_GPU_SCOPE(name) const mdcii::profiler::GpuScope MDCII_PROFILE_CONCAT(mdciiGpuScope, __LINE__){ name };
+    #define MDCII_PROFILE_BEGIN_FRAME mdcii::profiler::Profiler::BeginFrame();
+    #define MDCII_PROFILE_END_FRAME mdcii::profiler::Profiler::EndFrame();
+#else
+    #define MDCII_PROFILE_SCOPE(name)
+    #define MDCII_PROFILE_GPU_SCOPE(name)
+    #define MDCII_PROFILE_BEGIN_FRAME
+    #define MDCII_PROFILE_END_FRAME
+#endif
+
+//-------------------------------------------------
+// Profiler
+//-------------------------------------------------
+
+namespace mdcii::profiler
+{
+    //-------------------------------------------------
+    // Samples
+    //-------------------------------------------------
+
+    /**
+     * A measured Cpu scope.
+     * The name must outlive the profiler, so only string literals or static names are used.
+     */
+    struct CpuSample
+    {
+        std::string_view name;
+        int32_t depth{ 0 };
+        uint32_t threadId{ 0 };
+        int64_t start{ 0 };
+        int64_t duration{ 0 };
+    };
+
+    /**
+     * The Gpu time of a render pass.
+     */
+    struct GpuSample
+    {
+        std::string_view name;
+        double milliseconds{ 0.0 };
+    };
+
+    /**
+     * All samples of a frame. The times are in nanoseconds since the profiler was started.
+     */
+    struct Frame
+    {
+        int64_t start{ 0 };
+        int64_t duration{ 0 };
+        std::vector<CpuSample> cpuSamples;
+        std::vector<GpuSample> gpuSamples;
+    };
+
+    //-------------------------------------------------
+    // Profiler
+    //-------------------------------------------------
+
+    /**
+     * Collects Cpu scopes and Gpu timer queries for each frame.
+     * The scopes are added with the MDCII_PROFILE_* macros, which are empty without MDCII_PROFILING.
+     */
+    class Profiler
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The number of frames kept for the Chrome trace export.
+         */
+        static constexpr auto MAX_RECORDED_FRAMES{ 600 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Profiler(const Profiler& t_other) = delete;
+        Profiler(Profiler&& t_other) noexcept = delete;
+        Profiler& operator=(const Profiler& t_other) = delete;
+        Profiler& operator=(Profiler&& t_other) noexcept = delete;
+
+        //-------------------------------------------------
+        // Frame
+        //-------------------------------------------------
+
+        /**
+         * Starts a new frame.
+         */
+        static void BeginFrame();
+
+        /**
+         * Finishes the current frame and keeps it for the ImGui panel and the export.
+         */
+        static void EndFrame();
+
+        //-------------------------------------------------
+        // Cpu
+        //-------------------------------------------------
+
+        /**
+         * Get the time since the profiler was started.
+         *
+         * @return The time in nanoseconds.
+         */
+        [[nodiscard]] static int64_t Now();
+
+        /**
+         * Get the nesting depth of Cpu scopes of the calling thread.
+         *
+         * @return A reference to the depth.
+         */
+        [[nodiscard]] static int32_t& GetDepth();
+
+        /**
+         * Adds a finished Cpu scope to the current frame. Can be called from any thread.
+         *
+         * @param t_sample The CpuSample object.
+         */
+        static void AddCpuSample(const CpuSample& t_sample);
+
+        //-------------------------------------------------
+        // Gpu
+        //-------------------------------------------------
+
+        /**
+         * Starts a GL_TIME_ELAPSED query for a render pass.
+         * Only one query can be active, so nested passes are ignored.
+         * Must be called from the main thread.
+         *
+         * @param t_name The name of the pass.
+         *
+         * @return True if the query was started.
+         */
+        static bool BeginGpuPass(std::string_view t_name);
+
+        /**
+         * Ends the active GL_TIME_ELAPSED query.
+         */
+        static void EndGpuPass();
+
+        /**
+         * Deletes the query objects. Must be called while the OpenGL context exists.
+         */
+        static void CleanUp();
+
+        //-------------------------------------------------
+        // Export
+        //-------------------------------------------------
+
+        /**
+         * Writes the recorded frames in the Chrome trace event format.
+         * The file can be opened with chrome://tracing or Perfetto.
+         *
+         * @param t_filePath The path of the Json file.
+         *
+         * @return False if the file could not be written.
+         */
+        static bool ExportChromeTrace(const std::string& t_filePath);
+
+        //-------------------------------------------------
+        // ImGui
+        //-------------------------------------------------
+
+        /**
+         * Renders the last frame as a timeline and the Gpu passes.
+         */
+        static void RenderImGui();
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        /**
+         * Two queries for each pass, so that the result of the previous frame can be read without waiting.
+         */
+        struct GpuTimer
+        {
+            std::array<uint32_t, 2> queries{ 0, 0 };
+            std::array<bool, 2> issued{ false, false };
+            double milliseconds{ 0.0 };
+        };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        inline static std::mutex m_mutex;
+
+        inline static Frame m_currentFrame;
+
+        inline static Frame m_lastFrame;
+
+        inline static std::deque<Frame> m_recordedFrames;
+
+        inline static std::unordered_map<std::string_view, GpuTimer> m_gpuTimers;
+
+        inline static uint64_t m_frameIndex{ 0 };
+
+        inline static bool m_gpuPassActive{ false };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Profiler() = default;
+        ~Profiler() noexcept = default;
+    };
+
+    //-------------------------------------------------
+    // Scopes
+    //-------------------------------------------------
+
+    /**
+     * Measures the Cpu time until the end of the scope.
+     */
+    class CpuScope
+    {
+    public:
+        CpuScope() = delete;
+
+        explicit CpuScope(const std::string_view t_name)
+            : m_name{ t_name }
+            , m_depth{ Profiler::GetDepth()++ }
+            , m_start{ Profiler::Now() }
+        {
+        }
+
+        CpuScope(const CpuScope& t_other) = delete;
+        CpuScope(CpuScope&& t_other) noexcept = delete;
+        CpuScope& operator=(const CpuScope& t_other) = delete;
+        CpuScope& operator=(CpuScope&& t_other) noexcept = delete;
+
+        ~CpuScope() noexcept
+        {
+            Profiler::GetDepth()--;
+            Profiler::AddCpuSample({ m_name, m_depth, 0, m_start, Profiler::Now() - m_start });
+        }
+
+    protected:
+
+    private:
+        std::string_view m_name;
+        int32_t m_depth{ 0 };
+        int64_t m_start{ 0 };
+    };
+
+    /**
+     * Measures the Gpu time of the OpenGL commands until the end of the scope.
+     */
+    class GpuScope
+    {
+    public:
+        GpuScope() = delete;
+
+        explicit GpuScope(const std::string_view t_name)
+            : m_active{ Profiler::BeginGpuPass(t_name) }
+        {
+        }
+
+        GpuScope(const GpuScope& t_other) = delete;
+        GpuScope(GpuScope&& t_other) noexcept = delete;
+        GpuScope& operator=(const GpuScope& t_other) = delete;
+        GpuScope& operator=(GpuScope&& t_other) noexcept = delete;
+
+        ~GpuScope() noexcept
+        {
+            if (m_active)
+            {
+                Profiler::EndGpuPass();
+            }
+        }
+
+    protected:
+
+    private:
+        bool m_active{ false };
+    };
+}
@@ -0,0 +1,60 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#include <cstring>
+#include "FrameUniforms.h"
+#include "Log.h"
+#include "ogl/buffer/Ubo.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+mdcii::renderer::FrameUniforms::FrameUniforms()
+{
+    Log::MDCII_LOG_DEBUG("[FrameUniforms::FrameUniforms()] Create FrameUniforms.");
+
+    m_ubo = std::make_unique<ogl::buffer::Ubo>("FrameUniforms");
+    m_ubo->Bind();
+    ogl::buffer::Ubo::StoreData(sizeof(FrameData), nullptr);
+}
+
+mdcii::renderer::FrameUniforms::~FrameUniforms() noexcept
+{
+    Log::MDCII_LOG_DEBUG("[FrameUniforms::~FrameUniforms()] Destruct FrameUniforms.");
+}
+
+//-------------------------------------------------
+// Upload
+//-------------------------------------------------
+
+void mdcii::renderer::FrameUniforms::Upload()
+{
+    // a still camera and paused animations need no upload
+    if (!m_uploaded || std::memcmp(&data, &m_uploadedData, sizeof(FrameData)) != 0)
+    {
+        m_ubo->Bind();
+        ogl::buffer::Ubo::StoreSubData(0, sizeof(FrameData), &data);
+
+        m_uploadedData = data;
+        m_uploaded = true;
+    }
+
+    m_ubo->BindBase(FRAME_BINDING);
+}
@@ -0,0 +1,146 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <glm/glm.hpp>
+
+//-------------------------------------------------
+// Forward declarations
+//-------------------------------------------------
+
+namespace mdcii::ogl::buffer
+{
+    /**
+     * Forward declaration class Ubo.
+     */
+    class Ubo;
+}
+
+//-------------------------------------------------
+// FrameUniforms
+//-------------------------------------------------
+
+namespace mdcii::renderer
+{
+    //-------------------------------------------------
+    // FrameData
+    //-------------------------------------------------
+
+    /**
+     * The std140 layout of the "frame" block in the world, water and grid shaders.
+     */
+    struct FrameData
+    {
+        glm::mat4 projectionView{ 1.0f };
+
+        /**
+         * The animation counters. std140 pads each int of an array to 16 bytes, only x is used.
+         */
+        std::array<glm::ivec4, 5> updates{};
+
+        int32_t worldRotation{ 0 };
+        float maxY{ 0.0f };
+        float nrOfRows{ 0.0f };
+        float padding{ 0.0f };
+    };
+
+    static_assert(offsetof(FrameData, updates) == 64);
+    static_assert(offsetof(FrameData, worldRotation) == 144);
+    static_assert(offsetof(FrameData, maxY) == 148);
+    static_assert(offsetof(FrameData, nrOfRows) == 152);
+    static_assert(sizeof(FrameData) == 160);
+
+    //-------------------------------------------------
+    // FrameUniforms
+    //-------------------------------------------------
+
+    /**
+     * Holds the values which are the same for all draws of a frame in a Ubo.
+     */
+    class FrameUniforms
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The binding point of the "frame" block.
+         */
+        static constexpr uint32_t FRAME_BINDING{ 0 };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The values of the current frame.
+         */
+        FrameData data;
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        FrameUniforms();
+
+        FrameUniforms(const FrameUniforms& t_other) = delete;
+        FrameUniforms(FrameUniforms&& t_other) noexcept = delete;
+        FrameUniforms& operator=(const FrameUniforms& t_other) = delete;
+        FrameUniforms& operator=(FrameUniforms&& t_other) noexcept = delete;
+
+        ~FrameUniforms() noexcept;
+
+        //-------------------------------------------------
+        // Upload
+        //-------------------------------------------------
+
+        /**
+         * Writes the data to the Gpu if it has changed and binds the Ubo to FRAME_BINDING.
+         * Must be called once per frame before the first draw.
+         */
+        void Upload();
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The Ubo with the data.
+         */
+        std::unique_ptr<ogl::buffer::Ubo> m_ubo;
+
+        /**
+         * The data on the Gpu.
+         */
+        FrameData m_uploadedData;
+
+        /**
+         * False until the first upload.
+         */
+        bool m_uploaded{ false };
+    };
+}
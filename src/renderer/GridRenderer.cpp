@@ -18,6 +18,7 @@
 
 #include "GridRenderer.h"
 #include "RenderUtils.h"
+#include "IslandBatch.h"
 #include "state/State.h"
 #include "file/OriginalResourcesManager.h"
 #include "camera/Camera.h"
@@ -25,6 +26,8 @@
 #include "ogl/resource/ResourceManager.h"
 #include "ogl/resource/TextureUtils.h"
 #include "ogl/buffer/Ssbo.h"
+#include "world/Island.h"
+#include "layer/GridLayer.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -49,36 +52,95 @@ mdcii::renderer::GridRenderer::~GridRenderer() noexcept
 // Logic
 //-------------------------------------------------
 
-void mdcii::renderer::GridRenderer::Render(const layer::GameLayer::Model_Matrices_Ssbos_For_Each_zoom& t_modelMatricesSsbos, const int32_t t_instancesToRender, const world::Zoom t_zoom, const world::Rotation t_rotation) const
+void mdcii::renderer::GridRenderer::CreateIslandBuffers(const std::vector<std::unique_ptr<world::Island>>& t_islands)
 {
+    Log::MDCII_LOG_DEBUG("[GridRenderer::CreateIslandBuffers()] Pack the grids of {} islands into shared Ssbos.", t_islands.size());
+
+    std::vector<int32_t> instances;
+    for (const auto& island : t_islands)
+    {
+        instances.push_back(island->gridLayer->instancesToRender);
+    }
+
+    m_islandBatch = std::make_unique<IslandBatch>(std::move(instances));
+
+    for (auto i{ 0u }; i < t_islands.size(); ++i)
+    {
+        t_islands[i]->gridLayer->baseInstance = m_islandBatch->baseInstances[i];
+    }
+
+    magic_enum::enum_for_each<world::Zoom>([this, &t_islands](const world::Zoom t_zoom) {
+        magic_enum::enum_for_each<world::Rotation>([this, &t_islands, &t_zoom](const world::Rotation t_rotation) {
+            const auto zoomInt{ magic_enum::enum_integer(t_zoom) };
+            const auto rotationInt{ magic_enum::enum_integer(t_rotation) };
+
+            std::vector<const std::vector<glm::mat4>*> matrices;
+            for (const auto& island : t_islands)
+            {
+                matrices.push_back(&island->gridLayer->GetModelMatrices(t_zoom).at(rotationInt));
+            }
+
+            auto ssbo{ std::make_unique<ogl::buffer::Ssbo>(
+                std::string("Grid_ModelMatrices_Ssbo_") +
+                magic_enum::enum_name(t_zoom).data() +
+                "_" + magic_enum::enum_name(t_rotation).data()
+            ) };
+            ssbo->Bind();
+            m_islandBatch->StoreInBoundSsbo(matrices);
+
+            m_islandModelMatricesSsbos.at(zoomInt).at(rotationInt) = std::move(ssbo);
+        });
+    });
+
+    ogl::buffer::Ssbo::Unbind();
+}
+
+void mdcii::renderer::GridRenderer::RenderIslands(const std::vector<int32_t>& t_islands, const world::Zoom t_zoom, const world::Rotation t_rotation) const
+{
+    MDCII_ASSERT(m_islandBatch, "[GridRenderer::RenderIslands()] The island buffers were not created.")
+
     const auto zoomInt{ magic_enum::enum_integer(t_zoom) };
-    const auto rotationInt{ magic_enum::enum_integer(t_rotation) };
 
     ogl::OpenGL::EnableAlphaBlending();
 
-    const auto& shaderProgram{ ogl::resource::ResourceManager::LoadShaderProgram("shader/grid") };
-    shaderProgram.Bind();
+    // the camera comes from the FrameUniforms
+    m_shaderProgram->Bind();
+    m_shaderProgram->SetUniform(m_selectedUniform, false);
+
+    m_islandModelMatricesSsbos.at(zoomInt).at(magic_enum::enum_integer(t_rotation))->BindBase(MODEL_MATRICES_BINDING);
+
+    const auto& textureId{ ogl::resource::ResourceManager::LoadTexture(m_gridFileNames.at(zoomInt)).id };
+    ogl::resource::TextureUtils::BindForReading(textureId, GL_TEXTURE0);
+
+    m_islandBatch->Draw(t_islands);
+
+    ogl::OpenGL::DisableBlending();
+}
 
-    shaderProgram.SetUniform("view", m_context->camera->GetViewMatrix());
-    shaderProgram.SetUniform("projection", m_context->window->GetOrthographicProjectionMatrix());
-    shaderProgram.SetUniform("diffuseMap", 0);
-    shaderProgram.SetUniform("selected", false);
+void mdcii::renderer::GridRenderer::Render(const layer::GameLayer::Model_Matrices_Ssbos_For_Each_zoom& t_modelMatricesSsbos, const int32_t t_instancesToRender, const world::Zoom t_zoom, const world::Rotation t_rotation) const
+{
+    Render(*t_modelMatricesSsbos.at(magic_enum::enum_integer(t_zoom)).at(magic_enum::enum_integer(t_rotation)), t_instancesToRender, t_zoom, false);
+}
+
+void mdcii::renderer::GridRenderer::Render(const ogl::buffer::Ssbo& t_modelMatricesSsbo, const int32_t t_instancesToRender, const world::Zoom t_zoom, const bool t_selected) const
+{
+    const auto zoomInt{ magic_enum::enum_integer(t_zoom) };
+
+    ogl::OpenGL::EnableAlphaBlending();
+
+    // the camera comes from the FrameUniforms
+    m_shaderProgram->Bind();
+    m_shaderProgram->SetUniform(m_selectedUniform, t_selected);
 
     m_vaos.at(zoomInt)->Bind();
 
-    glBindBufferBase(
-        GL_SHADER_STORAGE_BUFFER,
-        MODEL_MATRICES_BINDING,
-        t_modelMatricesSsbos.at(zoomInt).at(rotationInt)->id
-    );
+    t_modelMatricesSsbo.BindBase(MODEL_MATRICES_BINDING);
 
     const auto& textureId{ ogl::resource::ResourceManager::LoadTexture(m_gridFileNames.at(zoomInt)).id };
     ogl::resource::TextureUtils::BindForReading(textureId, GL_TEXTURE0);
 
     m_vaos.at(zoomInt)->DrawInstanced(t_instancesToRender);
 
-    ogl::buffer::Vao::Unbind();
-
     ogl::OpenGL::DisableBlending();
 }
 
@@ -98,6 +160,11 @@ void mdcii::renderer::GridRenderer::Init()
         m_gridFileNames.at(magic_enum::enum_integer(t_zoom)) = fileName;
     });
 
+    m_shaderProgram = &ogl::resource::ResourceManager::LoadShaderProgram("shader/grid");
+    m_shaderProgram->Bind();
+    m_shaderProgram->SetUniform("diffuseMap", 0);
+    m_selectedUniform = m_shaderProgram->GetUniformHandle<bool>("selected");
+
     Log::MDCII_LOG_DEBUG("[GridRenderer::Init()] The GridRenderer was initialized successfully.");
 }
 
@@ -109,7 +176,8 @@ void mdcii::renderer::GridRenderer::CreateVaos()
 {
     Log::MDCII_LOG_DEBUG("[GridRenderer::CreateVaos()] Creates all Vaos.");
 
+    // the shader reads the instance offset of the island grids, which is 0 here
     magic_enum::enum_for_each<world::Zoom>([this](const world::Zoom t_zoom) {
-        m_vaos.at(magic_enum::enum_integer(t_zoom)) = RenderUtils::CreateRectangleVao();
+        m_vaos.at(magic_enum::enum_integer(t_zoom)) = RenderUtils::CreateRectangleVao({ 0 });
     });
 }
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "layer/GameLayer.h"
+#include "ogl/resource/ShaderProgram.h"
 
 //-------------------------------------------------
 // Forward declarations
@@ -56,6 +57,19 @@ namespace mdcii::world
      * Forward declaration enum class Rotation.
      */
     enum class Rotation;
+
+    /**
+     * Forward declaration class Island.
+     */
+    class Island;
+}
+
+namespace mdcii::renderer
+{
+    /**
+     * Forward declaration class IslandBatch.
+     */
+    class IslandBatch;
 }
 
 //-------------------------------------------------
@@ -94,6 +108,22 @@ namespace mdcii::renderer
         // Logic
         //-------------------------------------------------
 
+        /**
+         * Packs the grid layers of all islands into shared Ssbos.
+         *
+         * @param t_islands The islands of the world.
+         */
+        void CreateIslandBuffers(const std::vector<std::unique_ptr<world::Island>>& t_islands);
+
+        /**
+         * Renders the grid of the given islands with a single indirect draw.
+         *
+         * @param t_islands The indices of the visible islands.
+         * @param t_zoom The zoom to render for.
+         * @param t_rotation The rotation to render for.
+         */
+        void RenderIslands(const std::vector<int32_t>& t_islands, world::Zoom t_zoom, world::Rotation t_rotation) const;
+
         /**
          * Renders a GridLayer with the specified zoom and rotation.
          *
@@ -103,6 +133,16 @@ namespace mdcii::renderer
          */
         void Render(const layer::GameLayer::Model_Matrices_Ssbos_For_Each_zoom& t_modelMatricesSsbos, int32_t t_instancesToRender, world::Zoom t_zoom, world::Rotation t_rotation) const;
 
+        /**
+         * Renders grid tiles from a single model matrices Ssbo.
+         *
+         * @param t_modelMatricesSsbo The model matrices Ssbo.
+         * @param t_instancesToRender The number of grid tiles.
+         * @param t_zoom The zoom to render for.
+         * @param t_selected Renders the tiles brighter.
+         */
+        void Render(const ogl::buffer::Ssbo& t_modelMatricesSsbo, int32_t t_instancesToRender, world::Zoom t_zoom, bool t_selected) const;
+
     protected:
 
     private:
@@ -129,11 +169,31 @@ namespace mdcii::renderer
          */
         std::array<std::unique_ptr<ogl::buffer::Vao>, world::NR_OF_ZOOMS> m_vaos;
 
+        /**
+         * The model matrices of the grid layers of all islands.
+         */
+        layer::GameLayer::Model_Matrices_Ssbos_For_Each_zoom m_islandModelMatricesSsbos;
+
+        /**
+         * The instances of all island grids and the draw commands of the visible islands.
+         */
+        std::unique_ptr<IslandBatch> m_islandBatch;
+
         /**
          * Each zoom has a different grid texture.
          */
         std::array<std::string, world::NR_OF_ZOOMS> m_gridFileNames{};
 
+        /**
+         * The grid shader.
+         */
+        const ogl::resource::ShaderProgram* m_shaderProgram{ nullptr };
+
+        /**
+         * The resolved uniform to highlight the grid.
+         */
+        ogl::resource::UniformHandle<bool> m_selectedUniform;
+
         //-------------------------------------------------
         // Init
         //-------------------------------------------------
@@ -0,0 +1,112 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#include <cstring>
+#include "IslandBatch.h"
+#include "RenderUtils.h"
+#include "ogl/buffer/Dibo.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+mdcii::renderer::IslandBatch::IslandBatch(std::vector<int32_t> t_instances)
+    : instances{ std::move(t_instances) }
+{
+    Log::MDCII_LOG_DEBUG("[IslandBatch::IslandBatch()] Create IslandBatch.");
+
+    Init();
+}
+
+mdcii::renderer::IslandBatch::~IslandBatch() noexcept
+{
+    Log::MDCII_LOG_DEBUG("[IslandBatch::~IslandBatch()] Destruct IslandBatch.");
+}
+
+//-------------------------------------------------
+// Draw
+//-------------------------------------------------
+
+void mdcii::renderer::IslandBatch::Draw(const std::vector<int32_t>& t_islands)
+{
+    commands.clear();
+
+    int64_t instancesToRender{ 0 };
+    for (const auto island : t_islands)
+    {
+        const auto islandInstances{ instances.at(island) };
+        if (islandInstances > 0)
+        {
+            // the base instance selects the instance offset of the island
+            commands.push_back({
+                static_cast<uint32_t>(m_vao->drawCount),
+                static_cast<uint32_t>(islandInstances),
+                0,
+                static_cast<uint32_t>(island + 1)
+            });
+
+            instancesToRender += islandInstances;
+        }
+    }
+
+    if (commands.empty())
+    {
+        return;
+    }
+
+    m_dibo->Bind();
+
+    // a still camera needs no upload
+    if (commands.size() != m_uploadedCommands.size() ||
+        std::memcmp(commands.data(), m_uploadedCommands.data(), commands.size() * sizeof(ogl::DrawArraysIndirectCommand)) != 0)
+    {
+        ogl::buffer::Dibo::StoreData(static_cast<uint32_t>(commands.size() * sizeof(ogl::DrawArraysIndirectCommand)), commands.data());
+        m_uploadedCommands = commands;
+    }
+
+    m_vao->Bind();
+    m_vao->MultiDrawIndirect(static_cast<int32_t>(commands.size()), instancesToRender);
+}
+
+//-------------------------------------------------
+// Init
+//-------------------------------------------------
+
+void mdcii::renderer::IslandBatch::Init()
+{
+    Log::MDCII_LOG_DEBUG("[IslandBatch::Init()] Pack the instances of {} islands.", instances.size());
+
+    // the first offset is read by draws without a base instance
+    std::vector<int32_t> instanceOffsets{ 0 };
+
+    baseInstances.clear();
+    for (const auto islandInstances : instances)
+    {
+        MDCII_ASSERT(islandInstances >= 0, "[IslandBatch::Init()] Invalid number of instances.")
+
+        baseInstances.push_back(totalInstances);
+        instanceOffsets.push_back(totalInstances);
+        totalInstances += islandInstances;
+    }
+
+    m_vao = RenderUtils::CreateRectangleVao(instanceOffsets);
+    m_dibo = std::make_unique<ogl::buffer::Dibo>("IslandBatch");
+
+    Log::MDCII_LOG_DEBUG("[IslandBatch::Init()] The islands have {} instances.", totalInstances);
+}
@@ -0,0 +1,179 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "MdciiAssert.h"
+#include "ogl/Device.h"
+#include "ogl/buffer/Ssbo.h"
+
+//-------------------------------------------------
+// Forward declarations
+//-------------------------------------------------
+
+namespace mdcii::ogl::buffer
+{
+    /**
+     * Forward declaration class Vao.
+     */
+    class Vao;
+
+    /**
+     * Forward declaration class Dibo.
+     */
+    class Dibo;
+}
+
+//-------------------------------------------------
+// IslandBatch
+//-------------------------------------------------
+
+namespace mdcii::renderer
+{
+    /**
+     * The instances of all islands, stored one after the other in shared Ssbos.
+     * The visible islands are rendered with a single glMultiDrawArraysIndirect call,
+     * so the number of draw calls doesn't depend on the number of islands.
+     */
+    class IslandBatch
+    {
+    public:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The number of instances of each island.
+         */
+        std::vector<int32_t> instances;
+
+        /**
+         * The position of the first instance of each island in the shared Ssbos.
+         */
+        std::vector<int32_t> baseInstances;
+
+        /**
+         * The number of instances of all islands.
+         */
+        int32_t totalInstances{ 0 };
+
+        /**
+         * The draw commands of the last Draw() call.
+         */
+        std::vector<ogl::DrawArraysIndirectCommand> commands;
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        IslandBatch() = delete;
+
+        /**
+         * Constructs a new IslandBatch object.
+         *
+         * @param t_instances The number of instances of each island.
+         */
+        explicit IslandBatch(std::vector<int32_t> t_instances);
+
+        IslandBatch(const IslandBatch& t_other) = delete;
+        IslandBatch(IslandBatch&& t_other) noexcept = delete;
+        IslandBatch& operator=(const IslandBatch& t_other) = delete;
+        IslandBatch& operator=(IslandBatch&& t_other) noexcept = delete;
+
+        ~IslandBatch() noexcept;
+
+        //-------------------------------------------------
+        // Data
+        //-------------------------------------------------
+
+        /**
+         * Stores the data of all islands one after the other in the bound Ssbo.
+         *
+         * @param t_islands The data of each island with one value per instance.
+         */
+        template<typename T>
+        void StoreInBoundSsbo(const std::vector<const std::vector<T>*>& t_islands) const
+        {
+            MDCII_ASSERT(t_islands.size() == instances.size(), "[IslandBatch::StoreInBoundSsbo()] Invalid number of islands.")
+
+            ogl::buffer::Ssbo::StoreData(static_cast<uint32_t>(totalInstances) * sizeof(T), nullptr);
+
+            for (auto i{ 0u }; i < t_islands.size(); ++i)
+            {
+                MDCII_ASSERT(static_cast<int32_t>(t_islands[i]->size()) == instances[i], "[IslandBatch::StoreInBoundSsbo()] Invalid number of instances.")
+
+                if (!t_islands[i]->empty())
+                {
+                    ogl::buffer::Ssbo::StoreSubData(
+                        baseInstances[i] * static_cast<int32_t>(sizeof(T)),
+                        static_cast<uint32_t>(t_islands[i]->size() * sizeof(T)),
+                        t_islands[i]->data()
+                    );
+                }
+            }
+        }
+
+        //-------------------------------------------------
+        // Draw
+        //-------------------------------------------------
+
+        /**
+         * Renders the given islands with a single indirect draw.
+         * The shader, the Ssbos and the textures must be bound before.
+         * The commands are only uploaded if the visible islands have changed.
+         *
+         * @param t_islands The indices of the visible islands.
+         */
+        void Draw(const std::vector<int32_t>& t_islands);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The rectangle with an instance offset per island.
+         */
+        std::unique_ptr<ogl::buffer::Vao> m_vao;
+
+        /**
+         * The draw commands on the Gpu.
+         */
+        std::unique_ptr<ogl::buffer::Dibo> m_dibo;
+
+        /**
+         * The draw commands in the Dibo.
+         */
+        std::vector<ogl::DrawArraysIndirectCommand> m_uploadedCommands;
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        /**
+         * Calculates the base instances and creates the Gpu objects.
+         */
+        void Init();
+    };
+}
@@ -116,9 +116,55 @@ namespace mdcii::renderer
             return vao;
         }
 
+        /**
+         * Creates Vao and Vbos to render rectangles whose instance data is read from shared Ssbos.
+         *
+         * The shader gets an instance offset at location 1. Because the divisor is larger than
+         * any number of instances, all instances of a draw read the offset at the base instance
+         * of the draw. The shader adds gl_InstanceID to find the data of an instance.
+         *
+         * @param t_instanceOffsets The offset for each base instance. Draws without a base instance use the first offset.
+         *
+         * @return The created Vao.
+         */
+        static std::unique_ptr<ogl::buffer::Vao> CreateRectangleVao(const std::vector<int32_t>& t_instanceOffsets)
+        {
+            MDCII_ASSERT(!t_instanceOffsets.empty(), "[RenderUtils::CreateRectangleVao()] Missing instance offsets.")
+
+            auto vao{ CreateRectangleVao() };
+            vao->Bind();
+
+            auto vbo{ std::make_unique<ogl::buffer::Vbo>() };
+            vbo->Bind();
+
+            ogl::buffer::Vbo::StoreStaticData(static_cast<uint32_t>(t_instanceOffsets.size() * sizeof(int32_t)), t_instanceOffsets.data());
+            ogl::buffer::Vbo::AddIntAttribute(INSTANCE_OFFSET_LOCATION, 1, 1, 0, INSTANCE_OFFSET_DIVISOR);
+
+            ogl::buffer::Vbo::Unbind();
+            ogl::buffer::Vao::Unbind();
+
+            vao->vbos.emplace_back(std::move(vbo));
+
+            return vao;
+        }
+
     protected:
 
     private:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The location of the instance offset attribute.
+         */
+        static constexpr uint32_t INSTANCE_OFFSET_LOCATION{ 1 };
+
+        /**
+         * Larger than any number of instances of a draw.
+         */
+        static constexpr uint32_t INSTANCE_OFFSET_DIVISOR{ 0x7FFFFFFF };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
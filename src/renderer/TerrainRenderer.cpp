@@ -16,9 +16,11 @@
 // along with this program; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
+#include <cmath>
 #include <glm/gtx/hash.hpp>
 #include "TerrainRenderer.h"
 #include "RenderUtils.h"
+#include "IslandBatch.h"
 #include "state/State.h"
 #include "file/OriginalResourcesManager.h"
 #include "camera/Camera.h"
@@ -28,6 +30,38 @@
 #include "ogl/buffer/Ssbo.h"
 #include "world/TileAtlas.h"
 #include "world/Island.h"
+#include "layer/WorldLayer.h"
+#include "profiler/Profiler.h"
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+namespace
+{
+    /**
+     * Get the layer of an island whose instances are stored in the shared Ssbos.
+     *
+     * @param t_island The Island object.
+     * @param t_layerType COAST, TERRAIN or BUILDINGS.
+     *
+     * @return The TerrainLayer object.
+     */
+    mdcii::layer::TerrainLayer& get_island_layer(const mdcii::world::Island& t_island, const mdcii::layer::LayerType t_layerType)
+    {
+        switch (t_layerType)
+        {
+        case mdcii::layer::LayerType::COAST:
+            return *t_island.coastLayer;
+        case mdcii::layer::LayerType::TERRAIN:
+            return *t_island.terrainLayer;
+        case mdcii::layer::LayerType::BUILDINGS:
+            return *t_island.buildingsLayer;
+        default:
+            throw MDCII_EXCEPTION("[get_island_layer()] Invalid layer type.");
+        }
+    }
+}
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -54,118 +88,192 @@ mdcii::renderer::TerrainRenderer::~TerrainRenderer() noexcept
 // Logic
 //-------------------------------------------------
 
-void mdcii::renderer::TerrainRenderer::Update()
+void mdcii::renderer::TerrainRenderer::CreateIslandBuffers(const std::vector<std::unique_ptr<world::Island>>& t_islands)
 {
-    // The animation speeds of the buildings are finally defined.
-    // So after 90, 130, 150, 180, 220 milliseconds the next frame from the animation is used.
-    // This update method is called approximately every 16.7 milliseconds.
+    MDCII_PROFILE_SCOPE("TerrainRenderer::CreateIslandBuffers")
 
-    if (m_updates % 6 == 0) // ca. 90ms
-    {
-        m_timeCounter[0]++;
-    }
-    if (m_updates % 8 == 0) // ca. 130ms
-    {
-        m_timeCounter[1]++;
-    }
-    if (m_updates % 9 == 0) // ca. 150ms
-    {
-        m_timeCounter[2]++;
-    }
-    if (m_updates % 11 == 0) // ca. 180ms
-    {
-        m_timeCounter[3]++;
-    }
-    if (m_updates % 13 == 0) // ca. 220ms
+    Log::MDCII_LOG_DEBUG("[TerrainRenderer::CreateIslandBuffers()] Pack the layers of {} islands into shared Ssbos.", t_islands.size());
+
+    std::vector<int32_t> instances;
+    for (const auto& island : t_islands)
     {
-        m_timeCounter[4]++;
+        MDCII_ASSERT(island->coastLayer->instancesToRender == island->terrainLayer->instancesToRender, "[TerrainRenderer::CreateIslandBuffers()] Invalid number of instances.")
+        MDCII_ASSERT(island->buildingsLayer->instancesToRender == island->terrainLayer->instancesToRender, "[TerrainRenderer::CreateIslandBuffers()] Invalid number of instances.")
+
+        instances.push_back(island->terrainLayer->instancesToRender);
     }
 
-    m_updates++; // is incremented every 16.7 milliseconds
+    m_islandBatch = std::make_unique<IslandBatch>(std::move(instances));
 
-    // reset counter after an arbitrary specified time
-    if (m_updates > 4096)
+    for (const auto layerType : { layer::LayerType::COAST, layer::LayerType::TERRAIN, layer::LayerType::BUILDINGS })
     {
-        m_updates = 0;
-        memset(&m_timeCounter[0], 0, m_timeCounter.size() * sizeof m_timeCounter[0]);
+        std::vector<const layer::TerrainLayer*> layers;
+        for (auto i{ 0u }; i < t_islands.size(); ++i)
+        {
+            auto& islandLayer{ get_island_layer(*t_islands[i], layerType) };
+            islandLayer.baseInstance = m_islandBatch->baseInstances[i];
+            layers.push_back(&islandLayer);
+        }
+
+        auto& buffers{ m_islandBuffers.at(magic_enum::enum_integer(layerType)) };
+        const auto prefix{ std::string(magic_enum::enum_name(layerType)) };
+
+        magic_enum::enum_for_each<world::Zoom>([this, &layers, &buffers, &prefix](const world::Zoom t_zoom) {
+            magic_enum::enum_for_each<world::Rotation>([this, &layers, &buffers, &prefix, &t_zoom](const world::Rotation t_rotation) {
+                const auto zoomInt{ magic_enum::enum_integer(t_zoom) };
+                const auto rotationInt{ magic_enum::enum_integer(t_rotation) };
+
+                std::vector<const std::vector<glm::mat4>*> matrices;
+                for (const auto* islandLayer : layers)
+                {
+                    matrices.push_back(&islandLayer->GetModelMatrices(t_zoom).at(rotationInt));
+                }
+
+                auto ssbo{ std::make_unique<ogl::buffer::Ssbo>(
+                    prefix + "_ModelMatrices_Ssbo_" +
+                    magic_enum::enum_name(t_zoom).data() +
+                    "_" + magic_enum::enum_name(t_rotation).data()
+                ) };
+                ssbo->Bind();
+                m_islandBatch->StoreInBoundSsbo(matrices);
+
+                buffers.modelMatricesSsbos.at(zoomInt).at(rotationInt) = std::move(ssbo);
+            });
+        });
+
+        std::vector<const std::vector<glm::ivec4>*> gfxNumbers;
+        std::vector<const std::vector<glm::ivec4>*> buildingIds;
+        for (const auto* islandLayer : layers)
+        {
+            gfxNumbers.push_back(&islandLayer->gfxNumbers);
+            buildingIds.push_back(&islandLayer->buildingIds);
+        }
+
+        buffers.gfxNumbersSsbo = std::make_unique<ogl::buffer::Ssbo>(prefix + "_GfxNumbers_Ssbo");
+        buffers.gfxNumbersSsbo->Bind();
+        m_islandBatch->StoreInBoundSsbo(gfxNumbers);
+
+        buffers.buildingIdsSsbo = std::make_unique<ogl::buffer::Ssbo>(prefix + "_BuildingIds_Ssbo");
+        buffers.buildingIdsSsbo->Bind();
+        m_islandBatch->StoreInBoundSsbo(buildingIds);
     }
+
+    ogl::buffer::Ssbo::Unbind();
+
+    Log::MDCII_LOG_DEBUG("[TerrainRenderer::CreateIslandBuffers()] The island Ssbos hold {} instances for each layer.", m_islandBatch->totalInstances);
 }
 
-void mdcii::renderer::TerrainRenderer::Render(
-    const layer::GameLayer::Model_Matrices_Ssbos_For_Each_zoom& t_modelMatricesSsbos,
-    const ogl::buffer::Ssbo& t_gfxNumbersSsbo,
-    const ogl::buffer::Ssbo& t_buildingIdsSsbo,
-    const int32_t t_instancesToRender,
-    mdcii::world::Zoom t_zoom,
-    mdcii::world::Rotation t_rotation
-    ) const
+void mdcii::renderer::TerrainRenderer::RenderIslands(
+    const std::vector<int32_t>& t_islands,
+    const layer::LayerType t_layerType,
+    const world::Zoom t_zoom,
+    const world::Rotation t_rotation
+) const
 {
+    MDCII_ASSERT(m_islandBatch, "[TerrainRenderer::RenderIslands()] The island buffers were not created.")
+
+    // the mixed view composes the terrain with the buildings at render time,
+    // a single layer is bound as terrain and as buildings
+    const auto isMixed{ t_layerType == layer::LayerType::MIXED };
+    const auto& buffers{ GetIslandBuffers(isMixed ? layer::LayerType::TERRAIN : t_layerType) };
+    const auto& buildingsBuffers{ GetIslandBuffers(isMixed ? layer::LayerType::BUILDINGS : t_layerType) };
+
     const auto zoomInt{ magic_enum::enum_integer(t_zoom) };
     const auto rotationInt{ magic_enum::enum_integer(t_rotation) };
 
-    const auto& shaderProgram{ ogl::resource::ResourceManager::LoadShaderProgram("shader/world") };
-    shaderProgram.Bind();
+    // all uniforms come from the FrameUniforms or never change
+    m_worldShaderProgram->Bind();
 
-    shaderProgram.SetUniform("projectionView", m_context->window->GetOrthographicProjectionMatrix() * m_context->camera->GetViewMatrix());
-    shaderProgram.SetUniform("diffuseMap", 0);
-    shaderProgram.SetUniform("selected", false);
-    shaderProgram.SetUniform("worldRotation", rotationInt);
-    shaderProgram.SetUniform("updates", m_timeCounter);
+    buffers.modelMatricesSsbos.at(zoomInt).at(rotationInt)->BindBase(MODEL_MATRICES_BINDING);
 
-    const auto maxY{ world::TileAtlas::HEIGHTS.at(zoomInt) };
-    const auto nrOfRows{ static_cast<float>(world::TileAtlas::ROWS.at(zoomInt)) };
+    buffers.gfxNumbersSsbo->BindBase(GFX_NUMBERS_BINDING);
 
-    shaderProgram.SetUniform("maxY", maxY);
-    shaderProgram.SetUniform("nrOfRows", nrOfRows);
+    buffers.buildingIdsSsbo->BindBase(BUILDING_IDS_BINDING);
 
-    m_vaos.at(zoomInt)->Bind();
+    m_heightsSsbos.at(zoomInt)->BindBase(HEIGHTS_BINDING);
 
-    glBindBufferBase(
-        GL_SHADER_STORAGE_BUFFER,
-        MODEL_MATRICES_BINDING,
-        t_modelMatricesSsbos.at(zoomInt).at(rotationInt)->id
-    );
-
-    glBindBufferBase(
-        GL_SHADER_STORAGE_BUFFER,
-        GFX_NUMBERS_BINDING,
-        t_gfxNumbersSsbo.id
-    );
-
-    glBindBufferBase(
-        GL_SHADER_STORAGE_BUFFER,
-        BUILDING_IDS_BINDING,
-        t_buildingIdsSsbo.id
-    );
-
-    glBindBufferBase(
-        GL_SHADER_STORAGE_BUFFER,
-        HEIGHTS_BINDING,
-        m_heightsSsbos.at(zoomInt)->id
-    );
-
-    glBindBufferBase(
-        GL_SHADER_STORAGE_BUFFER,
-        ANIMATIONS_BINDING,
-        m_animationSsbo->id
-    );
+    m_animationSsbo->BindBase(ANIMATIONS_BINDING);
 
-    ogl::resource::TextureUtils::BindForReading(m_tileAtlas->textureIds.at(zoomInt), GL_TEXTURE0, GL_TEXTURE_2D_ARRAY);
-    m_vaos.at(zoomInt)->DrawInstanced(t_instancesToRender);
+    buildingsBuffers.modelMatricesSsbos.at(zoomInt).at(rotationInt)->BindBase(BUILDINGS_MODEL_MATRICES_BINDING);
 
-    ogl::buffer::Vao::Unbind();
+    buildingsBuffers.gfxNumbersSsbo->BindBase(BUILDINGS_GFX_NUMBERS_BINDING);
+
+    buildingsBuffers.buildingIdsSsbo->BindBase(BUILDINGS_BUILDING_IDS_BINDING);
+
+    ogl::resource::TextureUtils::BindForReading(m_tileAtlas->textureIds.at(zoomInt), GL_TEXTURE0, GL_TEXTURE_2D_ARRAY);
+    m_islandBatch->Draw(t_islands);
 }
 
-void mdcii::renderer::TerrainRenderer::Render(const layer::TerrainLayer& t_terrainLayer, const world::Zoom t_zoom, const world::Rotation t_rotation) const
+void mdcii::renderer::TerrainRenderer::RenderDeepWater(const layer::WorldLayer& t_worldLayer, const world::Zoom t_zoom, const world::Rotation t_rotation) const
 {
-    Render(
-        t_terrainLayer.modelMatricesSsbos,
-        *t_terrainLayer.gfxNumbersSsbo,
-        *t_terrainLayer.buildingIdsSsbo,
-        t_terrainLayer.instancesToRender,
-        t_zoom,
-        t_rotation
-    );
+    MDCII_ASSERT(t_worldLayer.islandGridSsbo, "[TerrainRenderer::RenderDeepWater()] Null pointer.")
+
+    const auto zoomInt{ magic_enum::enum_integer(t_zoom) };
+
+    const auto tileWidthHalf{ static_cast<float>(world::get_tile_width_half(t_zoom)) };
+    const auto tileHeightHalf{ static_cast<float>(world::get_tile_height_half(t_zoom)) };
+    const auto tileHeight{ static_cast<float>(world::get_tile_height(t_zoom)) };
+    const auto& waterSize{ t_worldLayer.waterSizes.at(zoomInt) };
+    const auto& cameraPosition{ m_context->camera->position };
+
+    // the screen position of a tile is ((x - y) * tileWidthHalf, (x + y) * tileHeightHalf),
+    // so the visible area is a range of screen columns (x - y) and screen rows (x + y)
+    auto minColumn{ static_cast<int32_t>(std::floor(cameraPosition.x / tileWidthHalf)) - 2 };
+    auto maxColumn{ static_cast<int32_t>(std::ceil((cameraPosition.x + static_cast<float>(m_context->window->width)) / tileWidthHalf)) };
+    auto minRow{ static_cast<int32_t>(std::floor((cameraPosition.y - tileHeight) / tileHeightHalf)) };
+    auto maxRow{ static_cast<int32_t>(std::ceil((cameraPosition.y + static_cast<float>(m_context->window->height) + waterSize.y - tileHeight) / tileHeightHalf)) };
+
+    // clamp to the rotated corners of the world
+    auto worldMinColumn{ std::numeric_limits<int32_t>::max() };
+    auto worldMaxColumn{ std::numeric_limits<int32_t>::min() };
+    auto worldMinRow{ std::numeric_limits<int32_t>::max() };
+    auto worldMaxRow{ std::numeric_limits<int32_t>::min() };
+    for (const auto& corner : { glm::ivec2(0, 0), glm::ivec2(t_worldLayer.width - 1, 0), glm::ivec2(0, t_worldLayer.height - 1), glm::ivec2(t_worldLayer.width - 1, t_worldLayer.height - 1) })
+    {
+        const auto position{ world::rotate_position(corner.x, corner.y, t_worldLayer.width, t_worldLayer.height, t_rotation) };
+        worldMinColumn = std::min(worldMinColumn, position.x - position.y);
+        worldMaxColumn = std::max(worldMaxColumn, position.x - position.y);
+        worldMinRow = std::min(worldMinRow, position.x + position.y);
+        worldMaxRow = std::max(worldMaxRow, position.x + position.y);
+    }
+
+    minColumn = std::max(minColumn, worldMinColumn);
+    maxColumn = std::min(maxColumn, worldMaxColumn);
+    minRow = std::max(minRow, worldMinRow);
+    maxRow = std::min(maxRow, worldMaxRow);
+
+    if (minColumn > maxColumn || minRow > maxRow)
+    {
+        return;
+    }
+
+    // only every second column is a tile in each row
+    const auto nrOfColumns{ (maxColumn - minColumn) / 2 + 1 };
+    const auto instances{ nrOfColumns * (maxRow - minRow + 1) };
+
+    // the camera and the atlas values come from the FrameUniforms
+    const auto& shaderProgram{ *m_waterShaderProgram };
+    shaderProgram.Bind();
+
+    shaderProgram.SetUniform(m_waterUniforms.worldWidth, t_worldLayer.width);
+    shaderProgram.SetUniform(m_waterUniforms.worldHeight, t_worldLayer.height);
+    shaderProgram.SetUniform(m_waterUniforms.tileWidth, world::get_tile_width(t_zoom));
+    shaderProgram.SetUniform(m_waterUniforms.tileHeight, world::get_tile_height(t_zoom));
+    shaderProgram.SetUniform(m_waterUniforms.waterSize, waterSize);
+    shaderProgram.SetUniform(m_waterUniforms.minColumn, minColumn);
+    shaderProgram.SetUniform(m_waterUniforms.minRow, minRow);
+    shaderProgram.SetUniform(m_waterUniforms.nrOfColumns, nrOfColumns);
+
+    m_vaos.at(zoomInt)->Bind();
+
+    m_heightsSsbos.at(zoomInt)->BindBase(HEIGHTS_BINDING);
+
+    m_animationSsbo->BindBase(ANIMATIONS_BINDING);
+
+    t_worldLayer.islandGridSsbo->BindBase(ISLAND_GRID_BINDING);
+
+    ogl::resource::TextureUtils::BindForReading(m_tileAtlas->textureIds.at(zoomInt), GL_TEXTURE0, GL_TEXTURE_2D_ARRAY);
+    m_vaos.at(zoomInt)->DrawInstanced(instances);
 }
 
 //-------------------------------------------------
@@ -174,6 +282,8 @@ void mdcii::renderer::TerrainRenderer::Render(const layer::TerrainLayer& t_terra
 
 void mdcii::renderer::TerrainRenderer::DeleteBuildingFromGpu(world::Island& t_island, const layer::Tile& t_tile)
 {
+    MDCII_PROFILE_SCOPE("TerrainRenderer::DeleteBuildingFromGpu")
+
     MDCII_ASSERT(t_tile.HasBuilding(), "[TerrainRenderer::DeleteBuildingFromGpu()] No building to delete.")
 
     Log::MDCII_LOG_DEBUG("[TerrainRenderer::DeleteBuildingFromGpu()] Delete building Gpu data with Id {} from world position ({}, {}).", t_tile.buildingId, t_tile.worldXDeg0, t_tile.worldYDeg0);
@@ -181,14 +291,9 @@ void mdcii::renderer::TerrainRenderer::DeleteBuildingFromGpu(world::Island& t_is
     magic_enum::enum_for_each<world::Zoom>([this, &t_island, &t_tile](const world::Zoom t_zoom) {
         magic_enum::enum_for_each<world::Rotation>([this, &t_zoom, &t_island, &t_tile](const world::Rotation t_rotation) {
             const auto rotationInt{ magic_enum::enum_integer(t_rotation) };
-            const auto zoomInt{ magic_enum::enum_integer(t_zoom) };
-
-            // to override MIXED layer
-            const auto& tm{ t_island.terrainLayer->modelMatrices[zoomInt][rotationInt] };
-            const auto& tg{ t_island.terrainLayer->gfxNumbers };
-            const auto& tb{ t_island.terrainLayer->buildingIds };
 
             // delete: update Gpu data of BUILDINGS Layer
+            // the terrain is shown again because the mixed view is composed at render time
             UpdateGpuData(
                 t_tile.instanceIds[rotationInt],
                 *t_island.buildingsLayer,
@@ -197,16 +302,6 @@ void mdcii::renderer::TerrainRenderer::DeleteBuildingFromGpu(world::Island& t_is
                 -1,          // gfx
                 -1           // building
             );
-
-            // delete: update Gpu data from MIXED Layer
-            UpdateGpuData(
-                t_tile.instanceIds[rotationInt],
-                *t_island.mixedLayer,
-                t_zoom, t_rotation,
-                tm[t_tile.instanceIds[rotationInt]],
-                tg[t_tile.instanceIds[rotationInt]][rotationInt],
-                tb[t_tile.instanceIds[rotationInt]][rotationInt]
-            );
         });
     });
 }
@@ -223,10 +318,9 @@ void mdcii::renderer::TerrainRenderer::DeleteBuildingFromGpu(world::Terrain& t_t
     std::vector<std::unique_ptr<layer::Tile>>().swap(t_terrain.tilesToAdd.tiles);
 }
 
-void mdcii::renderer::TerrainRenderer::DeleteBuildingFromGpu(world::Island& t_island, const std::vector<int32_t>& t_tileIndices)
+void mdcii::renderer::TerrainRenderer::DeleteBuildingFromGpu(world::Island& t_island, const int32_t t_placedBuildingIndex)
 {
-    MDCII_ASSERT(!t_tileIndices.empty(), "[TerrainRenderer::DeleteBuildingFromGpu()] No Tile indices available.")
-    for (const auto tileIndex : t_tileIndices)
+    for (const auto tileIndex : t_island.GetTileIndicesOfPlacedBuilding(t_placedBuildingIndex))
     {
         DeleteBuildingFromGpu(t_island, *t_island.buildingsLayer->tiles.at(tileIndex));
     }
@@ -238,6 +332,8 @@ void mdcii::renderer::TerrainRenderer::AddBuildingToGpu(
     world::Terrain& t_terrain
 )
 {
+    MDCII_PROFILE_SCOPE("TerrainRenderer::AddBuildingToGpu")
+
     const auto& building{ m_context->originalResourcesManager->GetBuildingById(t_selectedBuildingTile.buildingId) };
     if (!t_terrain.IsBuildableOnIslandUnderMouse(t_startWorldPosition, building, t_selectedBuildingTile.rotation))
     {
@@ -291,8 +387,8 @@ void mdcii::renderer::TerrainRenderer::AddBuildingToGpu(
                     const auto rotationInt{ magic_enum::enum_integer(t_rotation) };
 
                     // create new Gpu data
-                    const auto modelMatrix{ t_terrain.currentIslandUnderMouse->mixedLayer->CreateModelMatrix(*tile, t_zoom, t_rotation) };
-                    const auto gfxNumber{ t_terrain.currentIslandUnderMouse->mixedLayer->CalcGfx(*tile, t_rotation) };
+                    const auto modelMatrix{ t_terrain.currentIslandUnderMouse->buildingsLayer->CreateModelMatrix(*tile, t_zoom, t_rotation) };
+                    const auto gfxNumber{ t_terrain.currentIslandUnderMouse->buildingsLayer->CalcGfx(*tile, t_rotation) };
 
                     // add: update Gpu data BUILDINGS
                     UpdateGpuData(
@@ -303,16 +399,6 @@ void mdcii::renderer::TerrainRenderer::AddBuildingToGpu(
                         gfxNumber,
                         tile->buildingId
                     );
-
-                    // add: update Gpu data MIXED
-                    UpdateGpuData(
-                        tile->instanceIds[rotationInt],
-                        *t_terrain.currentIslandUnderMouse->mixedLayer,
-                        t_zoom, t_rotation,
-                        modelMatrix,
-                        gfxNumber,
-                        tile->buildingId
-                    );
                 });
             });
 
@@ -323,16 +409,12 @@ void mdcii::renderer::TerrainRenderer::AddBuildingToGpu(
 
     MDCII_ASSERT(t_terrain.tilesToAdd.tiles.size() == building.size.w * building.size.h, "[TerrainRenderer::AddBuildingToGpu()] Invalid number of created tiles.")
 
-    std::vector<int32_t> connected;
-    for (const auto& tile : t_terrain.tilesToAdd.tiles)
-    {
-        connected.push_back(tile->indices[0]);
-    }
-
-    for (const auto& tile : t_terrain.tilesToAdd.tiles)
-    {
-        tile->connectedTiles = connected;
-    }
+    t_terrain.tilesToAdd.placedBuilding = {
+        building.id,
+        t_terrain.currentIslandUnderMouse->GetIslandPositionFromWorldPosition(t_startWorldPosition),
+        t_selectedBuildingTile.rotation,
+        { building.size.w, building.size.h }
+    };
 
     Log::MDCII_LOG_DEBUG("[TerrainRenderer::AddBuildingToGpu()] Add building Gpu data with Id {} to world position ({}, {}).", building.id, t_startWorldPosition.x, t_startWorldPosition.y);
 }
@@ -351,74 +433,91 @@ void mdcii::renderer::TerrainRenderer::UpdateGpuData(
     const auto zoomInt{ magic_enum::enum_integer(t_zoom) };
     const auto rotationInt{ magic_enum::enum_integer(t_rotation) };
 
-    // bind Vao of the given zoom
-    const auto& vao{ m_vaos.at(zoomInt) };
-    vao->Bind();
+    // the instance of the island in the shared Ssbos
+    const auto& buffers{ GetIslandBuffers(t_terrainLayer.layerType) };
+    const auto instance{ t_terrainLayer.baseInstance + t_instance };
+
+    // the buffers stay bound, so that the next update of the same buffer skips the bind
 
     // new model matrix
-    const auto& modelMatricesSsbo{ t_terrainLayer.modelMatricesSsbos.at(zoomInt).at(rotationInt) };
+    const auto& modelMatricesSsbo{ buffers.modelMatricesSsbos.at(zoomInt).at(rotationInt) };
     modelMatricesSsbo->Bind();
-    ogl::buffer::Ssbo::StoreSubData(static_cast<int32_t>(sizeof(glm::mat4)) * t_instance, sizeof(glm::mat4), &t_modelMatrix);
-    ogl::buffer::Ssbo::Unbind();
+    ogl::buffer::Ssbo::StoreSubData(static_cast<int32_t>(sizeof(glm::mat4)) * instance, sizeof(glm::mat4), &t_modelMatrix);
 
     // calc offset
     const auto rotOffset{ rotationInt * static_cast<int32_t>(sizeof(int32_t)) };
 
     // new gfx number
-    const auto& gfxNumbersSsbo{ t_terrainLayer.gfxNumbersSsbo };
-    gfxNumbersSsbo->Bind();
-    ogl::buffer::Ssbo::StoreSubData((static_cast<int32_t>(sizeof(glm::ivec4)) * t_instance) + rotOffset, sizeof(int32_t), &t_gfxNumber);
-    ogl::buffer::Ssbo::Unbind();
+    buffers.gfxNumbersSsbo->Bind();
+    ogl::buffer::Ssbo::StoreSubData((static_cast<int32_t>(sizeof(glm::ivec4)) * instance) + rotOffset, sizeof(int32_t), &t_gfxNumber);
 
     // new building
-    const auto& buildingsSsbo{ t_terrainLayer.buildingIdsSsbo };
-    buildingsSsbo->Bind();
-    ogl::buffer::Ssbo::StoreSubData((static_cast<int32_t>(sizeof(glm::ivec4)) * t_instance) + rotOffset, sizeof(int32_t), &t_buildingId);
-    ogl::buffer::Ssbo::Unbind();
-
-    // unbind Vao
-    ogl::buffer::Vao::Unbind();
+    buffers.buildingIdsSsbo->Bind();
+    ogl::buffer::Ssbo::StoreSubData((static_cast<int32_t>(sizeof(glm::ivec4)) * instance) + rotOffset, sizeof(int32_t), &t_buildingId);
 }
 
 //-------------------------------------------------
 // Remove / add building - Cpu
 //-------------------------------------------------
 
-void mdcii::renderer::TerrainRenderer::DeleteBuildingFromCpu(layer::Tile& t_tile)
+void mdcii::renderer::TerrainRenderer::DeleteBuildingFromCpu(world::Island& t_island, layer::Tile& t_tile)
 {
     MDCII_ASSERT(t_tile.HasBuilding(), "[TerrainRenderer::DeleteBuildingFromCpu()] No building to delete.")
     Log::MDCII_LOG_DEBUG("[TerrainRenderer::DeleteBuildingFromCpu()] Delete building Cpu data with Id {} from world position ({}, {}).", t_tile.buildingId, t_tile.worldXDeg0, t_tile.worldYDeg0);
 
     t_tile.ResetBuildingInfo();
+    t_island.buildingsLayer->UpdateSaveGameTile(t_tile);
+    t_island.UpdateBuildabilityMap(t_tile.islandXDeg0, t_tile.islandYDeg0);
 }
 
-void mdcii::renderer::TerrainRenderer::DeleteBuildingFromCpu(world::Island& t_island, const std::vector<int32_t>& t_tileIndices)
+void mdcii::renderer::TerrainRenderer::DeleteBuildingFromCpu(world::Island& t_island, const int32_t t_placedBuildingIndex)
 {
-    MDCII_ASSERT(!t_tileIndices.empty(), "[TerrainRenderer::DeleteBuildingFromCpu()] No Tile indices available.")
-    for (const auto tileIndex : t_tileIndices)
+    for (const auto tileIndex : t_island.GetTileIndicesOfPlacedBuilding(t_placedBuildingIndex))
     {
-        DeleteBuildingFromCpu(*t_island.buildingsLayer->tiles.at(tileIndex));
+        DeleteBuildingFromCpu(t_island, *t_island.buildingsLayer->tiles.at(tileIndex));
     }
+
+    t_island.buildingRegistry.Remove(t_placedBuildingIndex);
 }
 
 void mdcii::renderer::TerrainRenderer::AddBuildingToCpu(world::Terrain& t_terrain)
 {
     MDCII_ASSERT(!t_terrain.tilesToAdd.tiles.empty(), "[TerrainRenderer::AddBuildingToCpu()] No Tile objects available.")
 
+    // register the building
+    const auto placedBuildingIndex{ t_terrain.tilesToAdd.island->buildingRegistry.Add(t_terrain.tilesToAdd.placedBuilding) };
+
     // reset Tile pointers and replace with new tile
-    const auto& buildingsLayer{ t_terrain.tilesToAdd.island->buildingsLayer };
+    auto& island{ *t_terrain.tilesToAdd.island };
+    const auto& buildingsLayer{ island.buildingsLayer };
     for (auto& tile : t_terrain.tilesToAdd.tiles)
     {
         Log::MDCII_LOG_DEBUG("[TerrainRenderer::AddBuildingToCpu()] Add building Cpu data with Id {} to world position ({}, {}).", tile->buildingId, tile->worldXDeg0, tile->worldYDeg0);
 
+        tile->placedBuildingIndex = placedBuildingIndex;
+        buildingsLayer->UpdateSaveGameTile(*tile);
         buildingsLayer->ResetTilePointersAt(tile->instanceIds);
+
+        const glm::ivec2 islandPosition{ tile->islandXDeg0, tile->islandYDeg0 };
         buildingsLayer->StoreTile(std::move(tile));
+        island.UpdateBuildabilityMap(islandPosition.x, islandPosition.y);
     }
 
     // clear vector
     std::vector<std::unique_ptr<layer::Tile>>().swap(t_terrain.tilesToAdd.tiles);
 }
 
+//-------------------------------------------------
+// Island buffers
+//-------------------------------------------------
+
+const mdcii::renderer::TerrainRenderer::IslandBuffers& mdcii::renderer::TerrainRenderer::GetIslandBuffers(const layer::LayerType t_layerType) const
+{
+    MDCII_ASSERT(t_layerType == layer::LayerType::COAST || t_layerType == layer::LayerType::TERRAIN || t_layerType == layer::LayerType::BUILDINGS, "[TerrainRenderer::GetIslandBuffers()] Invalid layer type.")
+
+    return m_islandBuffers.at(magic_enum::enum_integer(t_layerType));
+}
+
 //-------------------------------------------------
 // Init
 //-------------------------------------------------
@@ -430,10 +529,36 @@ void mdcii::renderer::TerrainRenderer::Init()
     CreateVaos();
     CreateHeightsSsbos();
     CreateAnimationInfoSsbo();
+    InitShaders();
 
     Log::MDCII_LOG_DEBUG("[TerrainRenderer::Init()] The TerrainRenderer was initialized successfully.");
 }
 
+void mdcii::renderer::TerrainRenderer::InitShaders()
+{
+    Log::MDCII_LOG_DEBUG("[TerrainRenderer::InitShaders()] Load shaders and resolve uniforms.");
+
+    m_worldShaderProgram = &ogl::resource::ResourceManager::LoadShaderProgram("shader/world");
+    m_worldShaderProgram->Bind();
+    m_worldShaderProgram->SetUniform("diffuseMap", 0);
+    m_worldShaderProgram->SetUniform("selected", false);
+
+    m_waterShaderProgram = &ogl::resource::ResourceManager::LoadShaderProgram("shader/water");
+    m_waterShaderProgram->Bind();
+    m_waterShaderProgram->SetUniform("diffuseMap", 0);
+    m_waterShaderProgram->SetUniform("waterBuildingId", layer::WorldLayer::WATER_BUILDING_ID);
+    m_waterShaderProgram->SetUniform("waterGfx", layer::WorldLayer::WATER_GFX);
+
+    m_waterUniforms.worldWidth = m_waterShaderProgram->GetUniformHandle<int32_t>("worldWidth");
+    m_waterUniforms.worldHeight = m_waterShaderProgram->GetUniformHandle<int32_t>("worldHeight");
+    m_waterUniforms.tileWidth = m_waterShaderProgram->GetUniformHandle<int32_t>("tileWidth");
+    m_waterUniforms.tileHeight = m_waterShaderProgram->GetUniformHandle<int32_t>("tileHeight");
+    m_waterUniforms.waterSize = m_waterShaderProgram->GetUniformHandle<glm::vec2>("waterSize");
+    m_waterUniforms.minColumn = m_waterShaderProgram->GetUniformHandle<int32_t>("minColumn");
+    m_waterUniforms.minRow = m_waterShaderProgram->GetUniformHandle<int32_t>("minRow");
+    m_waterUniforms.nrOfColumns = m_waterShaderProgram->GetUniformHandle<int32_t>("nrOfColumns");
+}
+
 //-------------------------------------------------
 // Create buffers
 //-------------------------------------------------
@@ -20,6 +20,7 @@
 
 #include "layer/TerrainLayer.h"
 #include "world/Terrain.h"
+#include "ogl/resource/ShaderProgram.h"
 
 //-------------------------------------------------
 // Forward declarations
@@ -33,6 +34,14 @@ namespace mdcii::state
     struct Context;
 }
 
+namespace mdcii::layer
+{
+    /**
+     * Forward declaration class WorldLayer.
+     */
+    class WorldLayer;
+}
+
 namespace mdcii::ogl::buffer
 {
     /**
@@ -54,6 +63,14 @@ namespace mdcii::world
     class TileAtlas;
 }
 
+namespace mdcii::renderer
+{
+    /**
+     * Forward declaration class IslandBatch.
+     */
+    class IslandBatch;
+}
+
 //-------------------------------------------------
 // TerrainRenderer
 //-------------------------------------------------
@@ -92,37 +109,32 @@ namespace mdcii::renderer
         //-------------------------------------------------
 
         /**
-         * Updates the TerrainLayer.
+         * Packs the coast, terrain and buildings layers of all islands into shared Ssbos.
+         * The three layers of an island have the same number of instances and share the base instance.
+         *
+         * @param t_islands The islands of the world.
          */
-        void Update();
+        void CreateIslandBuffers(const std::vector<std::unique_ptr<world::Island>>& t_islands);
 
         /**
-         * Renders a Layer content with the specified zoom and rotation.
+         * Renders a layer of the given islands with a single indirect draw.
          *
-         * @param t_modelMatricesSsbos The model matrices Ssbos.
-         * @param t_gfxNumbersSsbo The gfx numbers Ssbo.
-         * @param t_buildingIdsSsbo The Building Ids Ssbo.
-         * @param t_instancesToRender The number of instances to render.
+         * @param t_islands The indices of the visible islands.
+         * @param t_layerType COAST, TERRAIN, BUILDINGS or MIXED. MIXED renders the terrain composed with the buildings.
          * @param t_zoom The zoom to render for.
          * @param t_rotation The rotation to render for.
          */
-        void Render(
-            const layer::GameLayer::Model_Matrices_Ssbos_For_Each_zoom& t_modelMatricesSsbos,
-            const ogl::buffer::Ssbo& t_gfxNumbersSsbo,
-            const ogl::buffer::Ssbo& t_buildingIdsSsbo,
-            int32_t t_instancesToRender,
-            world::Zoom t_zoom,
-            world::Rotation t_rotation
-        ) const;
+        void RenderIslands(const std::vector<int32_t>& t_islands, layer::LayerType t_layerType, world::Zoom t_zoom, world::Rotation t_rotation) const;
 
         /**
-         * Renders a TerrainLayer with the specified zoom and rotation.
+         * Renders the deep water in the visible area with the specified zoom and rotation.
+         * The water tiles are generated in the shader, the island grid is used to skip the islands.
          *
-         * @param t_terrainLayer The TerrainLayer object.
+         * @param t_worldLayer The WorldLayer object.
          * @param t_zoom The zoom to render for.
          * @param t_rotation The rotation to render for.
          */
-        void Render(const layer::TerrainLayer& t_terrainLayer, world::Zoom t_zoom, world::Rotation t_rotation) const;
+        void RenderDeepWater(const layer::WorldLayer& t_worldLayer, world::Zoom t_zoom, world::Rotation t_rotation) const;
 
         //-------------------------------------------------
         // Remove / add building - Gpu
@@ -147,9 +159,9 @@ namespace mdcii::renderer
          * Deletes a building from the Gpu.
          *
          * @param t_island The Island object.
-         * @param t_tileIndices The Tile object indices of the building to delete.
+         * @param t_placedBuildingIndex The index of the building in the BuildingRegistry of the island.
          */
-        void DeleteBuildingFromGpu(world::Island& t_island, const std::vector<int32_t>& t_tileIndices);
+        void DeleteBuildingFromGpu(world::Island& t_island, int32_t t_placedBuildingIndex);
 
         /**
          * Adds a building to the Gpu.
@@ -192,20 +204,21 @@ namespace mdcii::renderer
         /**
          * Deletes a building from the Cpu.
          *
+         * @param t_island The Island object.
          * @param t_tile Tile object where building information should be deleted/overwritten.
          */
-        static void DeleteBuildingFromCpu(layer::Tile& t_tile);
+        static void DeleteBuildingFromCpu(world::Island& t_island, layer::Tile& t_tile);
 
         /**
-         * Deletes a building from the Cpu.
+         * Deletes a building from the Cpu and removes it from the BuildingRegistry of the island.
          *
          * @param t_island The Island object.
-         * @param t_tileIndices The tile indices of the building.
+         * @param t_placedBuildingIndex The index of the building in the BuildingRegistry of the island.
          */
-        static void DeleteBuildingFromCpu(world::Island& t_island, const std::vector<int32_t>& t_tileIndices);
+        static void DeleteBuildingFromCpu(world::Island& t_island, int32_t t_placedBuildingIndex);
 
         /**
-         * Adds a building to the Cpu.
+         * Adds a building to the Cpu and registers it in the BuildingRegistry of the island.
          *
          * @param t_terrain The Terrain object for access to the temp building tiles (tilesToAdd).
          */
@@ -243,6 +256,40 @@ namespace mdcii::renderer
          */
         static constexpr auto ANIMATIONS_BINDING{ 4 };
 
+        /**
+         * The number of the buildings modelMatrices shader binding.
+         */
+        static constexpr auto BUILDINGS_MODEL_MATRICES_BINDING{ 5 };
+
+        /**
+         * The number of the buildings gfxNumbers shader binding.
+         */
+        static constexpr auto BUILDINGS_GFX_NUMBERS_BINDING{ 6 };
+
+        /**
+         * The number of the buildings buildingIds shader binding.
+         */
+        static constexpr auto BUILDINGS_BUILDING_IDS_BINDING{ 7 };
+
+        /**
+         * The number of the island grid shader binding.
+         */
+        static constexpr auto ISLAND_GRID_BINDING{ 8 };
+
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        /**
+         * The Ssbos of one layer type, shared by all islands.
+         */
+        struct IslandBuffers
+        {
+            layer::GameLayer::Model_Matrices_Ssbos_For_Each_zoom modelMatricesSsbos;
+            std::unique_ptr<ogl::buffer::Ssbo> gfxNumbersSsbo;
+            std::unique_ptr<ogl::buffer::Ssbo> buildingIdsSsbo;
+        };
+
         //-------------------------------------------------
         // Member
         //-------------------------------------------------
@@ -273,14 +320,53 @@ namespace mdcii::renderer
         std::unique_ptr<ogl::buffer::Ssbo> m_animationSsbo;
 
         /**
-         * The number of updates.
+         * The shared Ssbos of the COAST, TERRAIN and BUILDINGS layers.
          */
-        int32_t m_updates{ 0 };
+        std::array<IslandBuffers, 3> m_islandBuffers;
 
         /**
-         * Counters to get animation frames.
+         * The instances of all islands and the draw commands of the visible islands.
          */
-        std::vector<int32_t> m_timeCounter{ 0, 0, 0, 0, 0 };
+        std::unique_ptr<IslandBatch> m_islandBatch;
+
+        /**
+         * The shader to render islands.
+         */
+        const ogl::resource::ShaderProgram* m_worldShaderProgram{ nullptr };
+
+        /**
+         * The shader to render the deep water.
+         */
+        const ogl::resource::ShaderProgram* m_waterShaderProgram{ nullptr };
+
+        /**
+         * The resolved uniforms of the water shader which change with the camera.
+         * All other values come from the FrameUniforms.
+         */
+        struct
+        {
+            ogl::resource::UniformHandle<int32_t> worldWidth;
+            ogl::resource::UniformHandle<int32_t> worldHeight;
+            ogl::resource::UniformHandle<int32_t> tileWidth;
+            ogl::resource::UniformHandle<int32_t> tileHeight;
+            ogl::resource::UniformHandle<glm::vec2> waterSize;
+            ogl::resource::UniformHandle<int32_t> minColumn;
+            ogl::resource::UniformHandle<int32_t> minRow;
+            ogl::resource::UniformHandle<int32_t> nrOfColumns;
+        } m_waterUniforms;
+
+        //-------------------------------------------------
+        // Island buffers
+        //-------------------------------------------------
+
+        /**
+         * Get the shared Ssbos of a layer type.
+         *
+         * @param t_layerType COAST, TERRAIN or BUILDINGS.
+         *
+         * @return The IslandBuffers object.
+         */
+        [[nodiscard]] const IslandBuffers& GetIslandBuffers(layer::LayerType t_layerType) const;
 
         //-------------------------------------------------
         // Init
@@ -291,6 +377,11 @@ namespace mdcii::renderer
          */
         void Init();
 
+        /**
+         * Loads the shaders, resolves their uniforms and sets the uniforms which never change.
+         */
+        void InitShaders();
+
         //-------------------------------------------------
         // Create buffers
         //-------------------------------------------------
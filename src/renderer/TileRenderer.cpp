@@ -63,7 +63,6 @@ void mdcii::renderer::TileRenderer::RenderTile(
     m_vao->Bind();
     ogl::resource::TextureUtils::BindForReading(t_textureId, GL_TEXTURE0);
     m_vao->DrawPrimitives();
-    ogl::buffer::Vao::Unbind();
 
     ogl::OpenGL::DisableBlending();
 }
@@ -90,7 +89,6 @@ void mdcii::renderer::TileRenderer::RenderTileForMousePicking(
     m_vao->Bind();
     ogl::resource::TextureUtils::BindForReading(t_textureId, GL_TEXTURE0);
     m_vao->DrawPrimitives();
-    ogl::buffer::Vao::Unbind();
 
     ogl::OpenGL::DisableBlending();
 }
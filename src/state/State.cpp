@@ -21,6 +21,7 @@
 #include "MdciiAssert.h"
 #include "ogl/Window.h"
 #include "ogl/OpenGL.h"
+#include "ogl/Device.h"
 #include "file/OriginalResourcesManager.h"
 
 //-------------------------------------------------
@@ -54,4 +55,5 @@ void mdcii::state::State::StartFrame()
 void mdcii::state::State::EndFrame() const
 {
     context->window->SwapBuffersAndCallEvents();
+    ogl::Device::Get().EndFrame();
 }
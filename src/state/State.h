@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include "StateId.h"
 
 //-------------------------------------------------
@@ -89,6 +90,11 @@ namespace mdcii::state
         std::shared_ptr<camera::Camera> camera;
         std::shared_ptr<file::OriginalResourcesManager> originalResourcesManager;
 
+        /**
+         * The map loaded by the HEADLESS_GAME state.
+         */
+        std::string headlessMapFilePath;
+
         StateStack* stateStack{ nullptr };
     };
 
@@ -147,6 +153,14 @@ namespace mdcii::state
         virtual void Render() = 0;
         virtual void RenderImGui() = 0;
 
+        /**
+         * Returns whether the State changes without input, e.g. by animations.
+         * The game loop only redraws idle States on events.
+         *
+         * @return True if the State must be redrawn every frame.
+         */
+        [[nodiscard]] virtual bool IsAnimating() const { return false; }
+
         //-------------------------------------------------
         // Frame
         //-------------------------------------------------
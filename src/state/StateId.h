@@ -34,6 +34,7 @@ namespace mdcii::state
         NEW_GAME,
         LOADED_GAME,
         EXAMPLE_GAME,
+        HEADLESS_GAME,
         ALL
     };
 }
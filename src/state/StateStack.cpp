@@ -16,9 +16,11 @@
 // along with this program; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
+#include <algorithm>
 #include "StateStack.h"
 #include "State.h"
 #include "MdciiAssert.h"
+#include "profiler/Profiler.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -69,6 +71,7 @@ void mdcii::state::StateStack::Input()
     // iterate from top to bottom
     for (auto itr{ m_stack.rbegin() }; itr != m_stack.rend(); ++itr)
     {
+        MDCII_PROFILE_SCOPE(magic_enum::enum_name((*itr)->GetStateId()))
         (*itr)->Input();
     }
 
@@ -80,16 +83,24 @@ void mdcii::state::StateStack::Update()
     // iterate from top to bottom
     for (auto itr{ m_stack.rbegin() }; itr != m_stack.rend(); ++itr)
     {
+        MDCII_PROFILE_SCOPE(magic_enum::enum_name((*itr)->GetStateId()))
         (*itr)->Update();
     }
 
     ApplyPendingChanges();
 }
 
+bool mdcii::state::StateStack::IsAnimating() const
+{
+    return std::any_of(m_stack.begin(), m_stack.end(), [](const auto& t_state) { return t_state->IsAnimating(); });
+}
+
 void mdcii::state::StateStack::Render() const
 {
     for (const auto& state : m_stack)
     {
+        MDCII_PROFILE_SCOPE(magic_enum::enum_name(state->GetStateId()))
+
         state->StartFrame();
 
         state->Render();
@@ -97,6 +97,11 @@ namespace mdcii::state
          */
         [[nodiscard]] bool IsEmpty() const { return m_stack.empty(); }
 
+        /**
+         * Returns whether any State on the stack is animating.
+         */
+        [[nodiscard]] bool IsAnimating() const;
+
         //-------------------------------------------------
         // Register
         //-------------------------------------------------
@@ -0,0 +1,80 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+//-------------------------------------------------
+// AnimationClock
+//-------------------------------------------------
+
+namespace mdcii::world
+{
+    /**
+     * Counters to get the animation frames of the buildings.
+     * The animation speeds of the buildings are finally defined.
+     * So after 90, 130, 150, 180, 220 milliseconds the next frame from the animation is used.
+     */
+    struct AnimationClock
+    {
+        /**
+         * The number of ticks until each counter is incremented. A tick takes approximately 16.7 milliseconds.
+         */
+        static constexpr std::array<int32_t, 5> TICKS_PER_FRAME{ 6, 8, 9, 11, 13 };
+
+        /**
+         * The counters are reset after an arbitrary specified number of ticks.
+         */
+        static constexpr int32_t MAX_TICKS{ 4096 };
+
+        /**
+         * The number of ticks.
+         */
+        int32_t ticks{ 0 };
+
+        /**
+         * Counters to get animation frames.
+         */
+        std::array<int32_t, TICKS_PER_FRAME.size()> timeCounter{};
+
+        /**
+         * Advances the clock by one tick.
+         */
+        void Tick()
+        {
+            for (std::size_t i{ 0 }; i < TICKS_PER_FRAME.size(); ++i)
+            {
+                if (ticks % TICKS_PER_FRAME[i] == 0)
+                {
+                    timeCounter[i]++;
+                }
+            }
+
+            ticks++;
+
+            if (ticks > MAX_TICKS)
+            {
+                ticks = 0;
+                timeCounter.fill(0);
+            }
+        }
+    };
+}
@@ -0,0 +1,191 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#include <cmath>
+#include <filesystem>
+#include "AutoSave.h"
+#include "Game.h"
+#include "World.h"
+#include "MdciiAssert.h"
+#include "Terrain.h"
+#include "file/SaveGame.h"
+#include "file/SaveGameJournal.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+mdcii::world::AutoSave::AutoSave(World* t_world)
+    : m_world{ t_world }
+    , m_interval{ Game::INI.Get<int>("autosave", "interval") }
+    , m_intervalTicks{ std::llround(m_interval / Game::FRAME_TIME) }
+    , m_filePath{ Game::RESOURCES_REL_PATH + Game::INI.Get<std::string>("autosave", "file") }
+    , m_rle{ Game::INI.Get<bool>("content", "save_game_rle") }
+    , m_maxJournalEntries{ static_cast<std::size_t>(Game::INI.Get<int>("autosave", "journal_max_entries")) }
+    , m_lastSave{ std::chrono::steady_clock::now() }
+{
+    Log::MDCII_LOG_DEBUG("[AutoSave::AutoSave()] Create AutoSave.");
+
+    MDCII_ASSERT(m_world, "[AutoSave::AutoSave()] Null pointer.")
+    MDCII_ASSERT(m_interval >= 0, "[AutoSave::AutoSave()] Invalid interval.")
+}
+
+mdcii::world::AutoSave::~AutoSave() noexcept
+{
+    Log::MDCII_LOG_DEBUG("[AutoSave::~AutoSave()] Destruct AutoSave.");
+
+    FinishSave();
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+bool mdcii::world::AutoSave::IsSaving() const
+{
+    return m_saving.valid() && m_saving.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+//-------------------------------------------------
+// Setter
+//-------------------------------------------------
+
+void mdcii::world::AutoSave::SetCheckpoint(const std::string& t_filePath, const uint64_t t_checkpointId, const std::size_t t_nrOfJournalEntries)
+{
+    m_checkpointFilePath = t_filePath;
+    m_checkpointId = t_checkpointId;
+    m_nrOfJournalEntries = t_nrOfJournalEntries;
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void mdcii::world::AutoSave::Update()
+{
+    if (m_saving.valid() && !IsSaving())
+    {
+        FinishSave();
+    }
+
+    if (m_interval == 0)
+    {
+        return;
+    }
+
+    if (++m_ticksSinceSave >= m_intervalTicks)
+    {
+        Log::MDCII_LOG_DEBUG("[AutoSave::Update()] Start autosave in file {}.", m_filePath);
+        SaveInBackground(m_filePath);
+    }
+}
+
+bool mdcii::world::AutoSave::SaveInBackground(const std::string& t_filePath)
+{
+    if (IsSaving())
+    {
+        Log::MDCII_LOG_WARN("[AutoSave::SaveInBackground()] A save is still running.");
+        return false;
+    }
+
+    FinishSave();
+    m_lastSave = std::chrono::steady_clock::now();
+    m_ticksSinceSave = 0;
+
+    if (t_filePath == m_checkpointFilePath && m_nrOfJournalEntries < m_maxJournalEntries && std::filesystem::exists(t_filePath))
+    {
+        SaveJournal();
+    }
+    else
+    {
+        SaveCheckpoint(t_filePath);
+    }
+
+    return true;
+}
+
+//-------------------------------------------------
+// Helper
+//-------------------------------------------------
+
+void mdcii::world::AutoSave::SaveCheckpoint(const std::string& t_filePath)
+{
+    // the snapshot only copies shared pointers, the tiles are copied on the next change
+    auto snapshot{ file::SaveGameWriter::CreateSnapshot(*m_world) };
+    // a new Id, so that no old journal of the same file can match the new savegame
+    snapshot.checkpointId = file::SaveGameWriter::CreateCheckpointId();
+
+    // the new savegame contains all changes
+    [[maybe_unused]] const auto changes{ file::SaveGameJournal::TakeChanges(*m_world->terrain) };
+
+    Log::MDCII_LOG_DEBUG("[AutoSave::SaveCheckpoint()] Snapshot of {} islands taken in {} us.",
+        snapshot.islands.size(),
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_lastSave).count()
+    );
+
+    m_checkpointFilePath = t_filePath;
+    m_checkpointId = snapshot.checkpointId;
+    m_nrOfJournalEntries = 0;
+
+    m_saving = m_threadPool.Submit([t_filePath, snapshot{ std::move(snapshot) }, rle{ m_rle }]() {
+        file::SaveGameWriter::WriteSnapshot(t_filePath, snapshot, rle);
+
+        // a remaining journal has the old checkpoint Id and would be ignored anyway
+        std::error_code errorCode;
+        std::filesystem::remove(file::SaveGameJournal::GetFilePath(t_filePath), errorCode);
+
+        Log::MDCII_LOG_DEBUG("[AutoSave::SaveCheckpoint()] The game has been successfully saved in file {}.", t_filePath);
+    });
+}
+
+void mdcii::world::AutoSave::SaveJournal()
+{
+    auto changes{ file::SaveGameJournal::TakeChanges(*m_world->terrain) };
+    if (changes.empty())
+    {
+        Log::MDCII_LOG_DEBUG("[AutoSave::SaveJournal()] Nothing has changed since the last save.");
+        return;
+    }
+
+    m_nrOfJournalEntries += changes.size();
+
+    m_saving = m_threadPool.Submit([filePath{ file::SaveGameJournal::GetFilePath(m_checkpointFilePath) }, checkpointId{ m_checkpointId }, changes{ std::move(changes) }]() {
+        file::SaveGameJournal::Append(filePath, checkpointId, changes);
+    });
+}
+
+void mdcii::world::AutoSave::FinishSave()
+{
+    if (!m_saving.valid())
+    {
+        return;
+    }
+
+    try
+    {
+        m_saving.get();
+    }
+    catch (const std::exception& t_exception)
+    {
+        Log::MDCII_LOG_ERROR("[AutoSave::FinishSave()] The game could not be saved: {}", t_exception.what());
+
+        // the changes may be lost, so the next savegame must contain all tiles
+        m_checkpointFilePath.clear();
+    }
+}
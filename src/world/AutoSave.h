@@ -0,0 +1,207 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <string>
+#include "ThreadPool.h"
+
+//-------------------------------------------------
+// AutoSave
+//-------------------------------------------------
+
+namespace mdcii::world
+{
+    /**
+     * Forward declaration class World.
+     */
+    class World;
+
+    /**
+     * Saves the world in the background.
+     *
+     * Only the snapshot of the savegame values is taken on the simulation thread.
+     * The file is written by a worker thread while the game continues.
+     * Saving again into the last full savegame (checkpoint) only appends the
+     * changed tiles to its journal until the journal gets too long.
+     */
+    class AutoSave
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        AutoSave() = delete;
+
+        /**
+         * Constructs a new AutoSave object.
+         *
+         * @param t_world The parent World object.
+         */
+        explicit AutoSave(World* t_world);
+
+        AutoSave(const AutoSave& t_other) = delete;
+        AutoSave(AutoSave&& t_other) noexcept = delete;
+        AutoSave& operator=(const AutoSave& t_other) = delete;
+        AutoSave& operator=(AutoSave&& t_other) noexcept = delete;
+
+        ~AutoSave() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * Checks whether a save is currently running.
+         *
+         * @return True or false.
+         */
+        [[nodiscard]] bool IsSaving() const;
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * Sets the loaded savegame as the current checkpoint.
+         *
+         * @param t_filePath The path to the savegame.
+         * @param t_checkpointId The checkpoint Id of the savegame.
+         * @param t_nrOfJournalEntries The number of replayed journal entries.
+         */
+        void SetCheckpoint(const std::string& t_filePath, uint64_t t_checkpointId, std::size_t t_nrOfJournalEntries);
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Collects a finished save and starts an autosave when the interval has elapsed.
+         * Called once per simulation tick, so the interval is counted in ticks.
+         */
+        void Update();
+
+        /**
+         * Takes a snapshot of the world and writes it in the background.
+         * Does nothing if a save is still running.
+         *
+         * @param t_filePath The path to the savegame file.
+         *
+         * @return True if the save has been started.
+         */
+        bool SaveInBackground(const std::string& t_filePath);
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The parent World object.
+         */
+        World* m_world{ nullptr };
+
+        /**
+         * The seconds between two autosaves. Zero disables the autosave.
+         */
+        int32_t m_interval{ 0 };
+
+        /**
+         * The number of simulation ticks between two autosaves.
+         */
+        int64_t m_intervalTicks{ 0 };
+
+        /**
+         * The number of simulation ticks since the last started save.
+         */
+        int64_t m_ticksSinceSave{ 0 };
+
+        /**
+         * The path to the autosave file.
+         */
+        std::string m_filePath;
+
+        /**
+         * Run-length encode the layers.
+         */
+        bool m_rle{ true };
+
+        /**
+         * The number of journal entries after which a full savegame is written.
+         */
+        std::size_t m_maxJournalEntries{ 0 };
+
+        /**
+         * The path to the last full savegame. Empty if the next save has to be a full one.
+         */
+        std::string m_checkpointFilePath;
+
+        /**
+         * The checkpoint Id of the last full savegame.
+         */
+        uint64_t m_checkpointId{ 0 };
+
+        /**
+         * The number of entries in the journal of the last full savegame.
+         */
+        std::size_t m_nrOfJournalEntries{ 0 };
+
+        /**
+         * The time of the last started save to log the duration of the snapshot.
+         */
+        std::chrono::steady_clock::time_point m_lastSave;
+
+        /**
+         * A single worker thread to write the savegame files.
+         */
+        ThreadPool m_threadPool{ 1 };
+
+        /**
+         * The result of the running save.
+         */
+        std::future<void> m_saving;
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Writes all tiles into a new savegame and removes the old journal.
+         *
+         * @param t_filePath The path to the savegame.
+         */
+        void SaveCheckpoint(const std::string& t_filePath);
+
+        /**
+         * Appends the changed tiles to the journal of the last full savegame.
+         */
+        void SaveJournal();
+
+        /**
+         * Waits for the running save and logs errors.
+         * After an error the next save is a full one.
+         */
+        void FinishSave();
+    };
+}
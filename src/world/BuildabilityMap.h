@@ -0,0 +1,286 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <vector>
+#include <glm/vec2.hpp>
+#include "MdciiException.h"
+
+//-------------------------------------------------
+// BuildabilityMap
+//-------------------------------------------------
+
+namespace mdcii::world
+{
+    //-------------------------------------------------
+    // BuildableCell
+    //-------------------------------------------------
+
+    /**
+     * What can be built on an island position.
+     */
+    enum class BuildableCell : uint8_t
+    {
+        BLOCKED, // no terrain or an existing building
+        LAND,    // free terrain with posoffs > 0
+        COAST    // free terrain with posoffs == 0, only for water related buildings
+    };
+
+    //-------------------------------------------------
+    // BuildabilityMap
+    //-------------------------------------------------
+
+    /**
+     * Stores the buildable cells of an island together with a summed-area table for each cell type,
+     * so that the number of free cells under any footprint can be read in constant time.
+     */
+    class BuildabilityMap
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        BuildabilityMap() = default;
+
+        BuildabilityMap(const BuildabilityMap& t_other) = delete;
+        BuildabilityMap(BuildabilityMap&& t_other) noexcept = delete;
+        BuildabilityMap& operator=(const BuildabilityMap& t_other) = delete;
+        BuildabilityMap& operator=(BuildabilityMap&& t_other) noexcept = delete;
+
+        ~BuildabilityMap() noexcept = default;
+
+        //-------------------------------------------------
+        // Init
+        //-------------------------------------------------
+
+        /**
+         * Creates the map and the summed-area tables.
+         *
+         * @param t_width The island width.
+         * @param t_height The island height.
+         * @param t_cells The type of each island position (row-major, width * height).
+         */
+        void Create(const int32_t t_width, const int32_t t_height, std::vector<BuildableCell> t_cells)
+        {
+            if (t_width < 0 || t_height < 0 || t_cells.size() != static_cast<size_t>(t_width) * t_height)
+            {
+                throw MDCII_EXCEPTION("[BuildabilityMap::Create()] Invalid size.");
+            }
+
+            m_width = t_width;
+            m_height = t_height;
+            m_cells = std::move(t_cells);
+
+            m_landTable.assign(static_cast<size_t>(m_width + 1) * (m_height + 1), 0);
+            m_coastTable.assign(static_cast<size_t>(m_width + 1) * (m_height + 1), 0);
+
+            for (auto y{ 0 }; y < m_height; ++y)
+            {
+                for (auto x{ 0 }; x < m_width; ++x)
+                {
+                    const auto cell{ m_cells[static_cast<size_t>(y) * m_width + x] };
+                    const auto topLeft{ GetTableIndex(x, y) };
+                    const auto top{ GetTableIndex(x + 1, y) };
+                    const auto left{ GetTableIndex(x, y + 1) };
+                    const auto index{ GetTableIndex(x + 1, y + 1) };
+
+                    m_landTable[index] = static_cast<int32_t>(cell == BuildableCell::LAND) + m_landTable[top] + m_landTable[left] - m_landTable[topLeft];
+                    m_coastTable[index] = static_cast<int32_t>(cell == BuildableCell::COAST) + m_coastTable[top] + m_coastTable[left] - m_coastTable[topLeft];
+                }
+            }
+
+            m_version++;
+        }
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * Get a number that changes whenever the map changes.
+         *
+         * @return The version of the map.
+         */
+        [[nodiscard]] uint32_t GetVersion() const { return m_version; }
+
+        /**
+         * Get the cell at an island position.
+         *
+         * @param t_x The island x position.
+         * @param t_y The island y position.
+         *
+         * @return The BuildableCell of the position or BLOCKED if the position is outside.
+         */
+        [[nodiscard]] BuildableCell Get(const int32_t t_x, const int32_t t_y) const
+        {
+            if (!IsInside(t_x, t_y, 1, 1))
+            {
+                return BuildableCell::BLOCKED;
+            }
+
+            return m_cells[static_cast<size_t>(t_y) * m_width + t_x];
+        }
+
+        /**
+         * Counts the cells of a type in a rectangle in constant time.
+         *
+         * @param t_cell The type of the cells to count. BLOCKED is not supported.
+         * @param t_position The top left island position of the rectangle.
+         * @param t_size The size of the rectangle.
+         *
+         * @return The number of cells.
+         */
+        [[nodiscard]] int32_t Count(const BuildableCell t_cell, const glm::ivec2& t_position, const glm::ivec2& t_size) const
+        {
+            if (t_cell == BuildableCell::BLOCKED)
+            {
+                throw MDCII_EXCEPTION("[BuildabilityMap::Count()] Blocked cells are not counted.");
+            }
+
+            const auto& table{ t_cell == BuildableCell::LAND ? m_landTable : m_coastTable };
+            const auto x0{ t_position.x };
+            const auto y0{ t_position.y };
+            const auto x1{ t_position.x + t_size.x };
+            const auto y1{ t_position.y + t_size.y };
+
+            return table[GetTableIndex(x1, y1)] - table[GetTableIndex(x0, y1)] - table[GetTableIndex(x1, y0)] + table[GetTableIndex(x0, y0)];
+        }
+
+        /**
+         * Checks whether a building fits into a rectangle.
+         *
+         * @param t_position The top left island position of the rotated footprint.
+         * @param t_size The size of the rotated footprint.
+         * @param t_waterRelated True if the building must touch the coast.
+         *
+         * @return True or false.
+         */
+        [[nodiscard]] bool IsBuildable(const glm::ivec2& t_position, const glm::ivec2& t_size, const bool t_waterRelated) const
+        {
+            if (!IsInside(t_position.x, t_position.y, t_size.x, t_size.y))
+            {
+                return false;
+            }
+
+            const auto area{ t_size.x * t_size.y };
+            const auto land{ Count(BuildableCell::LAND, t_position, t_size) };
+            if (!t_waterRelated)
+            {
+                return land == area;
+            }
+
+            // a water related building needs at least one coast cell, all other cells must be free
+            const auto coast{ Count(BuildableCell::COAST, t_position, t_size) };
+
+            return coast > 0 && land + coast == area;
+        }
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * Changes a cell and updates the summed-area tables below and to the right of it.
+         *
+         * @param t_x The island x position.
+         * @param t_y The island y position.
+         * @param t_cell The new type of the cell.
+         */
+        void Set(const int32_t t_x, const int32_t t_y, const BuildableCell t_cell)
+        {
+            if (!IsInside(t_x, t_y, 1, 1))
+            {
+                throw MDCII_EXCEPTION("[BuildabilityMap::Set()] Invalid position.");
+            }
+
+            auto& cell{ m_cells[static_cast<size_t>(t_y) * m_width + t_x] };
+            if (cell == t_cell)
+            {
+                return;
+            }
+
+            const auto landDelta{ static_cast<int32_t>(t_cell == BuildableCell::LAND) - static_cast<int32_t>(cell == BuildableCell::LAND) };
+            const auto coastDelta{ static_cast<int32_t>(t_cell == BuildableCell::COAST) - static_cast<int32_t>(cell == BuildableCell::COAST) };
+            cell = t_cell;
+            m_version++;
+
+            for (auto y{ t_y + 1 }; y <= m_height; ++y)
+            {
+                for (auto x{ t_x + 1 }; x <= m_width; ++x)
+                {
+                    m_landTable[GetTableIndex(x, y)] += landDelta;
+                    m_coastTable[GetTableIndex(x, y)] += coastDelta;
+                }
+            }
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The island width.
+         */
+        int32_t m_width{ 0 };
+
+        /**
+         * The island height.
+         */
+        int32_t m_height{ 0 };
+
+        /**
+         * The type of each island position (row-major, width * height).
+         */
+        std::vector<BuildableCell> m_cells;
+
+        /**
+         * The number of land cells above and left of each position ((width + 1) * (height + 1)).
+         */
+        std::vector<int32_t> m_landTable;
+
+        /**
+         * The number of coast cells above and left of each position ((width + 1) * (height + 1)).
+         */
+        std::vector<int32_t> m_coastTable;
+
+        /**
+         * Incremented on every change.
+         */
+        uint32_t m_version{ 0 };
+
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        [[nodiscard]] bool IsInside(const int32_t t_x, const int32_t t_y, const int32_t t_width, const int32_t t_height) const
+        {
+            return t_x >= 0 && t_y >= 0 && t_width > 0 && t_height > 0 && t_x + t_width <= m_width && t_y + t_height <= m_height;
+        }
+
+        [[nodiscard]] size_t GetTableIndex(const int32_t t_x, const int32_t t_y) const
+        {
+            return static_cast<size_t>(t_y) * (m_width + 1) + t_x;
+        }
+    };
+}
@@ -0,0 +1,237 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+#pragma once
+
+#include <vector>
+#include "Rotation.h"
+
+//-------------------------------------------------
+// BuildingRegistry
+//-------------------------------------------------
+
+namespace mdcii::world
+{
+    //-------------------------------------------------
+    // PlacedBuilding
+    //-------------------------------------------------
+
+    /**
+     * A building placed on an island.
+     */
+    struct PlacedBuilding
+    {
+        /**
+         * The Id of the building.
+         */
+        int32_t buildingId{ -1 };
+
+        /**
+         * The island position of the building part with the offset (0, 0).
+         */
+        glm::ivec2 origin{ -1 };
+
+        /**
+         * The rotation of the building.
+         */
+        Rotation rotation{ Rotation::DEG0 };
+
+        /**
+         * The unrotated size of the building.
+         */
+        glm::ivec2 size{ 0 };
+
+        /**
+         * Checks whether the entry is in use.
+         *
+         * @return True or false.
+         */
+        [[nodiscard]] bool IsValid() const { return buildingId >= 0; }
+    };
+
+    //-------------------------------------------------
+    // BuildingRegistry
+    //-------------------------------------------------
+
+    /**
+     * Stores the placed buildings of an island.
+     * A Tile only keeps the index of its building in this registry.
+     */
+    class BuildingRegistry
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * Marks a Tile without a registered building.
+         */
+        static constexpr auto NO_PLACED_BUILDING{ -1 };
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        BuildingRegistry() = default;
+
+        BuildingRegistry(const BuildingRegistry& t_other) = delete;
+        BuildingRegistry(BuildingRegistry&& t_other) noexcept = delete;
+        BuildingRegistry& operator=(const BuildingRegistry& t_other) = delete;
+        BuildingRegistry& operator=(BuildingRegistry&& t_other) noexcept = delete;
+
+        ~BuildingRegistry() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * Checks whether an index refers to a placed building.
+         *
+         * @param t_index The index to check.
+         *
+         * @return True or false.
+         */
+        [[nodiscard]] bool Contains(const int32_t t_index) const
+        {
+            return t_index >= 0 && t_index < static_cast<int32_t>(m_placedBuildings.size()) && m_placedBuildings[t_index].IsValid();
+        }
+
+        /**
+         * Get a placed building by index.
+         *
+         * @param t_index The index of the placed building.
+         *
+         * @return The PlacedBuilding object.
+         */
+        [[nodiscard]] const PlacedBuilding& Get(const int32_t t_index) const
+        {
+            if (!Contains(t_index))
+            {
+                throw MDCII_EXCEPTION("[BuildingRegistry::Get()] Invalid index " + std::to_string(t_index) + ".");
+            }
+
+            return m_placedBuildings[t_index];
+        }
+
+        /**
+         * Get the number of placed buildings.
+         *
+         * @return The number of placed buildings.
+         */
+        [[nodiscard]] int32_t GetNrOfPlacedBuildings() const
+        {
+            return static_cast<int32_t>(m_placedBuildings.size() - m_freeIndices.size());
+        }
+
+        /**
+         * Calculates the island positions covered by a placed building.
+         *
+         * @param t_placedBuilding The PlacedBuilding object.
+         *
+         * @return The island positions.
+         */
+        [[nodiscard]] static std::vector<glm::ivec2> GetFootprint(const PlacedBuilding& t_placedBuilding)
+        {
+            std::vector<glm::ivec2> positions;
+            positions.reserve(static_cast<size_t>(t_placedBuilding.size.x) * t_placedBuilding.size.y);
+
+            for (auto y{ 0 }; y < t_placedBuilding.size.y; ++y)
+            {
+                for (auto x{ 0 }; x < t_placedBuilding.size.x; ++x)
+                {
+                    auto rp{ rotate_position(x, y, t_placedBuilding.size.y, t_placedBuilding.size.x, t_placedBuilding.rotation) };
+                    if (t_placedBuilding.rotation == Rotation::DEG0 || t_placedBuilding.rotation == Rotation::DEG180)
+                    {
+                        rp = rotate_position(x, y, t_placedBuilding.size.x, t_placedBuilding.size.y, t_placedBuilding.rotation);
+                    }
+
+                    positions.emplace_back(t_placedBuilding.origin + rp);
+                }
+            }
+
+            return positions;
+        }
+
+        //-------------------------------------------------
+        // Add / remove
+        //-------------------------------------------------
+
+        /**
+         * Registers a placed building. Indices of removed buildings are reused.
+         *
+         * @param t_placedBuilding The PlacedBuilding object.
+         *
+         * @return The index of the placed building.
+         */
+        int32_t Add(const PlacedBuilding& t_placedBuilding)
+        {
+            if (!t_placedBuilding.IsValid())
+            {
+                throw MDCII_EXCEPTION("[BuildingRegistry::Add()] Invalid building Id.");
+            }
+
+            if (m_freeIndices.empty())
+            {
+                m_placedBuildings.push_back(t_placedBuilding);
+
+                return static_cast<int32_t>(m_placedBuildings.size()) - 1;
+            }
+
+            const auto index{ m_freeIndices.back() };
+            m_freeIndices.pop_back();
+            m_placedBuildings[index] = t_placedBuilding;
+
+            return index;
+        }
+
+        /**
+         * Unregisters a placed building.
+         *
+         * @param t_index The index of the placed building.
+         */
+        void Remove(const int32_t t_index)
+        {
+            if (!Contains(t_index))
+            {
+                throw MDCII_EXCEPTION("[BuildingRegistry::Remove()] Invalid index " + std::to_string(t_index) + ".");
+            }
+
+            m_placedBuildings[t_index] = PlacedBuilding();
+            m_freeIndices.push_back(t_index);
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The placed buildings. Removed entries are invalid until reused.
+         */
+        std::vector<PlacedBuilding> m_placedBuildings;
+
+        /**
+         * The indices of removed entries.
+         */
+        std::vector<int32_t> m_freeIndices;
+    };
+}
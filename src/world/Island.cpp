@@ -22,7 +22,11 @@
 #include "Terrain.h"
 #include "layer/TerrainLayer.h"
 #include "layer/GridLayer.h"
+#include "data/Buildings.h"
 #include "physics/Aabb.h"
+#include "file/OriginalResourcesManager.h"
+#include "file/SaveGame.h"
+#include "file/JsonMapReader.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -53,46 +57,56 @@ mdcii::world::Island::~Island() noexcept
 // Init
 //-------------------------------------------------
 
-void mdcii::world::Island::InitValuesFromJson(const nlohmann::json& t_json)
+void mdcii::world::Island::InitValuesFromJsonMap(file::JsonMapIsland& t_jsonMapIsland)
 {
-    Log::MDCII_LOG_DEBUG("[Island::InitValuesFromJson()] Start initialize an island...");
+    Log::MDCII_LOG_DEBUG("[Island::InitValuesFromJsonMap()] Start initialize an island...");
 
-    for (const auto& [k, v] : t_json.items())
-    {
-        if (k == "width")
-        {
-            width = v.get<int32_t>();
-        }
-        if (k == "height")
-        {
-            height = v.get<int32_t>();
-        }
-        if (k == "x")
-        {
-            startWorldX = v.get<int32_t>();
-        }
-        if (k == "y")
-        {
-            startWorldY = v.get<int32_t>();
-        }
-    }
+    width = t_jsonMapIsland.width;
+    height = t_jsonMapIsland.height;
+    startWorldX = t_jsonMapIsland.x;
+    startWorldY = t_jsonMapIsland.y;
 
-    MDCII_ASSERT(width > 0, "[Island::InitValuesFromJson()] Invalid width.")
-    MDCII_ASSERT(height > 0, "[Island::InitValuesFromJson()] Invalid height.")
-    MDCII_ASSERT(startWorldX >= 0, "[Island::InitValuesFromJson()] Invalid start world x.")
-    MDCII_ASSERT(startWorldY >= 0, "[Island::InitValuesFromJson()] Invalid start world y.")
+    CreateAabb();
 
-    aabb = std::make_unique<physics::Aabb>(glm::ivec2(startWorldX, startWorldY), glm::ivec2(width, height));
+    coastLayer = std::make_unique<layer::TerrainLayer>(m_context, m_terrain->world, this, layer::LayerType::COAST);
+    coastLayer->SetTiles(std::move(t_jsonMapIsland.coastTiles));
 
-    for (const auto& [k, v] : t_json.items())
-    {
-        if (k == "layers")
-        {
-            CreateLayersFromJson(v);
-        }
-    }
+    terrainLayer = std::make_unique<layer::TerrainLayer>(m_context, m_terrain->world, this, layer::LayerType::TERRAIN);
+    terrainLayer->SetTiles(std::move(t_jsonMapIsland.terrainTiles));
+
+    buildingsLayer = std::make_unique<layer::TerrainLayer>(m_context, m_terrain->world, this, layer::LayerType::BUILDINGS);
+    buildingsLayer->SetTiles(std::move(t_jsonMapIsland.buildingsTiles));
+
+    gridLayer = std::make_unique<layer::GridLayer>(m_context, m_terrain->world);
+
+    Log::MDCII_LOG_DEBUG("[Island::InitValuesFromJsonMap()] The island have been initialized successfully.");
+}
+
+void mdcii::world::Island::InitValuesFromSaveGame(file::SaveGameReader& t_reader)
+{
+    Log::MDCII_LOG_DEBUG("[Island::InitValuesFromSaveGame()] Start initialize an island...");
+
+    const auto saveGameIsland{ t_reader.ReadIsland() };
+    width = saveGameIsland.width;
+    height = saveGameIsland.height;
+    startWorldX = saveGameIsland.x;
+    startWorldY = saveGameIsland.y;
+
+    CreateAabb();
+
+    // the tiles are read directly into the layers
+    coastLayer = std::make_unique<layer::TerrainLayer>(m_context, m_terrain->world, this, layer::LayerType::COAST);
+    t_reader.ReadLayer(*coastLayer);
+
+    terrainLayer = std::make_unique<layer::TerrainLayer>(m_context, m_terrain->world, this, layer::LayerType::TERRAIN);
+    t_reader.ReadLayer(*terrainLayer);
+
+    buildingsLayer = std::make_unique<layer::TerrainLayer>(m_context, m_terrain->world, this, layer::LayerType::BUILDINGS);
+    t_reader.ReadLayer(*buildingsLayer);
+
+    gridLayer = std::make_unique<layer::GridLayer>(m_context, m_terrain->world);
 
-    Log::MDCII_LOG_DEBUG("[Island::InitValuesFromJson()] The island have been initialized successfully.");
+    Log::MDCII_LOG_DEBUG("[Island::InitValuesFromSaveGame()] The island have been initialized successfully.");
 }
 
 //-------------------------------------------------
@@ -113,6 +127,125 @@ glm::ivec2 mdcii::world::Island::GetIslandPositionFromWorldPosition(const glm::i
     return { t_position.x - startWorldX, t_position.y - startWorldY };
 }
 
+std::vector<int32_t> mdcii::world::Island::GetTileIndicesOfPlacedBuilding(const int32_t t_placedBuildingIndex) const
+{
+    std::vector<int32_t> tileIndices;
+    for (const auto& position : BuildingRegistry::GetFootprint(buildingRegistry.Get(t_placedBuildingIndex)))
+    {
+        tileIndices.push_back(buildingsLayer->GetMapIndex(position, Rotation::DEG0));
+    }
+
+    return tileIndices;
+}
+
+bool mdcii::world::Island::IsBuildable(const glm::ivec2& t_position, const data::Building& t_building, const Rotation t_buildingRotation) const
+{
+    // the rotated footprint is a rectangle with the origin at the top left
+    glm::ivec2 size{ t_building.size.w, t_building.size.h };
+    if (t_buildingRotation == Rotation::DEG90 || t_buildingRotation == Rotation::DEG270)
+    {
+        size = { t_building.size.h, t_building.size.w };
+    }
+
+    return buildabilityMap.IsBuildable(t_position, size, data::WATER_RELATED_BUILDING_IDS.count(t_building.id) > 0);
+}
+
+//-------------------------------------------------
+// Buildability
+//-------------------------------------------------
+
+void mdcii::world::Island::UpdateBuildabilityMap(const int32_t t_x, const int32_t t_y)
+{
+    buildabilityMap.Set(t_x, t_y, CalcBuildableCell(t_x, t_y));
+}
+
+void mdcii::world::Island::UpdateBuildableHighlights(const data::Building& t_building, const Rotation t_buildingRotation, const Zoom t_zoom, const Rotation t_rotation)
+{
+    const std::array<int64_t, 5> key{
+        t_building.id,
+        magic_enum::enum_integer(t_buildingRotation),
+        magic_enum::enum_integer(t_zoom),
+        magic_enum::enum_integer(t_rotation),
+        buildabilityMap.GetVersion()
+    };
+
+    if (key == m_highlightsKey)
+    {
+        return;
+    }
+
+    m_highlightsKey = key;
+
+    std::vector<bool> highlights(static_cast<size_t>(width) * height, false);
+    for (auto y{ 0 }; y < height; ++y)
+    {
+        for (auto x{ 0 }; x < width; ++x)
+        {
+            highlights[static_cast<size_t>(y) * width + x] = IsBuildable({ x, y }, t_building, t_buildingRotation);
+        }
+    }
+
+    gridLayer->StoreHighlightsInGpu(highlights, t_zoom, t_rotation);
+}
+
+//-------------------------------------------------
+// Prepare rendering
+//-------------------------------------------------
+
+void mdcii::world::Island::PrepareGridLayerCpuData()
+{
+    MDCII_ASSERT(!terrainLayer->sortedTiles.at(0).empty(), "[Island::PrepareGridLayerCpuData()] Missing terrain Cpu data.")
+
+    gridLayer->width = width;
+    gridLayer->height = height;
+    gridLayer->sortedTiles = terrainLayer->sortedTiles;
+    gridLayer->PrepareCpuDataForRendering();
+}
+
+void mdcii::world::Island::CreateBuildingRegistry()
+{
+    // a building is identified by the island position of its part with the offset (0, 0)
+    std::vector<int32_t> placedBuildingIndices(static_cast<size_t>(width) * height, BuildingRegistry::NO_PLACED_BUILDING);
+
+    for (const auto& tile : buildingsLayer->tiles)
+    {
+        if (!tile || !tile->HasBuilding())
+        {
+            continue;
+        }
+
+        const glm::ivec2 origin{ tile->islandXDeg0 - tile->x, tile->islandYDeg0 - tile->y };
+        MDCII_ASSERT(origin.x >= 0 && origin.x < width && origin.y >= 0 && origin.y < height, "[Island::CreateBuildingRegistry()] Invalid building origin.")
+
+        auto& placedBuildingIndex{ placedBuildingIndices.at(buildingsLayer->GetMapIndex(origin, Rotation::DEG0)) };
+        if (placedBuildingIndex == BuildingRegistry::NO_PLACED_BUILDING)
+        {
+            const auto& building{ m_context->originalResourcesManager->GetBuildingById(tile->buildingId) };
+            placedBuildingIndex = buildingRegistry.Add({ tile->buildingId, origin, tile->rotation, { building.size.w, building.size.h } });
+        }
+
+        tile->placedBuildingIndex = placedBuildingIndex;
+    }
+
+    Log::MDCII_LOG_DEBUG("[Island::CreateBuildingRegistry()] Registered {} buildings.", buildingRegistry.GetNrOfPlacedBuildings());
+}
+
+void mdcii::world::Island::CreateBuildabilityMap()
+{
+    std::vector<BuildableCell> cells;
+    cells.reserve(static_cast<size_t>(width) * height);
+
+    for (auto y{ 0 }; y < height; ++y)
+    {
+        for (auto x{ 0 }; x < width; ++x)
+        {
+            cells.push_back(CalcBuildableCell(x, y));
+        }
+    }
+
+    buildabilityMap.Create(width, height, std::move(cells));
+}
+
 //-------------------------------------------------
 // Render
 //-------------------------------------------------
@@ -126,87 +259,39 @@ void mdcii::world::Island::RenderImGui() const
 }
 
 //-------------------------------------------------
-// Layer
+// Init
 //-------------------------------------------------
 
-void mdcii::world::Island::CreateLayersFromJson(const nlohmann::json& t_json)
+void mdcii::world::Island::CreateAabb()
 {
-    Log::MDCII_LOG_DEBUG("[Island::CreateLayersFromJson()] Create the Layer objects.");
+    MDCII_ASSERT(width > 0, "[Island::CreateAabb()] Invalid width.")
+    MDCII_ASSERT(height > 0, "[Island::CreateAabb()] Invalid height.")
+    MDCII_ASSERT(startWorldX >= 0, "[Island::CreateAabb()] Invalid start world x.")
+    MDCII_ASSERT(startWorldY >= 0, "[Island::CreateAabb()] Invalid start world y.")
 
-    for (const auto& [k, v] : t_json.items())
-    {
-        for (const auto& [layerNameJson, layerTilesJson] : v.items())
-        {
-            if (layerNameJson == "coast")
-            {
-                coastLayer = std::make_unique<layer::TerrainLayer>(m_context, m_terrain->world, this, layer::LayerType::COAST);
-                coastLayer->CreateTilesFromJson(layerTilesJson);
-                coastLayer->PrepareCpuDataForRendering();
-                coastLayer->PrepareGpuDataForRendering();
-            }
-
-            if (layerNameJson == "terrain")
-            {
-                terrainLayer = std::make_unique<layer::TerrainLayer>(m_context, m_terrain->world, this, layer::LayerType::TERRAIN);
-                terrainLayer->CreateTilesFromJson(layerTilesJson);
-                terrainLayer->PrepareCpuDataForRendering();
-                terrainLayer->PrepareGpuDataForRendering();
-            }
-
-            if (layerNameJson == "buildings")
-            {
-                buildingsLayer = std::make_unique<layer::TerrainLayer>(m_context, m_terrain->world, this, layer::LayerType::BUILDINGS);
-                buildingsLayer->CreateTilesFromJson(layerTilesJson);
-                buildingsLayer->PrepareCpuDataForRendering();
-                buildingsLayer->PrepareGpuDataForRendering();
-            }
-        }
-    }
+    aabb = std::make_unique<physics::Aabb>(glm::ivec2(startWorldX, startWorldY), glm::ivec2(width, height));
+}
 
-    MDCII_ASSERT(terrainLayer, "[Island::CreateLayersFromJson()] Null pointer.")
-    MDCII_ASSERT(buildingsLayer, "[Island::CreateLayersFromJson()] Null pointer.")
+//-------------------------------------------------
+// Buildability
+//-------------------------------------------------
 
-    mixedLayer = std::make_unique<layer::TerrainLayer>(m_context, m_terrain->world, this, layer::LayerType::MIXED);
-    mixedLayer->instancesToRender = terrainLayer->instancesToRender;
-    mixedLayer->modelMatrices = terrainLayer->modelMatrices;
-    mixedLayer->gfxNumbers = terrainLayer->gfxNumbers;
-    mixedLayer->buildingIds = terrainLayer->buildingIds;
+mdcii::world::BuildableCell mdcii::world::Island::CalcBuildableCell(const int32_t t_x, const int32_t t_y) const
+{
+    const auto& terrainTile{ terrainLayer->GetTile(t_x, t_y) };
+    const auto& buildingTile{ buildingsLayer->GetTile(t_x, t_y) };
 
-    magic_enum::enum_for_each<Zoom>([this](const Zoom t_zoom) {
-        magic_enum::enum_for_each<Rotation>([this, &t_zoom](const Rotation t_rotation) {
-            const auto z{ magic_enum::enum_integer(t_zoom) };
-            const auto r{ magic_enum::enum_integer(t_rotation) };
-
-            auto& mt{ mixedLayer->modelMatrices.at(z).at(r) };
-            const auto& mb{ buildingsLayer->modelMatrices.at(z).at(r) };
-
-            auto& gt{ mixedLayer->gfxNumbers };
-            const auto& gb{ buildingsLayer->gfxNumbers };
-
-            auto& bt{ mixedLayer->buildingIds };
-            const auto& bb{ buildingsLayer->buildingIds };
-
-            auto instance{ 0 };
-            for (const auto& mapTile : buildingsLayer->sortedTiles.at(r))
-            {
-                if (mapTile->HasBuilding())
-                {
-                    mt.at(instance) = mb.at(instance);
-                    gt.at(instance)[r] = gb.at(instance)[r];
-                    bt.at(instance)[r] = bb.at(instance)[r];
-                }
-
-                instance++;
-            }
-        });
-    });
+    if (!terrainTile.HasBuilding() || buildingTile.HasBuilding())
+    {
+        return BuildableCell::BLOCKED;
+    }
 
-    mixedLayer->PrepareGpuDataForRendering();
+    if (m_context->originalResourcesManager->GetBuildingById(terrainTile.buildingId).posoffs == 0)
+    {
+        return BuildableCell::COAST;
+    }
 
-    gridLayer = std::make_unique<layer::GridLayer>(m_context, m_terrain->world);
-    gridLayer->sortedTiles = terrainLayer->sortedTiles;
-    gridLayer->PrepareCpuDataForRendering();
-    gridLayer->PrepareGpuDataForRendering();
+    return BuildableCell::LAND;
 }
 
 //-------------------------------------------------
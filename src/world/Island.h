@@ -19,6 +19,8 @@
 #pragma once
 
 #include "layer/Tile.h"
+#include "BuildingRegistry.h"
+#include "BuildabilityMap.h"
 
 //-------------------------------------------------
 // Forward declarations
@@ -32,6 +34,27 @@ namespace mdcii::state
     struct Context;
 }
 
+namespace mdcii::file
+{
+    /**
+     * Forward declaration class SaveGameReader.
+     */
+    class SaveGameReader;
+
+    /**
+     * Forward declaration struct JsonMapIsland.
+     */
+    struct JsonMapIsland;
+}
+
+namespace mdcii::data
+{
+    /**
+     * Forward declaration struct Building.
+     */
+    struct Building;
+}
+
 namespace mdcii::physics
 {
     /**
@@ -133,14 +156,19 @@ namespace mdcii::world
         std::unique_ptr<layer::TerrainLayer> buildingsLayer;
 
         /**
-         * A Layer object combining terrainLayer and buildingsLayer.
+         * A Layer object to show a grid of the terrain.
          */
-        std::unique_ptr<layer::TerrainLayer> mixedLayer;
+        std::unique_ptr<layer::GridLayer> gridLayer;
 
         /**
-         * A Layer object to show a grid of the terrain.
+         * The buildings placed on this island.
          */
-        std::unique_ptr<layer::GridLayer> gridLayer;
+        BuildingRegistry buildingRegistry;
+
+        /**
+         * The buildable positions of this island.
+         */
+        BuildabilityMap buildabilityMap;
 
         /**
          * Pointer to the currently selected Tile object.
@@ -178,11 +206,20 @@ namespace mdcii::world
         //-------------------------------------------------
 
         /**
-         * Initializes this Island from a Json value.
+         * Initializes this Island from an island of a Json map.
+         * The Layer objects are created, but not yet prepared for rendering.
          *
-         * @param t_json The Json value.
+         * @param t_jsonMapIsland The island read from the Json map. The Tile objects are moved.
          */
-        void InitValuesFromJson(const nlohmann::json& t_json);
+        void InitValuesFromJsonMap(file::JsonMapIsland& t_jsonMapIsland);
+
+        /**
+         * Initializes this Island from the next island of a savegame.
+         * The Layer objects are created, but not yet prepared for rendering.
+         *
+         * @param t_reader The SaveGameReader object.
+         */
+        void InitValuesFromSaveGame(file::SaveGameReader& t_reader);
 
         //-------------------------------------------------
         // Getter
@@ -206,6 +243,71 @@ namespace mdcii::world
          */
         [[nodiscard]] glm::ivec2 GetIslandPositionFromWorldPosition(const glm::ivec2& t_position) const;
 
+        /**
+         * Get the buildingsLayer Tile indices covered by a placed building.
+         *
+         * @param t_placedBuildingIndex The index of the building in the buildingRegistry.
+         *
+         * @return The Tile indices.
+         */
+        [[nodiscard]] std::vector<int32_t> GetTileIndicesOfPlacedBuilding(int32_t t_placedBuildingIndex) const;
+
+        /**
+         * Checks whether a building can be created at an island position in constant time.
+         *
+         * @param t_position The island position of the building part with the offset (0, 0).
+         * @param t_building The building to add.
+         * @param t_buildingRotation The rotation of the building.
+         *
+         * @return True or false.
+         */
+        [[nodiscard]] bool IsBuildable(const glm::ivec2& t_position, const data::Building& t_building, Rotation t_buildingRotation) const;
+
+        //-------------------------------------------------
+        // Buildability
+        //-------------------------------------------------
+
+        /**
+         * Updates the buildabilityMap at an island position after a building was added or removed.
+         *
+         * @param t_x The island x position.
+         * @param t_y The island y position.
+         */
+        void UpdateBuildabilityMap(int32_t t_x, int32_t t_y);
+
+        /**
+         * Marks all positions where a building can be created in the gridLayer.
+         * Does nothing if neither the building nor the island has changed since the last call.
+         *
+         * @param t_building The building to add.
+         * @param t_buildingRotation The rotation of the building.
+         * @param t_zoom The current zoom.
+         * @param t_rotation The current world rotation.
+         */
+        void UpdateBuildableHighlights(const data::Building& t_building, Rotation t_buildingRotation, Zoom t_zoom, Rotation t_rotation);
+
+        //-------------------------------------------------
+        // Prepare rendering
+        //-------------------------------------------------
+
+        /**
+         * Prepares the gridLayer.
+         * The Cpu data of the terrainLayer must be prepared before.
+         */
+        void PrepareGridLayerCpuData();
+
+        /**
+         * Registers the buildings of the buildingsLayer in the buildingRegistry.
+         * The Cpu data of the buildingsLayer must be prepared before.
+         */
+        void CreateBuildingRegistry();
+
+        /**
+         * Creates the buildabilityMap.
+         * The Cpu data of the terrainLayer and the buildingsLayer must be prepared before.
+         */
+        void CreateBuildabilityMap();
+
         //-------------------------------------------------
         // Render
         //-------------------------------------------------
@@ -232,16 +334,33 @@ namespace mdcii::world
          */
         Terrain* m_terrain{ nullptr };
 
+        /**
+         * The building Id, building rotation, zoom, world rotation and buildabilityMap version of the last highlights.
+         */
+        std::array<int64_t, 5> m_highlightsKey{ -1, -1, -1, -1, -1 };
+
         //-------------------------------------------------
-        // Layer
+        // Init
+        //-------------------------------------------------
+
+        /**
+         * Checks the island values and creates the Aabb.
+         */
+        void CreateAabb();
+
+        //-------------------------------------------------
+        // Buildability
         //-------------------------------------------------
 
         /**
-         * Creates the Layer objects from a Json value.
+         * Determines what can be built at an island position.
+         *
+         * @param t_x The island x position.
+         * @param t_y The island y position.
          *
-         * @param t_json The Json value.
+         * @return The BuildableCell of the position.
          */
-        void CreateLayersFromJson(const nlohmann::json& t_json);
+        [[nodiscard]] BuildableCell CalcBuildableCell(int32_t t_x, int32_t t_y) const;
     };
 
     //-------------------------------------------------
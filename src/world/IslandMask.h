@@ -0,0 +1,661 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <queue>
+#include <vector>
+#include <glm/vec2.hpp>
+#include "Rotation.h"
+#include "CounterRng.h"
+#include "MdciiException.h"
+
+//-------------------------------------------------
+// IslandMask
+//-------------------------------------------------
+
+namespace mdcii::world
+{
+    /**
+     * The kind of tile that a position of an island needs.
+     */
+    enum class IslandTileType : uint8_t
+    {
+        WATER,               // No tile, the deep water of the world.
+        COAST_WATER,         // The second water ring around the land.
+        COAST,               // A straight coast.
+        COAST_CORNER,        // An outer corner of the coast.
+        COAST_CORNER_INSIDE, // An inner corner of the coast.
+        BANK,                // A straight bank.
+        BANK_CORNER,         // An outer corner of the bank.
+        BANK_CORNER_INSIDE,  // An inner corner of the bank.
+        LAND,                // Land without water around.
+        INVALID              // There is no tile for the neighborhood.
+    };
+
+    /**
+     * The tile type and rotation at a position of an island.
+     */
+    struct IslandTile
+    {
+        IslandTileType type{ IslandTileType::WATER };
+        Rotation rotation{ Rotation::DEG0 };
+    };
+
+    /**
+     * Creates the natural shape of an island from noise.
+     *
+     * The land is created in cells of 2x2 tiles, so that each bank and coast
+     * has a matching tile. The tile types are then derived from the eight neighbors
+     * of each position (autotiling) with a lookup table.
+     */
+    class IslandMask
+    {
+    public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * The width and height of a land cell in tiles.
+         */
+        static constexpr auto CELL_SIZE{ 2 };
+
+        /**
+         * The water tiles around the land: coast and coast water.
+         */
+        static constexpr auto WATER_MARGIN{ 2 };
+
+        /**
+         * The noise frequency per cell.
+         */
+        static constexpr auto NOISE_FREQUENCY{ 0.3f };
+
+        /**
+         * The number of noise octaves.
+         */
+        static constexpr auto NOISE_OCTAVES{ 3 };
+
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The width of the island.
+         */
+        int32_t width{ -1 };
+
+        /**
+         * The height of the island.
+         */
+        int32_t height{ -1 };
+
+        /**
+         * The tile type of each position.
+         */
+        std::vector<IslandTile> tiles;
+
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        IslandMask() = delete;
+
+        /**
+         * Constructs a new IslandMask object.
+         *
+         * @param t_width The width of the island.
+         * @param t_height The height of the island.
+         * @param t_rng The random numbers of the island.
+         */
+        IslandMask(const int32_t t_width, const int32_t t_height, CounterRng& t_rng)
+            : width{ t_width }
+            , height{ t_height }
+            , m_cellsX{ (t_width + CELL_SIZE - 1) / CELL_SIZE }
+            , m_cellsY{ (t_height + CELL_SIZE - 1) / CELL_SIZE }
+        {
+            if (width < CELL_SIZE + 2 * WATER_MARGIN || height < CELL_SIZE + 2 * WATER_MARGIN)
+            {
+                throw MDCII_EXCEPTION("[IslandMask::IslandMask()] The island is too small.");
+            }
+
+            CreateCells(t_rng);
+            CreateTiles();
+        }
+
+        IslandMask(const IslandMask& t_other) = delete;
+        IslandMask(IslandMask&& t_other) noexcept = delete;
+        IslandMask& operator=(const IslandMask& t_other) = delete;
+        IslandMask& operator=(IslandMask&& t_other) noexcept = delete;
+
+        ~IslandMask() noexcept = default;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * Get the tile type of a position.
+         *
+         * @param t_x The x position.
+         * @param t_y The y position.
+         *
+         * @return The IslandTile object.
+         */
+        [[nodiscard]] const IslandTile& GetTile(const int32_t t_x, const int32_t t_y) const
+        {
+            return tiles.at(static_cast<size_t>(t_y) * width + t_x);
+        }
+
+        //-------------------------------------------------
+        // Sampling
+        //-------------------------------------------------
+
+        /**
+         * Samples land positions with a min distance to each other (blue noise).
+         * The positions are drawn in random order and each is kept
+         * if there is no kept position nearby.
+         *
+         * @param t_minDistance The min distance between two positions.
+         * @param t_rng The random numbers of the island.
+         *
+         * @return The land positions.
+         */
+        [[nodiscard]] std::vector<glm::ivec2> SampleLand(const float t_minDistance, CounterRng& t_rng) const
+        {
+            std::vector<int32_t> candidates;
+            for (auto i{ 0 }; i < static_cast<int32_t>(tiles.size()); ++i)
+            {
+                if (tiles[i].type == IslandTileType::LAND)
+                {
+                    candidates.push_back(i);
+                }
+            }
+
+            for (auto i{ static_cast<int32_t>(candidates.size()) - 1 }; i > 0; --i)
+            {
+                std::swap(candidates[i], candidates[t_rng.NextInt(0, i)]);
+            }
+
+            const auto radius{ static_cast<int32_t>(std::ceil(t_minDistance)) };
+            const auto minDistanceSquared{ t_minDistance * t_minDistance };
+
+            std::vector<uint8_t> taken(tiles.size(), 0);
+            std::vector<glm::ivec2> positions;
+            for (const auto index : candidates)
+            {
+                const auto x{ index % width };
+                const auto y{ index / width };
+
+                auto free{ true };
+                for (auto dy{ -radius }; dy <= radius && free; ++dy)
+                {
+                    for (auto dx{ -radius }; dx <= radius && free; ++dx)
+                    {
+                        const auto nx{ x + dx };
+                        const auto ny{ y + dy };
+                        if (nx >= 0 && ny >= 0 && nx < width && ny < height &&
+                            static_cast<float>(dx * dx + dy * dy) < minDistanceSquared &&
+                            taken[static_cast<size_t>(ny) * width + nx])
+                        {
+                            free = false;
+                        }
+                    }
+                }
+
+                if (free)
+                {
+                    taken[index] = 1;
+                    positions.emplace_back(x, y);
+                }
+            }
+
+            return positions;
+        }
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The number of cells in x direction.
+         */
+        int32_t m_cellsX{ 0 };
+
+        /**
+         * The number of cells in y direction.
+         */
+        int32_t m_cellsY{ 0 };
+
+        /**
+         * One for each land cell.
+         */
+        std::vector<uint8_t> m_cells;
+
+        //-------------------------------------------------
+        // Noise
+        //-------------------------------------------------
+
+        /**
+         * Smooth value noise.
+         *
+         * @param t_noise The random values of the lattice.
+         * @param t_x The x position.
+         * @param t_y The y position.
+         *
+         * @return A value between -1 and 1.
+         */
+        static float ValueNoise(const CounterRng& t_noise, const float t_x, const float t_y)
+        {
+            const auto lattice{ [&t_noise](const int32_t t_ix, const int32_t t_iy) {
+                const auto key{ static_cast<uint64_t>(static_cast<uint32_t>(t_ix)) << 32 | static_cast<uint32_t>(t_iy) };
+                return static_cast<float>(t_noise.At(key) >> 40) / static_cast<float>(1ull << 23) - 1.0f;
+            } };
+
+            const auto ix{ static_cast<int32_t>(std::floor(t_x)) };
+            const auto iy{ static_cast<int32_t>(std::floor(t_y)) };
+            const auto fx{ t_x - static_cast<float>(ix) };
+            const auto fy{ t_y - static_cast<float>(iy) };
+            const auto sx{ fx * fx * (3.0f - 2.0f * fx) };
+            const auto sy{ fy * fy * (3.0f - 2.0f * fy) };
+
+            const auto top{ lattice(ix, iy) + sx * (lattice(ix + 1, iy) - lattice(ix, iy)) };
+            const auto bottom{ lattice(ix, iy + 1) + sx * (lattice(ix + 1, iy + 1) - lattice(ix, iy + 1)) };
+
+            return top + sy * (bottom - top);
+        }
+
+        //-------------------------------------------------
+        // Cells
+        //-------------------------------------------------
+
+        /**
+         * Checks whether a cell can become land without touching the water margin.
+         *
+         * @param t_cx The x position of the cell.
+         * @param t_cy The y position of the cell.
+         *
+         * @return True or false.
+         */
+        [[nodiscard]] bool IsInsideMargin(const int32_t t_cx, const int32_t t_cy) const
+        {
+            return t_cx * CELL_SIZE >= WATER_MARGIN && t_cy * CELL_SIZE >= WATER_MARGIN &&
+                   (t_cx + 1) * CELL_SIZE <= width - WATER_MARGIN && (t_cy + 1) * CELL_SIZE <= height - WATER_MARGIN;
+        }
+
+        /**
+         * Creates the land cells: noise with a falloff to the border, then the shape is cleaned up.
+         *
+         * @param t_rng The random numbers of the island.
+         */
+        void CreateCells(CounterRng& t_rng)
+        {
+            const CounterRng noise{ t_rng.Next(), 0 };
+
+            m_cells.assign(static_cast<size_t>(m_cellsX) * m_cellsY, 0);
+            for (auto cy{ 0 }; cy < m_cellsY; ++cy)
+            {
+                for (auto cx{ 0 }; cx < m_cellsX; ++cx)
+                {
+                    if (!IsInsideMargin(cx, cy))
+                    {
+                        continue;
+                    }
+
+                    auto value{ 0.0f };
+                    auto amplitude{ 1.0f };
+                    auto frequency{ NOISE_FREQUENCY };
+                    auto sum{ 0.0f };
+                    for (auto octave{ 0 }; octave < NOISE_OCTAVES; ++octave)
+                    {
+                        value += amplitude * ValueNoise(noise, static_cast<float>(cx) * frequency, static_cast<float>(cy) * frequency);
+                        sum += amplitude;
+                        amplitude *= 0.5f;
+                        frequency *= 2.0f;
+                    }
+
+                    // the distance to the island center, 1 at the border
+                    const auto nx{ (static_cast<float>(cx) + 0.5f) / static_cast<float>(m_cellsX) * 2.0f - 1.0f };
+                    const auto ny{ (static_cast<float>(cy) + 0.5f) / static_cast<float>(m_cellsY) * 2.0f - 1.0f };
+                    const auto distance{ std::sqrt(nx * nx + ny * ny) };
+
+                    m_cells[static_cast<size_t>(cy) * m_cellsX + cx] = 0.5f * value / sum + 0.8f - distance > 0.0f;
+                }
+            }
+
+            RemoveDiagonalContacts();
+            KeepLargestLand();
+            FillLakes();
+
+            // a too small island gets all cells
+            if (std::find(m_cells.begin(), m_cells.end(), 1) == m_cells.end())
+            {
+                for (auto cy{ 0 }; cy < m_cellsY; ++cy)
+                {
+                    for (auto cx{ 0 }; cx < m_cellsX; ++cx)
+                    {
+                        m_cells[static_cast<size_t>(cy) * m_cellsX + cx] = IsInsideMargin(cx, cy);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Land cells that only touch diagonally have no bank tiles. One of them becomes water.
+         */
+        void RemoveDiagonalContacts()
+        {
+            auto changed{ true };
+            while (changed)
+            {
+                changed = false;
+                for (auto cy{ 0 }; cy < m_cellsY - 1; ++cy)
+                {
+                    for (auto cx{ 0 }; cx < m_cellsX - 1; ++cx)
+                    {
+                        const auto i{ static_cast<size_t>(cy) * m_cellsX + cx };
+                        const auto topLeft{ m_cells[i] };
+                        const auto topRight{ m_cells[i + 1] };
+                        const auto bottomLeft{ m_cells[i + m_cellsX] };
+                        const auto bottomRight{ m_cells[i + m_cellsX + 1] };
+
+                        if (topLeft && bottomRight && !topRight && !bottomLeft)
+                        {
+                            m_cells[i + m_cellsX + 1] = 0;
+                            changed = true;
+                        }
+                        else if (topRight && bottomLeft && !topLeft && !bottomRight)
+                        {
+                            m_cells[i + m_cellsX] = 0;
+                            changed = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * Labels the four-connected areas of cells with the given value.
+         *
+         * @param t_value The cell value (0 or 1).
+         * @param t_labels The area of each cell, -1 for other cells.
+         *
+         * @return The number of cells of each area.
+         */
+        std::vector<int32_t> LabelAreas(const uint8_t t_value, std::vector<int32_t>& t_labels) const
+        {
+            std::vector<int32_t> sizes;
+            t_labels.assign(m_cells.size(), -1);
+
+            std::queue<int32_t> open;
+            for (auto start{ 0 }; start < static_cast<int32_t>(m_cells.size()); ++start)
+            {
+                if (m_cells[start] != t_value || t_labels[start] >= 0)
+                {
+                    continue;
+                }
+
+                const auto label{ static_cast<int32_t>(sizes.size()) };
+                sizes.push_back(0);
+                t_labels[start] = label;
+                open.push(start);
+
+                while (!open.empty())
+                {
+                    const auto i{ open.front() };
+                    open.pop();
+                    ++sizes[label];
+
+                    const auto cx{ i % m_cellsX };
+                    const auto cy{ i / m_cellsX };
+                    for (const auto& [nx, ny] : { std::pair{ cx + 1, cy }, std::pair{ cx - 1, cy }, std::pair{ cx, cy + 1 }, std::pair{ cx, cy - 1 } })
+                    {
+                        if (nx < 0 || ny < 0 || nx >= m_cellsX || ny >= m_cellsY)
+                        {
+                            continue;
+                        }
+
+                        if (const auto n{ ny * m_cellsX + nx }; m_cells[n] == t_value && t_labels[n] < 0)
+                        {
+                            t_labels[n] = label;
+                            open.push(n);
+                        }
+                    }
+                }
+            }
+
+            return sizes;
+        }
+
+        /**
+         * Removes all land except the largest area.
+         */
+        void KeepLargestLand()
+        {
+            std::vector<int32_t> labels;
+            const auto sizes{ LabelAreas(1, labels) };
+            if (sizes.size() < 2)
+            {
+                return;
+            }
+
+            const auto largest{ static_cast<int32_t>(std::max_element(sizes.begin(), sizes.end()) - sizes.begin()) };
+            for (auto i{ 0u }; i < m_cells.size(); ++i)
+            {
+                m_cells[i] = labels[i] == largest;
+            }
+        }
+
+        /**
+         * Water areas without a connection to the border of the island become land.
+         */
+        void FillLakes()
+        {
+            std::vector<int32_t> labels;
+            const auto sizes{ LabelAreas(0, labels) };
+
+            std::vector<uint8_t> sea(sizes.size(), 0);
+            for (auto cy{ 0 }; cy < m_cellsY; ++cy)
+            {
+                for (auto cx{ 0 }; cx < m_cellsX; ++cx)
+                {
+                    if (const auto label{ labels[static_cast<size_t>(cy) * m_cellsX + cx] }; label >= 0 && !IsInsideMargin(cx, cy))
+                    {
+                        sea[label] = 1;
+                    }
+                }
+            }
+
+            for (auto i{ 0u }; i < m_cells.size(); ++i)
+            {
+                if (labels[i] >= 0 && !sea[labels[i]])
+                {
+                    m_cells[i] = 1;
+                }
+            }
+        }
+
+        //-------------------------------------------------
+        // Autotiling
+        //-------------------------------------------------
+
+        /**
+         * Creates the tile type for each neighborhood of a land or water position.
+         *
+         * Bit 0-3: the neighbors north, east, south, west; bit 4-7: northeast, southeast, southwest, northwest.
+         * For land positions a bit is set for water, for water positions a bit is set for land.
+         *
+         * @param t_land True for the table of land positions.
+         *
+         * @return The tile for each neighborhood.
+         */
+        static std::array<IslandTile, 256> CreateTable(const bool t_land)
+        {
+            // rotation by side (N, E, S, W) and by diagonal (NE, SE, SW, NW)
+            static constexpr std::array BANK_ROTATIONS{ Rotation::DEG180, Rotation::DEG270, Rotation::DEG0, Rotation::DEG90 };
+            static constexpr std::array COAST_ROTATIONS{ Rotation::DEG270, Rotation::DEG0, Rotation::DEG90, Rotation::DEG180 };
+            static constexpr std::array CORNER_ROTATIONS{ Rotation::DEG180, Rotation::DEG270, Rotation::DEG0, Rotation::DEG90 };
+
+            const auto countBits{ [](const int32_t t_bits) {
+                auto count{ 0 };
+                for (auto i{ 0 }; i < 4; ++i)
+                {
+                    count += (t_bits >> i) & 1;
+                }
+                return count;
+            } };
+
+            const auto firstBit{ [](const int32_t t_bits) {
+                auto i{ 0 };
+                while (!((t_bits >> i) & 1))
+                {
+                    ++i;
+                }
+                return i;
+            } };
+
+            std::array<IslandTile, 256> table;
+            for (auto bits{ 0 }; bits < 256; ++bits)
+            {
+                const auto sides{ bits & 15 };
+                const auto diagonals{ bits >> 4 };
+                auto& tile{ table[bits] };
+                tile.type = IslandTileType::INVALID;
+
+                if (sides == 0 && diagonals == 0)
+                {
+                    tile.type = t_land ? IslandTileType::LAND : IslandTileType::WATER;
+                }
+                else if (sides == 0 && countBits(diagonals) == 1)
+                {
+                    // water positions are rotated towards the water
+                    const auto diagonal{ firstBit(diagonals) };
+                    tile.type = t_land ? IslandTileType::BANK_CORNER_INSIDE : IslandTileType::COAST_CORNER;
+                    tile.rotation = CORNER_ROTATIONS[t_land ? diagonal : (diagonal + 2) % 4];
+                }
+                else if (countBits(sides) == 1)
+                {
+                    // only the diagonals next to the side are allowed
+                    const auto side{ firstBit(sides) };
+                    if ((diagonals & ~((1 << side) | (1 << ((side + 3) % 4)))) == 0)
+                    {
+                        tile.type = t_land ? IslandTileType::BANK : IslandTileType::COAST;
+                        tile.rotation = t_land ? BANK_ROTATIONS[side] : COAST_ROTATIONS[(side + 2) % 4];
+                    }
+                }
+                else if (countBits(sides) == 2)
+                {
+                    // two neighboring sides, the diagonal between them is the corner direction
+                    for (auto side{ 0 }; side < 4; ++side)
+                    {
+                        const auto pair{ (1 << side) | (1 << ((side + 1) % 4)) };
+                        if (sides == pair && !((diagonals >> ((side + 2) % 4)) & 1))
+                        {
+                            tile.type = t_land ? IslandTileType::BANK_CORNER : IslandTileType::COAST_CORNER_INSIDE;
+                            tile.rotation = CORNER_ROTATIONS[t_land ? side : (side + 2) % 4];
+                        }
+                    }
+                }
+            }
+
+            return table;
+        }
+
+        /**
+         * Creates the tile types from the land cells.
+         * The neighborhoods are computed row by row on a padded byte grid without branches.
+         */
+        void CreateTiles()
+        {
+            static const auto landTable{ CreateTable(true) };
+            static const auto waterTable{ CreateTable(false) };
+
+            const auto paddedWidth{ width + 2 };
+            const auto paddedHeight{ height + 2 };
+
+            // one tile of water around the island
+            std::vector<uint8_t> land(static_cast<size_t>(paddedWidth) * paddedHeight, 0);
+            for (auto y{ 0 }; y < height; ++y)
+            {
+                for (auto x{ 0 }; x < width; ++x)
+                {
+                    land[static_cast<size_t>(y + 1) * paddedWidth + x + 1] = m_cells[static_cast<size_t>(y / CELL_SIZE) * m_cellsX + x / CELL_SIZE];
+                }
+            }
+
+            std::vector<uint8_t> neighbors(static_cast<size_t>(width) * height);
+            std::vector<uint8_t> nearLand(static_cast<size_t>(paddedWidth) * paddedHeight, 0);
+            for (auto y{ 0 }; y < height; ++y)
+            {
+                const auto* const up{ &land[static_cast<size_t>(y) * paddedWidth] };
+                const auto* const mid{ up + paddedWidth };
+                const auto* const down{ mid + paddedWidth };
+                auto* const row{ &neighbors[static_cast<size_t>(y) * width] };
+                auto* const nearRow{ &nearLand[static_cast<size_t>(y + 1) * paddedWidth + 1] };
+
+                for (auto x{ 0 }; x < width; ++x)
+                {
+                    row[x] = static_cast<uint8_t>(
+                        up[x + 1] | mid[x + 2] << 1 | down[x + 1] << 2 | mid[x] << 3 |
+                        up[x + 2] << 4 | down[x + 2] << 5 | down[x] << 6 | up[x] << 7
+                    );
+                    nearRow[x] = static_cast<uint8_t>(mid[x + 1] | (row[x] != 0));
+                }
+            }
+
+            tiles.resize(static_cast<size_t>(width) * height);
+            for (auto y{ 0 }; y < height; ++y)
+            {
+                const auto* const up{ &nearLand[static_cast<size_t>(y) * paddedWidth] };
+                const auto* const mid{ up + paddedWidth };
+                const auto* const down{ mid + paddedWidth };
+
+                for (auto x{ 0 }; x < width; ++x)
+                {
+                    const auto i{ static_cast<size_t>(y) * width + x };
+                    if (land[static_cast<size_t>(y + 1) * paddedWidth + x + 1])
+                    {
+                        tiles[i] = landTable[static_cast<uint8_t>(~neighbors[i])];
+                        continue;
+                    }
+
+                    tiles[i] = waterTable[neighbors[i]];
+
+                    // the second ring around the land
+                    if (tiles[i].type == IslandTileType::WATER &&
+                        (up[x] | up[x + 1] | up[x + 2] | mid[x] | mid[x + 2] | down[x] | down[x + 1] | down[x + 2]))
+                    {
+                        tiles[i].type = IslandTileType::COAST_WATER;
+                    }
+                }
+            }
+
+            if (std::any_of(tiles.begin(), tiles.end(), [](const IslandTile& t_tile) { return t_tile.type == IslandTileType::INVALID; }))
+            {
+                throw MDCII_EXCEPTION("[IslandMask::CreateTiles()] Invalid island shape.");
+            }
+        }
+    };
+}
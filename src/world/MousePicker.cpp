@@ -19,6 +19,8 @@
 #include <imgui.h>
 #include "MousePicker.h"
 #include "World.h"
+#include "Terrain.h"
+#include "Island.h"
 #include "Rotation.h"
 #include "MdciiAssert.h"
 #include "Game.h"
@@ -26,6 +28,9 @@
 #include "renderer/TileRenderer.h"
 #include "renderer/RenderUtils.h"
 #include "state/State.h"
+#include "layer/TerrainLayer.h"
+#include "file/OriginalResourcesManager.h"
+#include "file/BshFile.h"
 #include "ogl/resource/ResourceManager.h"
 #include "ogl/resource/stb_image.h"
 
@@ -119,7 +124,12 @@ void mdcii::world::MousePicker::RenderImGui() const
 
 void mdcii::world::MousePicker::OnMouseMoved(const ogl::Window& t_window, const camera::Camera& t_camera)
 {
-    const auto newPosition{ GetWorldPosition(t_window, t_camera) };
+    auto newPosition{ GetWorldPosition(t_window, t_camera) };
+    if (m_world->currentAction == World::Action::STATUS || m_world->currentAction == World::Action::DEMOLISH)
+    {
+        newPosition = PickGfx(newPosition, t_window, t_camera);
+    }
+
     if (newPosition != currentPosition)
     {
         lastPosition = currentPosition;
@@ -264,6 +274,75 @@ glm::ivec2 mdcii::world::MousePicker::GetWorldPosition(const ogl::Window& t_wind
     return result;
 }
 
+glm::ivec2 mdcii::world::MousePicker::PickGfx(const glm::ivec2& t_groundPosition, const ogl::Window& t_window, const camera::Camera& t_camera) const
+{
+    const auto zoom{ m_world->zoom };
+    const auto rotation{ m_world->rotation };
+    const auto& bshTextures{ m_world->context->originalResourcesManager->GetStadtfldBshByZoom(zoom) };
+
+    // the mouse in the screen space of the model matrices
+    const auto mouse{ glm::vec2(t_window.GetMouseX(), t_window.GetMouseY()) + t_camera.position };
+
+    // a gfx can only cover tiles above it on the screen, and each gfx is at most one tile wide,
+    // so only the three screen columns around the ground position are checked from the bottom row up
+    for (auto row{ m_maxSpriteRows.at(magic_enum::enum_integer(zoom)) }; row >= -1; --row)
+    {
+        for (auto column{ -1 }; column <= 1; ++column)
+        {
+            if ((row + column) % 2 != 0)
+            {
+                continue;
+            }
+
+            const auto offset{ ToDeg0Offset({ (row + column) / 2, (row - column) / 2 }, rotation) };
+            const glm::ivec2 position{ t_groundPosition.x + offset.x, t_groundPosition.y + offset.y };
+
+            const auto* island{ m_world->terrain->GetIslandByWorldPosition(position) };
+            if (!island)
+            {
+                continue;
+            }
+
+            // buildings are rendered instead of the terrain
+            const auto islandPosition{ island->GetIslandPositionFromWorldPosition(position) };
+            const auto& layer{ island->buildingsLayer->GetTile(islandPosition).HasBuilding() ? *island->buildingsLayer : *island->terrainLayer };
+            const auto& tile{ layer.GetTile(islandPosition) };
+            if (!tile.HasBuilding())
+            {
+                continue;
+            }
+
+            const auto& bshTexture{ bshTextures[layer.CalcGfx(tile, rotation)] };
+            const auto modelMatrix{ layer.CreateModelMatrix(tile, zoom, rotation) };
+
+            if (bshTexture->IsOpaque(
+                static_cast<int32_t>(std::floor(mouse.x - modelMatrix[3].x)),
+                static_cast<int32_t>(std::floor(mouse.y - modelMatrix[3].y))
+            ))
+            {
+                return position;
+            }
+        }
+    }
+
+    return t_groundPosition;
+}
+
+glm::ivec2 mdcii::world::MousePicker::ToDeg0Offset(const glm::ivec2& t_offset, const Rotation t_rotation)
+{
+    switch (t_rotation)
+    {
+    case Rotation::DEG90:
+        return { t_offset.y, -t_offset.x };
+    case Rotation::DEG180:
+        return { -t_offset.x, -t_offset.y };
+    case Rotation::DEG270:
+        return { -t_offset.y, t_offset.x };
+    default:
+        return t_offset;
+    }
+}
+
 //-------------------------------------------------
 // Init
 //-------------------------------------------------
@@ -314,6 +393,15 @@ void mdcii::world::MousePicker::Init()
         Log::MDCII_LOG_DEBUG("[MousePicker::Init()] The cheat image was loaded successfully.");
 
         m_cheatImages.at(magic_enum::enum_integer(t_zoom)) = cornerImage;
+
+        // the highest gfx determines how many rows have to be checked when picking
+        auto maxHeight{ 0u };
+        for (const auto& bshTexture : m_world->context->originalResourcesManager->GetStadtfldBshByZoom(t_zoom))
+        {
+            maxHeight = std::max(maxHeight, bshTexture->height);
+        }
+
+        m_maxSpriteRows.at(magic_enum::enum_integer(t_zoom)) = (static_cast<int32_t>(maxHeight) + get_elevation(t_zoom)) / get_tile_height_half(t_zoom) + 1;
     });
 
     Log::MDCII_LOG_DEBUG("[MousePicker::Init()] The mouse picker was successfully initialized.");
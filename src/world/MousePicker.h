@@ -19,6 +19,7 @@
 #pragma once
 
 #include "Zoom.h"
+#include "Rotation.h"
 #include "ogl/Window.h"
 #include "camera/Camera.h"
 #include "event/EventManager.h"
@@ -119,6 +120,20 @@ namespace mdcii::world
          */
         void RenderImGui() const;
 
+        //-------------------------------------------------
+        // Helper
+        //-------------------------------------------------
+
+        /**
+         * Converts an offset between two rotated world positions into an offset between the unrotated positions.
+         *
+         * @param t_offset The offset in rotated world positions.
+         * @param t_rotation The rotation of the world.
+         *
+         * @return The offset for Rotation::DEG0.
+         */
+        [[nodiscard]] static glm::ivec2 ToDeg0Offset(const glm::ivec2& t_offset, Rotation t_rotation);
+
     protected:
 
     private:
@@ -151,6 +166,11 @@ namespace mdcii::world
          */
         std::array<unsigned char*, NR_OF_ZOOMS> m_cheatImages{ nullptr, nullptr, nullptr };
 
+        /**
+         * The number of screen rows below a tile whose gfx can cover the tile for each zoom level.
+         */
+        std::array<int32_t, NR_OF_ZOOMS> m_maxSpriteRows{ 0, 0, 0 };
+
         /**
          * Each zoom level has a different mouse cursor texture.
          */
@@ -179,6 +199,7 @@ namespace mdcii::world
 
         /**
          * Updates the current and last tile world positions under the mouse.
+         * Buildings are placed on the ground, so the gfx under the mouse is only picked to select or demolish a building.
          *
          * @param t_window The Window object.
          * @param t_camera The Camera object.
@@ -199,6 +220,18 @@ namespace mdcii::world
          */
         [[nodiscard]] glm::ivec2 GetWorldPosition(const ogl::Window& t_window, const camera::Camera& t_camera) const;
 
+        /**
+         * Finds the tile whose visible gfx pixel is under the mouse.
+         * The candidate tiles are checked front to back in the draw order of the current rotation.
+         *
+         * @param t_groundPosition The tile world position of the ground under the mouse.
+         * @param t_window The Window object.
+         * @param t_camera The Camera object.
+         *
+         * @return The tile world position of the gfx or the ground position if no gfx was hit.
+         */
+        [[nodiscard]] glm::ivec2 PickGfx(const glm::ivec2& t_groundPosition, const ogl::Window& t_window, const camera::Camera& t_camera) const;
+
         //-------------------------------------------------
         // Init
         //-------------------------------------------------
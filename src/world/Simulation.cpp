@@ -0,0 +1,183 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#include <chrono>
+#include "Simulation.h"
+#include "World.h"
+#include "AutoSave.h"
+#include "Game.h"
+#include "Log.h"
+#include "MdciiAssert.h"
+
+//-------------------------------------------------
+// Ctors. / Dtor.
+//-------------------------------------------------
+
+mdcii::world::Simulation::Simulation(World* t_world, const bool t_stepped)
+    : m_world{ t_world }
+    , m_stepped{ t_stepped }
+    , m_thread{ &Simulation::Run, this }
+{
+    Log::MDCII_LOG_DEBUG("[Simulation::Simulation()] Create Simulation.");
+
+    MDCII_ASSERT(m_world, "[Simulation::Simulation()] Null pointer.")
+}
+
+mdcii::world::Simulation::~Simulation() noexcept
+{
+    Log::MDCII_LOG_DEBUG("[Simulation::~Simulation()] Destruct Simulation.");
+
+    {
+        std::lock_guard lock{ m_stepMutex };
+        m_running = false;
+    }
+    m_stepCondition.notify_all();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+mdcii::world::RenderSnapshot mdcii::world::Simulation::GetSnapshot() const
+{
+    std::lock_guard lock{ m_mutex };
+
+    return m_snapshot;
+}
+
+//-------------------------------------------------
+// Setter
+//-------------------------------------------------
+
+void mdcii::world::Simulation::SetRunAnimations(const bool t_runAnimations)
+{
+    m_runAnimations = t_runAnimations;
+}
+
+//-------------------------------------------------
+// Logic
+//-------------------------------------------------
+
+void mdcii::world::Simulation::Step()
+{
+    MDCII_ASSERT(m_stepped, "[Simulation::Step()] The simulation runs by the wall clock.")
+
+    std::unique_lock lock{ m_stepMutex };
+    m_requestedTicks++;
+    m_stepCondition.notify_all();
+
+    m_stepCondition.wait(lock, [this] { return m_finishedTicks == m_requestedTicks || !m_running; });
+}
+
+void mdcii::world::Simulation::Run()
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto frameTime{ std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(Game::FRAME_TIME)) };
+    const auto maxLag{ std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(Game::MAX_LAG)) };
+
+    // the simulated state is only touched by this thread
+    AnimationClock animationClock;
+    RenderSnapshot snapshot;
+
+    auto nextTick{ Clock::now() };
+    auto statisticsStart{ nextTick };
+    auto ticks{ 0 };
+    Clock::duration tickTime{ 0 };
+
+    while (m_running)
+    {
+        if (m_stepped && !WaitForStep())
+        {
+            break;
+        }
+
+        const auto tickStart{ Clock::now() };
+
+        if (m_runAnimations)
+        {
+            animationClock.Tick();
+        }
+
+        // the main thread changes the terrain only under this lock
+        {
+            std::lock_guard lock{ m_world->tickMutex };
+            m_world->autoSave->Update();
+        }
+
+        snapshot.tick++;
+        snapshot.timeCounter = animationClock.timeCounter;
+
+        {
+            std::lock_guard lock{ m_mutex };
+            m_snapshot = snapshot;
+        }
+
+        const auto tickEnd{ Clock::now() };
+        tickTime += tickEnd - tickStart;
+        ticks++;
+
+        if (tickEnd - statisticsStart >= std::chrono::seconds(1))
+        {
+            m_tickMilliseconds = std::chrono::duration<double, std::milli>(tickTime).count() / ticks;
+            m_ticksPerSecond = ticks;
+
+            statisticsStart = tickEnd;
+            ticks = 0;
+            tickTime = Clock::duration{ 0 };
+        }
+
+        if (m_stepped)
+        {
+            FinishStep(snapshot.tick);
+            continue;
+        }
+
+        // fixed timestep; after a long stall the missed ticks are dropped
+        nextTick += frameTime;
+        if (tickEnd - nextTick > maxLag)
+        {
+            nextTick = tickEnd;
+        }
+
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+bool mdcii::world::Simulation::WaitForStep()
+{
+    std::unique_lock lock{ m_stepMutex };
+    m_stepCondition.wait(lock, [this] { return m_requestedTicks > m_finishedTicks || !m_running; });
+
+    return m_running;
+}
+
+void mdcii::world::Simulation::FinishStep(const uint64_t t_tick)
+{
+    {
+        std::lock_guard lock{ m_stepMutex };
+        m_finishedTicks = t_tick;
+    }
+    m_stepCondition.notify_all();
+}
@@ -0,0 +1,246 @@
+// This file is part of the MDCII project.
+//
+// Copyright (c) 2022. stwe <https://github.com/stwe/MDCII>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "AnimationClock.h"
+
+//-------------------------------------------------
+// Forward declarations
+//-------------------------------------------------
+
+namespace mdcii::world
+{
+    /**
+     * Forward declaration class World.
+     */
+    class World;
+}
+
+//-------------------------------------------------
+// Simulation
+//-------------------------------------------------
+
+namespace mdcii::world
+{
+    /**
+     * The state published by the simulation thread for the next rendered frame.
+     * Only the simulated state is published. Tile edits and the selection are made by the input handlers
+     * on the render thread and uploaded at once, so there are no dirty tile ranges to hand over.
+     */
+    struct RenderSnapshot
+    {
+        /**
+         * The number of simulation ticks so far.
+         */
+        uint64_t tick{ 0 };
+
+        /**
+         * Counters to get animation frames.
+         */
+        std::array<int32_t, AnimationClock::TICKS_PER_FRAME.size()> timeCounter{};
+    };
+
+    /**
+     * Runs the fixed simulation tick on its own thread, so that an expensive tick doesn't eat frame time.
+     * The thread owns the simulated state and only copies a RenderSnapshot to the render thread after each tick.
+     * The work of the world, e.g. the autosave, runs with each tick under the World::tickMutex.
+     *
+     * A stepped simulation doesn't use the wall clock. It ticks once for each Step() call,
+     * so that recorded, replayed and headless runs don't depend on the timing.
+     */
+    class Simulation
+    {
+    public:
+        //-------------------------------------------------
+        // Ctors. / Dtor.
+        //-------------------------------------------------
+
+        Simulation() = delete;
+
+        /**
+         * Constructs a new Simulation object and starts the thread.
+         *
+         * @param t_world The World object whose work runs with each tick.
+         * @param t_stepped True to tick only on Step() instead of by the wall clock.
+         */
+        Simulation(World* t_world, bool t_stepped);
+
+        Simulation(const Simulation& t_other) = delete;
+        Simulation(Simulation&& t_other) noexcept = delete;
+        Simulation& operator=(const Simulation& t_other) = delete;
+        Simulation& operator=(Simulation&& t_other) noexcept = delete;
+
+        /**
+         * Stops and joins the thread.
+         */
+        ~Simulation() noexcept;
+
+        //-------------------------------------------------
+        // Getter
+        //-------------------------------------------------
+
+        /**
+         * Get a copy of the last published state.
+         *
+         * @return The RenderSnapshot object.
+         */
+        [[nodiscard]] RenderSnapshot GetSnapshot() const;
+
+        /**
+         * Checks whether the simulation ticks only on Step().
+         *
+         * @return True or false.
+         */
+        [[nodiscard]] bool IsStepped() const { return m_stepped; }
+
+        /**
+         * Get the mean duration of a tick within the last second.
+         *
+         * @return The duration in milliseconds.
+         */
+        [[nodiscard]] double GetTickMilliseconds() const { return m_tickMilliseconds; }
+
+        /**
+         * Get the number of ticks within the last second.
+         *
+         * @return The number of ticks.
+         */
+        [[nodiscard]] int32_t GetTicksPerSecond() const { return m_ticksPerSecond; }
+
+        //-------------------------------------------------
+        // Setter
+        //-------------------------------------------------
+
+        /**
+         * Pauses or continues the animations.
+         *
+         * @param t_runAnimations False to stop the animation counters.
+         */
+        void SetRunAnimations(bool t_runAnimations);
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * Runs exactly one tick of a stepped simulation and waits until it is finished.
+         */
+        void Step();
+
+    protected:
+
+    private:
+        //-------------------------------------------------
+        // Member
+        //-------------------------------------------------
+
+        /**
+         * The World object whose work runs with each tick.
+         */
+        World* m_world{ nullptr };
+
+        /**
+         * True if the simulation ticks only on Step().
+         */
+        const bool m_stepped{ false };
+
+        /**
+         * Protects the requested and finished ticks of a stepped simulation.
+         */
+        std::mutex m_stepMutex;
+
+        /**
+         * Signals a requested or a finished tick.
+         */
+        std::condition_variable m_stepCondition;
+
+        /**
+         * The number of ticks requested by Step().
+         */
+        uint64_t m_requestedTicks{ 0 };
+
+        /**
+         * The number of finished ticks of a stepped simulation.
+         */
+        uint64_t m_finishedTicks{ 0 };
+
+        /**
+         * Protects the published snapshot.
+         */
+        mutable std::mutex m_mutex;
+
+        /**
+         * The last published snapshot.
+         */
+        RenderSnapshot m_snapshot;
+
+        /**
+         * False stops the thread.
+         */
+        std::atomic<bool> m_running{ true };
+
+        /**
+         * False stops the animation counters.
+         */
+        std::atomic<bool> m_runAnimations{ true };
+
+        /**
+         * The mean duration of a tick within the last second.
+         */
+        std::atomic<double> m_tickMilliseconds{ 0.0 };
+
+        /**
+         * The number of ticks within the last second.
+         */
+        std::atomic<int32_t> m_ticksPerSecond{ 0 };
+
+        /**
+         * The simulation thread. Started last, after all members are initialized.
+         */
+        std::thread m_thread;
+
+        //-------------------------------------------------
+        // Logic
+        //-------------------------------------------------
+
+        /**
+         * The loop of the simulation thread.
+         */
+        void Run();
+
+        /**
+         * Waits for the next requested tick of a stepped simulation.
+         *
+         * @return False if the thread has to stop.
+         */
+        bool WaitForStep();
+
+        /**
+         * Signals the end of a tick of a stepped simulation.
+         *
+         * @param t_tick The number of the finished tick.
+         */
+        void FinishStep(uint64_t t_tick);
+    };
+}
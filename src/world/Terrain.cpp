@@ -20,12 +20,16 @@
 #include "Terrain.h"
 #include "World.h"
 #include "MdciiAssert.h"
+#include "ThreadPool.h"
 #include "Island.h"
 #include "MousePicker.h"
 #include "state/State.h"
 #include "eventpp/utilities/argumentadapter.h"
 #include "layer/TerrainLayer.h"
 #include "file/OriginalResourcesManager.h"
+#include "file/SaveGame.h"
+#include "file/JsonMapReader.h"
+#include "profiler/Profiler.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -54,84 +58,155 @@ mdcii::world::Terrain::~Terrain() noexcept
 // Init
 //-------------------------------------------------
 
-void mdcii::world::Terrain::CreateIslandsFromJson(const nlohmann::json& t_json)
+void mdcii::world::Terrain::CreateIslandsFromJsonMap(file::JsonMapReader& t_reader)
 {
-    Log::MDCII_LOG_DEBUG("[Terrain::CreateIslandsFromJson()] Start creating islands...");
+    Log::MDCII_LOG_DEBUG("[Terrain::CreateIslandsFromJsonMap()] Start creating islands...");
 
-    for (const auto& [k, v] : t_json.items())
+    // create the Island and Layer objects as soon as an island has been read
+    t_reader.Read([this](file::JsonMapIsland& t_jsonMapIsland) {
+        auto island{ std::make_unique<Island>(m_context, this) };
+        island->InitValuesFromJsonMap(t_jsonMapIsland);
+
+        islands.emplace_back(std::move(island));
+    });
+
+    MDCII_ASSERT(!islands.empty(), "[Terrain::CreateIslandsFromJsonMap()] Missing islands.")
+
+    Log::MDCII_LOG_DEBUG("[Terrain::CreateIslandsFromJsonMap()] {} islands have been created successfully.", islands.size());
+}
+
+void mdcii::world::Terrain::CreateIslandsFromSaveGame(file::SaveGameReader& t_reader)
+{
+    Log::MDCII_LOG_DEBUG("[Terrain::CreateIslandsFromSaveGame()] Start creating islands...");
+
+    // the islands are stored one after the other
+    for (auto i{ 0u }; i < t_reader.nrOfIslands; ++i)
     {
         auto island{ std::make_unique<Island>(m_context, this) };
-        island->InitValuesFromJson(v);
+        island->InitValuesFromSaveGame(t_reader);
 
         islands.emplace_back(std::move(island));
     }
 
-    MDCII_ASSERT(!islands.empty(), "[Terrain::CreateIslandsFromJson()] Missing islands.")
+    MDCII_ASSERT(!islands.empty(), "[Terrain::CreateIslandsFromSaveGame()] Missing islands.")
 
-    Log::MDCII_LOG_DEBUG("[Terrain::CreateIslandsFromJson()] {} islands have been created successfully.", islands.size());
+    Log::MDCII_LOG_DEBUG("[Terrain::CreateIslandsFromSaveGame()] {} islands have been created successfully.", islands.size());
 }
 
-//-------------------------------------------------
-// Getter
-//-------------------------------------------------
-
-bool mdcii::world::Terrain::IsWorldPositionInDeepWater(const int32_t t_x, const int32_t t_y) const
+void mdcii::world::Terrain::PrepareIslandsForRendering()
 {
+    MDCII_PROFILE_SCOPE("Terrain::PrepareIslandsForRendering")
+
+    // prepare the Cpu data of each layer of each island in parallel
+    ThreadPool threadPool;
+    std::vector<std::future<void>> futures;
+
+    Log::MDCII_LOG_DEBUG("[Terrain::PrepareIslandsForRendering()] Prepare Cpu data with {} threads.", threadPool.GetNrOfThreads());
+
     for (const auto& island : islands)
     {
-        if (island->IsWorldPositionInAabb(glm::ivec2(t_x, t_y)))
+        for (auto* terrainLayer : { island->coastLayer.get(), island->terrainLayer.get(), island->buildingsLayer.get() })
         {
-            return false;
+            futures.push_back(threadPool.Submit([terrainLayer]() {
+                terrainLayer->PrepareCpuDataForRendering();
+                terrainLayer->CreateSaveGameTiles();
+            }));
         }
     }
 
-    return true;
-}
+    ThreadPool::WaitForAll(futures);
 
-bool mdcii::world::Terrain::IsBuildableOnIslandUnderMouse(const glm::ivec2& t_startWorldPosition, const data::Building& t_building, const Rotation t_buildingRotation) const
-{
-    if (!currentIslandUnderMouse)
+    // the grid layer depends on the terrain layer
+    for (const auto& island : islands)
     {
-        return false;
+        futures.push_back(threadPool.Submit([island = island.get()]() {
+            island->PrepareGridLayerCpuData();
+            island->CreateBuildingRegistry();
+            island->CreateBuildabilityMap();
+        }));
     }
 
-    for (auto y{ 0 }; y < t_building.size.h; ++y)
-    {
-        for (auto x{ 0 }; x < t_building.size.w; ++x)
-        {
-            // rotate building position
-            auto rp{ world::rotate_position(x, y, t_building.size.h, t_building.size.w, t_buildingRotation) };
-            if (t_buildingRotation == world::Rotation::DEG0 || t_buildingRotation == world::Rotation::DEG180)
-            {
-                rp = world::rotate_position(x, y, t_building.size.w, t_building.size.h, t_buildingRotation);
-            }
+    ThreadPool::WaitForAll(futures);
+}
 
-            // calc final world position
-            const auto finalWorldPosition{ glm::ivec2(t_startWorldPosition.x + rp.x, t_startWorldPosition.y + rp.y) };
+void mdcii::world::Terrain::CreateIslandGrid()
+{
+    Log::MDCII_LOG_DEBUG("[Terrain::CreateIslandGrid()] Start creating the island grid...");
 
-            // is final world position on island
-            if (currentIslandUnderMouse->IsWorldPositionInAabb(finalWorldPosition))
-            {
-                // get position on island from world position
-                const auto islandPosition{ currentIslandUnderMouse->GetIslandPositionFromWorldPosition(finalWorldPosition) };
+    MDCII_ASSERT(islands.size() < NO_ISLAND, "[Terrain::CreateIslandGrid()] Too many islands.")
 
-                // get tiles
-                const auto& terrainTile{ currentIslandUnderMouse->terrainLayer->GetTile(islandPosition.x, islandPosition.y) };
-                const auto& buildingTile{ currentIslandUnderMouse->buildingsLayer->GetTile(islandPosition.x, islandPosition.y) };
+    m_islandGridWidth = world->width;
+    m_islandGridHeight = world->height;
 
-                // check if the tile is buildable
-                if (!terrainTile.HasBuilding() || buildingTile.HasBuilding() || m_context->originalResourcesManager->GetBuildingById(terrainTile.buildingId).posoffs == 0)
+    // pad to an even size so that the grid can be read as 32-bit values on the Gpu
+    const auto size{ static_cast<size_t>(m_islandGridWidth) * m_islandGridHeight };
+    m_islandGrid.assign(size + size % 2, NO_ISLAND);
+
+    for (auto i{ 0u }; i < islands.size(); ++i)
+    {
+        const auto& island{ islands[i] };
+        for (auto y{ island->startWorldY }; y < island->startWorldY + island->height; ++y)
+        {
+            for (auto x{ island->startWorldX }; x < island->startWorldX + island->width; ++x)
+            {
+                if (!world->IsPositionInWorld(x, y))
                 {
-                    return false;
+                    continue;
                 }
-            }
-            else
-            {
-                return false;
+
+                auto& cell{ m_islandGrid[static_cast<size_t>(y) * m_islandGridWidth + x] };
+                MDCII_ASSERT(cell == NO_ISLAND, "[Terrain::CreateIslandGrid()] Overlapping islands.")
+                cell = static_cast<uint16_t>(i);
             }
         }
     }
 
+    Log::MDCII_LOG_DEBUG("[Terrain::CreateIslandGrid()] The island grid has been created successfully.");
+}
+
+//-------------------------------------------------
+// Getter
+//-------------------------------------------------
+
+bool mdcii::world::Terrain::IsWorldPositionInDeepWater(const int32_t t_x, const int32_t t_y) const
+{
+    return GetIslandIndex(t_x, t_y) == NO_ISLAND;
+}
+
+uint16_t mdcii::world::Terrain::GetIslandIndex(const int32_t t_x, const int32_t t_y) const
+{
+    if (t_x < 0 || t_x >= m_islandGridWidth || t_y < 0 || t_y >= m_islandGridHeight)
+    {
+        return NO_ISLAND;
+    }
+
+    return m_islandGrid[static_cast<size_t>(t_y) * m_islandGridWidth + t_x];
+}
+
+mdcii::world::Island* mdcii::world::Terrain::GetIslandByWorldPosition(const glm::ivec2& t_position) const
+{
+    const auto index{ GetIslandIndex(t_position.x, t_position.y) };
+    if (index == NO_ISLAND)
+    {
+        return nullptr;
+    }
+
+    return islands[index].get();
+}
+
+bool mdcii::world::Terrain::IsBuildableOnIslandUnderMouse(const glm::ivec2& t_startWorldPosition, const data::Building& t_building, const Rotation t_buildingRotation) const
+{
+    if (!currentIslandUnderMouse)
+    {
+        return false;
+    }
+
+    // the buildabilityMap also checks that the whole footprint is on the island
+    if (!currentIslandUnderMouse->IsBuildable(currentIslandUnderMouse->GetIslandPositionFromWorldPosition(t_startWorldPosition), t_building, t_buildingRotation))
+    {
+        return false;
+    }
+
     Log::MDCII_LOG_DEBUG("[Terrain::IsBuildableOnIslandUnderMouse()] The tile is buildable at world position ({}, {}).", t_startWorldPosition.x, t_startWorldPosition.y);
 
     return true;
@@ -180,30 +255,27 @@ void mdcii::world::Terrain::OnLeftMouseButtonPressed()
         return;
     }
 
-    currentSelectedIsland = nullptr;
-    for (auto const& island : islands)
+    currentSelectedIsland = GetIslandByWorldPosition(world->mousePicker->currentPosition);
+    if (currentSelectedIsland)
     {
-        if (island->IsWorldPositionInAabb(world->mousePicker->currentPosition))
-        {
-            currentSelectedIsland = island.get();
-            currentSelectedIsland->currentSelectedTile = nullptr;
+        currentSelectedIsland->currentSelectedTile = nullptr;
 
-            auto& terrainTile{ currentSelectedIsland->terrainLayer->GetTile(currentSelectedIsland->GetIslandPositionFromWorldPosition(world->mousePicker->currentPosition)) };
-            auto& buildingsTile{ currentSelectedIsland->buildingsLayer->GetTile(currentSelectedIsland->GetIslandPositionFromWorldPosition(world->mousePicker->currentPosition)) };
-            auto& coastTile{ currentSelectedIsland->coastLayer->GetTile(currentSelectedIsland->GetIslandPositionFromWorldPosition(world->mousePicker->currentPosition)) };
+        const auto islandPosition{ currentSelectedIsland->GetIslandPositionFromWorldPosition(world->mousePicker->currentPosition) };
+        auto& terrainTile{ currentSelectedIsland->terrainLayer->GetTile(islandPosition) };
+        auto& buildingsTile{ currentSelectedIsland->buildingsLayer->GetTile(islandPosition) };
+        auto& coastTile{ currentSelectedIsland->coastLayer->GetTile(islandPosition) };
 
-            if (buildingsTile.HasBuilding())
-            {
-                currentSelectedIsland->currentSelectedTile = &buildingsTile;
-            }
-            else if (terrainTile.HasBuilding())
-            {
-                currentSelectedIsland->currentSelectedTile = &terrainTile;
-            }
-            else if (coastTile.HasBuilding())
-            {
-                currentSelectedIsland->currentSelectedTile = &coastTile;
-            }
+        if (buildingsTile.HasBuilding())
+        {
+            currentSelectedIsland->currentSelectedTile = &buildingsTile;
+        }
+        else if (terrainTile.HasBuilding())
+        {
+            currentSelectedIsland->currentSelectedTile = &terrainTile;
+        }
+        else if (coastTile.HasBuilding())
+        {
+            currentSelectedIsland->currentSelectedTile = &coastTile;
         }
     }
 }
@@ -216,30 +288,27 @@ void mdcii::world::Terrain::OnMouseMoved()
         return;
     }
 
-    currentIslandUnderMouse = nullptr;
-    for (const auto& island : islands)
+    currentIslandUnderMouse = GetIslandByWorldPosition(world->mousePicker->currentPosition);
+    if (currentIslandUnderMouse)
     {
-        if (island->IsWorldPositionInAabb(world->mousePicker->currentPosition))
-        {
-            currentIslandUnderMouse = island.get();
-            currentIslandUnderMouse->currentTileUnderMouse = nullptr;
+        currentIslandUnderMouse->currentTileUnderMouse = nullptr;
 
-            auto& terrainTile{ currentIslandUnderMouse->terrainLayer->GetTile(currentIslandUnderMouse->GetIslandPositionFromWorldPosition(world->mousePicker->currentPosition)) };
-            auto& buildingsTile{ currentIslandUnderMouse->buildingsLayer->GetTile(currentIslandUnderMouse->GetIslandPositionFromWorldPosition(world->mousePicker->currentPosition)) };
-            auto& coastTile{ currentIslandUnderMouse->coastLayer->GetTile(currentIslandUnderMouse->GetIslandPositionFromWorldPosition(world->mousePicker->currentPosition)) };
+        const auto islandPosition{ currentIslandUnderMouse->GetIslandPositionFromWorldPosition(world->mousePicker->currentPosition) };
+        auto& terrainTile{ currentIslandUnderMouse->terrainLayer->GetTile(islandPosition) };
+        auto& buildingsTile{ currentIslandUnderMouse->buildingsLayer->GetTile(islandPosition) };
+        auto& coastTile{ currentIslandUnderMouse->coastLayer->GetTile(islandPosition) };
 
-            if (buildingsTile.HasBuilding())
-            {
-                currentIslandUnderMouse->currentTileUnderMouse = &buildingsTile;
-            }
-            else if (terrainTile.HasBuilding())
-            {
-                currentIslandUnderMouse->currentTileUnderMouse = &terrainTile;
-            }
-            else if (coastTile.HasBuilding())
-            {
-                currentIslandUnderMouse->currentTileUnderMouse = &coastTile;
-            }
+        if (buildingsTile.HasBuilding())
+        {
+            currentIslandUnderMouse->currentTileUnderMouse = &buildingsTile;
+        }
+        else if (terrainTile.HasBuilding())
+        {
+            currentIslandUnderMouse->currentTileUnderMouse = &terrainTile;
+        }
+        else if (coastTile.HasBuilding())
+        {
+            currentIslandUnderMouse->currentTileUnderMouse = &coastTile;
         }
     }
 }
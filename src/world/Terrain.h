@@ -18,10 +18,12 @@
 
 #pragma once
 
+#include <limits>
 #include <glm/vec2.hpp>
 #include "data/json.hpp"
 #include "event/EventManager.h"
 #include "data/Buildings.h"
+#include "BuildingRegistry.h"
 
 //-------------------------------------------------
 // Forward declarations
@@ -35,6 +37,19 @@ namespace mdcii::layer
     struct Tile;
 }
 
+namespace mdcii::file
+{
+    /**
+     * Forward declaration class SaveGameReader.
+     */
+    class SaveGameReader;
+
+    /**
+     * Forward declaration class JsonMapReader.
+     */
+    class JsonMapReader;
+}
+
 namespace mdcii::state
 {
     /**
@@ -78,6 +93,15 @@ namespace mdcii::world
     class Terrain
     {
     public:
+        //-------------------------------------------------
+        // Constants
+        //-------------------------------------------------
+
+        /**
+         * Marks a world position that does not belong to any island.
+         */
+        static constexpr auto NO_ISLAND{ std::numeric_limits<uint16_t>::max() };
+
         //-------------------------------------------------
         // Types
         //-------------------------------------------------
@@ -89,6 +113,7 @@ namespace mdcii::world
         {
             std::vector<std::unique_ptr<layer::Tile>> tiles;
             Island* island{ nullptr };
+            PlacedBuilding placedBuilding;
         };
 
         //-------------------------------------------------
@@ -146,11 +171,31 @@ namespace mdcii::world
         //-------------------------------------------------
 
         /**
-         * Creates the Island objects from a Json value.
+         * Creates the Island objects while reading a Json map.
+         *
+         * @param t_reader The JsonMapReader object.
+         */
+        void CreateIslandsFromJsonMap(file::JsonMapReader& t_reader);
+
+        /**
+         * Creates the Island objects from a savegame.
          *
-         * @param t_json The Json value.
+         * @param t_reader The SaveGameReader object. The header must have been read.
+         */
+        void CreateIslandsFromSaveGame(file::SaveGameReader& t_reader);
+
+        /**
+         * Prepares the Cpu data of the created islands for rendering.
+         * The Gpu data of all islands is packed afterwards by the renderers.
+         * The world size must be known at this point.
+         */
+        void PrepareIslandsForRendering();
+
+        /**
+         * Rasterizes the Aabb of each island into a world-sized grid.
+         * The world size must be known at this point.
          */
-        void CreateIslandsFromJson(const nlohmann::json& t_json);
+        void CreateIslandGrid();
 
         //-------------------------------------------------
         // Getter
@@ -166,6 +211,33 @@ namespace mdcii::world
          */
         [[nodiscard]] bool IsWorldPositionInDeepWater(int32_t t_x, int32_t t_y) const;
 
+        /**
+         * Returns the index of the island at the given world position.
+         *
+         * @param t_x The world x position.
+         * @param t_y The world y position.
+         *
+         * @return The index into the islands vector or NO_ISLAND.
+         */
+        [[nodiscard]] uint16_t GetIslandIndex(int32_t t_x, int32_t t_y) const;
+
+        /**
+         * Returns the island at the given world position.
+         *
+         * @param t_position The world position.
+         *
+         * @return A pointer to the Island object or nullptr.
+         */
+        [[nodiscard]] Island* GetIslandByWorldPosition(const glm::ivec2& t_position) const;
+
+        /**
+         * Returns the island index of each world position.
+         * The size is padded to an even number of values.
+         *
+         * @return The island grid.
+         */
+        [[nodiscard]] const std::vector<uint16_t>& GetIslandGrid() const { return m_islandGrid; }
+
         /**
          * Checks whether the given building can be created at the specified world position on current island under mouse.
          *
@@ -205,6 +277,21 @@ namespace mdcii::world
          */
         std::shared_ptr<state::Context> m_context;
 
+        /**
+         * The island index for each world position (row-major, width * height).
+         */
+        std::vector<uint16_t> m_islandGrid;
+
+        /**
+         * The width of the island grid.
+         */
+        int32_t m_islandGridWidth{ 0 };
+
+        /**
+         * The height of the island grid.
+         */
+        int32_t m_islandGridHeight{ 0 };
+
         /**
          * The mouse button pressed listener handle.
          */
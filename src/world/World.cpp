@@ -16,20 +16,31 @@
 // along with this program; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
+#include <optional>
 #include "World.h"
 #include "Game.h"
 #include "MdciiAssert.h"
 #include "TileAtlas.h"
+#include "Island.h"
 #include "WorldGui.h"
 #include "MousePicker.h"
+#include "AutoSave.h"
+#include "Simulation.h"
 #include "eventpp/utilities/argumentadapter.h"
 #include "state/State.h"
 #include "state/StateStack.h"
 #include "renderer/TerrainRenderer.h"
 #include "renderer/GridRenderer.h"
+#include "renderer/FrameUniforms.h"
 #include "layer/GridLayer.h"
 #include "layer/WorldLayer.h"
 #include "layer/WorldGridLayer.h"
+#include "ogl/Device.h"
+#include "file/OriginalResourcesManager.h"
+#include "file/SaveGame.h"
+#include "file/SaveGameJournal.h"
+#include "file/JsonMapReader.h"
+#include "profiler/Profiler.h"
 
 //-------------------------------------------------
 // Ctors. / Dtor.
@@ -94,73 +105,119 @@ glm::vec2 mdcii::world::World::WorldToScreen(const int32_t t_x, const int32_t t_
 
 void mdcii::world::World::Update() const
 {
-    if (m_runAnimations)
+    // the animations and the autosave are ticked by the simulation thread
+    m_simulation->SetRunAnimations(m_runAnimations);
+
+    // one tick per update, so that the run doesn't depend on the timing
+    if (m_simulation->IsStepped())
     {
-        terrainRenderer->Update();
+        m_simulation->Step();
     }
 }
 
 void mdcii::world::World::Render() const
 {
-    for(const auto& island : terrain->islands)
+    MDCII_PROFILE_SCOPE("World::Render")
+
+    // written once, read by all draws of this frame
     {
-        if (context->camera->IsIslandNotInCamera(zoom, rotation, *island))
+        const auto zoomInt{ magic_enum::enum_integer(zoom) };
+        const auto& timeCounter{ m_simulation->GetSnapshot().timeCounter };
+
+        auto& frame{ frameUniforms->data };
+        frame.projectionView = context->window->GetOrthographicProjectionMatrix() * context->camera->GetViewMatrix();
+        frame.worldRotation = magic_enum::enum_integer(rotation);
+        frame.maxY = TileAtlas::HEIGHTS.at(zoomInt);
+        frame.nrOfRows = static_cast<float>(TileAtlas::ROWS.at(zoomInt));
+        for (auto i{ 0u }; i < timeCounter.size(); ++i)
         {
-            continue;
+            frame.updates.at(i).x = timeCounter.at(i);
         }
 
-        if (m_layerTypeToRender != layer::LayerType::NOTHING)
+        frameUniforms->Upload();
+    }
+
+    {
+        MDCII_PROFILE_GPU_SCOPE("Islands")
+
+        // the visible islands are rendered with one draw call for each pass
+        std::vector<int32_t> visibleIslands;
         {
-            if (m_layerTypeToRender == layer::LayerType::COAST)
-            {
-                terrainRenderer->Render(*island->coastLayer, zoom, rotation);
-            }
+            MDCII_PROFILE_SCOPE("Culling")
 
-            if (m_layerTypeToRender == layer::LayerType::TERRAIN)
+            for (auto i{ 0u }; i < terrain->islands.size(); ++i)
             {
-                terrainRenderer->Render(*island->terrainLayer, zoom, rotation);
+                if (!context->camera->IsIslandNotInCamera(zoom, rotation, *terrain->islands[i]))
+                {
+                    visibleIslands.push_back(static_cast<int32_t>(i));
+                }
             }
+        }
 
-            if (m_layerTypeToRender == layer::LayerType::BUILDINGS)
-            {
-                terrainRenderer->Render(*island->buildingsLayer, zoom, rotation);
-            }
+        if (m_layerTypeToRender == layer::LayerType::COAST ||
+            m_layerTypeToRender == layer::LayerType::TERRAIN ||
+            m_layerTypeToRender == layer::LayerType::BUILDINGS ||
+            m_layerTypeToRender == layer::LayerType::MIXED
+        )
+        {
+            MDCII_PROFILE_SCOPE("Layer")
+            terrainRenderer->RenderIslands(visibleIslands, m_layerTypeToRender, zoom, rotation);
+        }
 
-            if (m_layerTypeToRender == layer::LayerType::MIXED)
+        if (m_layerTypeToRender == layer::LayerType::ALL)
+        {
             {
-                terrainRenderer->Render(*island->mixedLayer, zoom, rotation);
+                MDCII_PROFILE_SCOPE("Coast")
+                terrainRenderer->RenderIslands(visibleIslands, layer::LayerType::COAST, zoom, rotation);
             }
-
-            if (m_layerTypeToRender == layer::LayerType::ALL)
             {
-                terrainRenderer->Render(*island->coastLayer, zoom, rotation);
-                terrainRenderer->Render(*island->mixedLayer, zoom, rotation);
+                MDCII_PROFILE_SCOPE("Mixed")
+                terrainRenderer->RenderIslands(visibleIslands, layer::LayerType::MIXED, zoom, rotation);
             }
         }
 
         if (m_renderIslandGridLayers)
         {
-            gridRenderer->Render(island->gridLayer->modelMatricesSsbos, island->gridLayer->instancesToRender, zoom, rotation);
+            MDCII_PROFILE_SCOPE("Grid")
+            gridRenderer->RenderIslands(visibleIslands, zoom, rotation);
+        }
+
+        if (m_renderBuildableHighlights &&
+            currentAction == Action::BUILD &&
+            m_worldGui->selectedBuildingTile.HasBuilding() &&
+            terrain->currentIslandUnderMouse &&
+            !context->camera->IsIslandNotInCamera(zoom, rotation, *terrain->currentIslandUnderMouse)
+        )
+        {
+            MDCII_PROFILE_SCOPE("BuildableHighlights")
+
+            auto& island{ *terrain->currentIslandUnderMouse };
+            const auto& building{ context->originalResourcesManager->GetBuildingById(m_worldGui->selectedBuildingTile.buildingId) };
+            island.UpdateBuildableHighlights(building, m_worldGui->selectedBuildingTile.rotation, zoom, rotation);
+
+            if (island.gridLayer->highlightsToRender > 0)
+            {
+                gridRenderer->Render(*island.gridLayer->highlightsSsbo, island.gridLayer->highlightsToRender, zoom, true);
+            }
         }
     }
 
     if (m_renderWorldLayer)
     {
-        terrainRenderer->Render(
-            worldLayer->modelMatricesSsbos,
-            *worldLayer->gfxNumbersSsbo,
-            *worldLayer->buildingIdsSsbo,
-            worldLayer->instancesToRender,
-            zoom,
-            rotation
-        );
+        MDCII_PROFILE_SCOPE("DeepWater")
+        MDCII_PROFILE_GPU_SCOPE("DeepWater")
+        terrainRenderer->RenderDeepWater(*worldLayer, zoom, rotation);
     }
 
     if (m_renderWorldGridLayer)
     {
+        MDCII_PROFILE_SCOPE("WorldGrid")
+        MDCII_PROFILE_GPU_SCOPE("WorldGrid")
         gridRenderer->Render(worldGridLayer->modelMatricesSsbos, worldGridLayer->instancesToRender, zoom, rotation);
     }
 
+    MDCII_PROFILE_SCOPE("MousePicker")
+    MDCII_PROFILE_GPU_SCOPE("MousePicker")
     mousePicker->Render(*context->window, *context->camera);
 }
 
@@ -222,6 +279,7 @@ void mdcii::world::World::RenderImGui()
         ImGui::RadioButton("Nothing", &e, 5);
 
         ImGui::Checkbox("Island Grids", &m_renderIslandGridLayers);
+        ImGui::Checkbox("Buildable Positions", &m_renderBuildableHighlights);
 
         if (auto layer{ magic_enum::enum_cast<layer::LayerType>(e) }; layer.has_value())
         {
@@ -239,6 +297,23 @@ void mdcii::world::World::RenderImGui()
         ImGui::Checkbox("Animations", &m_runAnimations);
     }
 
+    if (ImGui::CollapsingHeader("Threads"))
+    {
+        const auto framerate{ ImGui::GetIO().Framerate };
+        ImGui::Text("Simulation: %d ticks/s, %.3f ms/tick", m_simulation->GetTicksPerSecond(), m_simulation->GetTickMilliseconds());
+        ImGui::Text("Render: %.1f frames/s, %.3f ms/frame", framerate, framerate > 0.0f ? 1000.0f / framerate : 0.0f);
+    }
+
+    if (ImGui::CollapsingHeader("Gpu state"))
+    {
+        auto& device{ ogl::Device::Get() };
+        const auto& frame{ device.frameStatistics };
+        ImGui::Checkbox("State cache", &device.useStateCache);
+        ImGui::Text("State changes: %d issued, %d skipped", static_cast<int>(frame.stateChanges), static_cast<int>(frame.skippedStateChanges));
+        ImGui::Text("Draws: %d, instances: %d", static_cast<int>(frame.drawCalls), static_cast<int>(frame.instancesDrawn));
+        ImGui::Text("Uploads: %d, %.1f KiB", static_cast<int>(frame.bufferUploads), static_cast<float>(frame.bytesUploaded) / 1024.0f);
+    }
+
     if (ImGui::CollapsingHeader("Rotate"))
     {
         m_worldGui->RotateGui();
@@ -271,16 +346,14 @@ void mdcii::world::World::RenderImGui()
 
     if (currentAction == Action::DEMOLISH && terrain->IsCurrentSelectedTileRemovable())
     {
-        if (terrain->currentSelectedIsland->currentSelectedTile->connectedTiles.empty())
-        {
-            terrainRenderer->DeleteBuildingFromGpu(*terrain->currentSelectedIsland, *terrain->currentSelectedIsland->currentSelectedTile);
-            renderer::TerrainRenderer::DeleteBuildingFromCpu(*terrain->currentSelectedIsland->currentSelectedTile);
-        }
-        else
-        {
-            terrainRenderer->DeleteBuildingFromGpu(*terrain->currentSelectedIsland, terrain->currentSelectedIsland->currentSelectedTile->connectedTiles);
-            renderer::TerrainRenderer::DeleteBuildingFromCpu(*terrain->currentSelectedIsland, terrain->currentSelectedIsland->currentSelectedTile->connectedTiles);
-        }
+        std::lock_guard lock{ tickMutex };
+
+        // each building on the buildings layer is in the registry of its island
+        const auto placedBuildingIndex{ terrain->currentSelectedIsland->currentSelectedTile->placedBuildingIndex };
+        MDCII_ASSERT(placedBuildingIndex != BuildingRegistry::NO_PLACED_BUILDING, "[World::RenderImGui()] The building is not registered.")
+
+        terrainRenderer->DeleteBuildingFromGpu(*terrain->currentSelectedIsland, placedBuildingIndex);
+        renderer::TerrainRenderer::DeleteBuildingFromCpu(*terrain->currentSelectedIsland, placedBuildingIndex);
     }
 
     if (currentAction == Action::STATUS && terrain->currentSelectedIsland && terrain->currentSelectedIsland->currentSelectedTile)
@@ -350,6 +423,7 @@ void mdcii::world::World::OnLeftMouseButtonPressed()
         !terrain->tilesToAdd.tiles.empty()
     )
     {
+        std::lock_guard lock{ tickMutex };
         renderer::TerrainRenderer::AddBuildingToCpu(*terrain);
     }
 
@@ -399,39 +473,41 @@ void mdcii::world::World::Init()
     terrain = std::make_unique<Terrain>(context, this);
     tileAtlas = std::make_unique<TileAtlas>();
     terrainRenderer = std::make_unique<renderer::TerrainRenderer>(context, tileAtlas);
+    frameUniforms = std::make_unique<renderer::FrameUniforms>();
+
+    const auto mapFilePath{ Game::RESOURCES_REL_PATH + m_mapFilePath };
+    std::optional<uint64_t> checkpointId;
+    std::size_t nrOfJournalEntries{ 0 };
 
-    nlohmann::json j = read_json_from_file(Game::RESOURCES_REL_PATH + m_mapFilePath);
-    for (const auto& [k, v] : j.items())
+    if (file::SaveGameReader::IsSaveGameFile(mapFilePath))
     {
-        if (k == "version" && v.get<std::string>() != Game::VERSION)
-        {
-            throw MDCII_EXCEPTION("[World::Init()] Invalid map file format.");
-        }
+        // the tiles are streamed from the file directly into the layers
+        file::SaveGameReader reader{ mapFilePath };
+        SetSize(reader.worldWidth, reader.worldHeight);
+        terrain->CreateIslandsFromSaveGame(reader);
 
-        if (k == "world")
-        {
-            width = v.at("width").get<int32_t>();
-            height = v.at("height").get<int32_t>();
+        // the changes since the savegame was written
+        const auto entries{ file::SaveGameJournal::Read(file::SaveGameJournal::GetFilePath(mapFilePath), reader.checkpointId) };
+        file::SaveGameJournal::Replay(entries, *terrain);
 
-            if (width < WORLD_MIN_WIDTH || width > WORLD_MAX_WIDTH)
-            {
-                throw MDCII_EXCEPTION("[World::Init()] Invalid world width given.");
-            }
-
-            if (height < WORLD_MIN_HEIGHT || height > WORLD_MAX_HEIGHT)
-            {
-                throw MDCII_EXCEPTION("[World::Init()] Invalid world height given.");
-            }
+        checkpointId = reader.checkpointId;
+        nrOfJournalEntries = entries.size();
+    }
+    else
+    {
+        // the Json map is parsed without creating a Json value
+        file::JsonMapReader reader{ mapFilePath };
+        terrain->CreateIslandsFromJsonMap(reader);
 
-            Log::MDCII_LOG_DEBUG("[World::Init()] The width of the world is set to: {}.", width);
-            Log::MDCII_LOG_DEBUG("[World::Init()] The height of the world is set to: {}.", height);
-        }
-        if (k == "islands")
-        {
-            terrain->CreateIslandsFromJson(v);
-        }
+        SetSize(reader.worldWidth, reader.worldHeight);
     }
 
+    // the islands need the world size to calculate the screen positions
+    terrain->PrepareIslandsForRendering();
+    terrainRenderer->CreateIslandBuffers(terrain->islands);
+
+    terrain->CreateIslandGrid();
+
     worldLayer = std::make_unique<layer::WorldLayer>(context, this);
     worldLayer->PrepareCpuDataForRendering();
     worldLayer->PrepareGpuDataForRendering();
@@ -441,14 +517,45 @@ void mdcii::world::World::Init()
     worldGridLayer->PrepareGpuDataForRendering();
 
     gridRenderer = std::make_unique<renderer::GridRenderer>(context);
+    gridRenderer->CreateIslandBuffers(terrain->islands);
     m_worldGui = std::make_unique<WorldGui>(this);
     mousePicker = std::make_unique<MousePicker>(this, *context->window, *context->camera);
+    autoSave = std::make_unique<AutoSave>(this);
+    if (checkpointId.has_value() && checkpointId.value() != file::NO_CHECKPOINT_ID)
+    {
+        autoSave->SetCheckpoint(mapFilePath, checkpointId.value(), nrOfJournalEntries);
+    }
+
+    // recorded, replayed and headless runs must not depend on the wall clock
+    m_simulation = std::make_unique<Simulation>(
+        this,
+        event::EventManager::IsRecording() || event::EventManager::IsReplaying() || context->window->headless
+    );
 
     MDCII_ASSERT(!terrain->islands.empty(), "[World::Init()] No islands created.")
 
     Log::MDCII_LOG_DEBUG("[World::Init()] The world was successfully initialized.");
 }
 
+void mdcii::world::World::SetSize(const int32_t t_width, const int32_t t_height)
+{
+    if (t_width < WORLD_MIN_WIDTH || t_width > WORLD_MAX_WIDTH)
+    {
+        throw MDCII_EXCEPTION("[World::SetSize()] Invalid world width given.");
+    }
+
+    if (t_height < WORLD_MIN_HEIGHT || t_height > WORLD_MAX_HEIGHT)
+    {
+        throw MDCII_EXCEPTION("[World::SetSize()] Invalid world height given.");
+    }
+
+    width = t_width;
+    height = t_height;
+
+    Log::MDCII_LOG_DEBUG("[World::SetSize()] The width of the world is set to: {}.", width);
+    Log::MDCII_LOG_DEBUG("[World::SetSize()] The height of the world is set to: {}.", height);
+}
+
 void mdcii::world::World::AddListeners()
 {
     Log::MDCII_LOG_DEBUG("[World::AddListeners()] Add event listeners.");
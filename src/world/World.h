@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <magic_enum.hpp>
 #include <glm/vec2.hpp>
 #include "event/EventManager.h"
@@ -69,6 +70,11 @@ namespace mdcii::renderer
      * Forward declaration class GridRenderer.
      */
     class GridRenderer;
+
+    /**
+     * Forward declaration class FrameUniforms.
+     */
+    class FrameUniforms;
 }
 
 //-------------------------------------------------
@@ -121,6 +127,16 @@ namespace mdcii::world
      */
     class MousePicker;
 
+    /**
+     * Forward declaration class AutoSave.
+     */
+    class AutoSave;
+
+    /**
+     * Forward declaration class Simulation.
+     */
+    class Simulation;
+
     //-------------------------------------------------
     // World
     //-------------------------------------------------
@@ -224,6 +240,11 @@ namespace mdcii::world
          */
         std::unique_ptr<renderer::GridRenderer> gridRenderer;
 
+        /**
+         * The camera, rotation, animation and atlas values shared by all draws of a frame.
+         */
+        std::unique_ptr<renderer::FrameUniforms> frameUniforms;
+
         /**
          * A Layer object containing only the deep water area of the world.
          */
@@ -239,6 +260,17 @@ namespace mdcii::world
          */
         std::unique_ptr<MousePicker> mousePicker;
 
+        /**
+         * Saves the world in the background.
+         */
+        std::unique_ptr<AutoSave> autoSave;
+
+        /**
+         * Held by the simulation thread during a tick. The main thread
+         * must hold it to change the terrain or to use the AutoSave.
+         */
+        std::mutex tickMutex;
+
         /**
          * Indicates which action button is currently active.
          */
@@ -294,6 +326,13 @@ namespace mdcii::world
          */
         [[nodiscard]] bool IsPositionInWorld(const glm::ivec2& t_position) const;
 
+        /**
+         * Checks whether the world changes without input.
+         *
+         * @return True if the animations are running.
+         */
+        [[nodiscard]] bool IsAnimating() const { return m_runAnimations; }
+
         /**
          * Projects a position into an isometric position on the screen.
          *
@@ -356,7 +395,7 @@ namespace mdcii::world
         state::StateId m_stateId;
 
         /**
-         * The path to the Json map file.
+         * The path to the map file. This can be a Json map or a savegame.
          */
         std::string m_mapFilePath;
 
@@ -365,6 +404,11 @@ namespace mdcii::world
          */
         std::unique_ptr<WorldGui> m_worldGui;
 
+        /**
+         * Runs the fixed simulation tick on its own thread.
+         */
+        std::unique_ptr<Simulation> m_simulation;
+
         /**
          * The Layer types to render.
          */
@@ -385,6 +429,11 @@ namespace mdcii::world
          */
         bool m_renderIslandGridLayers{ false };
 
+        /**
+         * Toggles highlighting of all valid positions for the selected building on and off.
+         */
+        bool m_renderBuildableHighlights{ true };
+
         /**
          * Toggles animations on and off.
          */
@@ -423,6 +472,14 @@ namespace mdcii::world
          */
         void Init();
 
+        /**
+         * Validates and sets the size of the world.
+         *
+         * @param t_width The width of the world.
+         * @param t_height The height of the world.
+         */
+        void SetSize(int32_t t_width, int32_t t_height);
+
         /**
          * Adds event listeners.
          */
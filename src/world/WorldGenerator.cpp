@@ -16,12 +16,19 @@
 // along with this program; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 
+#include <limits>
+#include <algorithm>
 #include <filesystem>
-#include <deque>
+#include <numeric>
 #include "WorldGenerator.h"
 #include "world/World.h"
 #include "Game.h"
 #include "MdciiUtils.h"
+#include "ThreadPool.h"
+#include "CounterRng.h"
+#include "IslandMask.h"
+#include "physics/BroadPhase.h"
+#include "file/SaveGame.h"
 #include "layer/TerrainLayer.h"
 
 //-------------------------------------------------
@@ -46,8 +53,6 @@ mdcii::world::WorldGenerator::~WorldGenerator() noexcept
 
 void mdcii::world::WorldGenerator::RenderImGui()
 {
-    nlohmann::json j;
-
     static int32_t width{ World::WORLD_MIN_WIDTH };
     static int32_t height{ World::WORLD_MIN_HEIGHT };
 
@@ -56,8 +61,17 @@ void mdcii::world::WorldGenerator::RenderImGui()
     ImGui::SliderInt("World height", &height, World::WORLD_MIN_HEIGHT, World::WORLD_MAX_HEIGHT);
     ImGui::Separator();
 
+    static int32_t seed{ 0 };
+    ImGui::InputInt("Seed", &seed);
+
+    static int32_t waterMargin{ ISLAND_WATER_MARGIN };
+    ImGui::SliderInt("Water margin", &waterMargin, 0, 16);
+
     static int nrOfIslands{ 1 };
-    ImGui::SliderInt("Islands to add", &nrOfIslands, 1, 4);
+    if (ImGui::InputInt("Islands to add", &nrOfIslands))
+    {
+        nrOfIslands = std::clamp(nrOfIslands, 1, MAX_GUI_ISLANDS);
+    }
 
     static bool addIslands{ false };
     if (ImGui::Button("Add islands"))
@@ -67,15 +81,12 @@ void mdcii::world::WorldGenerator::RenderImGui()
 
     if (addIslands)
     {
-        static std::vector<int32_t> w(nrOfIslands, 16);
-        static std::vector<int32_t> h(nrOfIslands, 16);
-        static std::vector<int32_t> x(nrOfIslands, 0);
-        static std::vector<int32_t> y(nrOfIslands, 0);
-        static std::deque<bool> s(nrOfIslands, true);
-        static std::vector<physics::Aabb> aabbs(nrOfIslands, physics::Aabb({ 0, 0 }, { 0, 0 }));
-
-        if (ImGui::BeginTable("Islands", 5))
+        static std::vector<IslandSettings> islands;
+        islands.resize(nrOfIslands);
+
+        if (ImGui::BeginTable("Islands", 5, ImGuiTableFlags_ScrollY, ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * 16.0f)))
         {
+            ImGui::TableSetupScrollFreeze(0, 1);
             ImGui::TableSetupColumn("width");
             ImGui::TableSetupColumn("height");
             ImGui::TableSetupColumn("x");
@@ -83,66 +94,249 @@ void mdcii::world::WorldGenerator::RenderImGui()
             ImGui::TableSetupColumn("north/south");
             ImGui::TableHeadersRow();
 
-            for (int row = 0; row < nrOfIslands; row++)
+            // only the visible rows are rendered
+            ImGuiListClipper clipper;
+            clipper.Begin(nrOfIslands);
+            while (clipper.Step())
             {
-                ImGui::TableNextRow();
-                for (int column = 0; column < 5; column++)
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
                 {
-                    ImGui::TableSetColumnIndex(column);
+                    auto& island{ islands.at(row) };
 
-                    ImGui::PushID(row * 5 + column);
-                    if (column == 0)
-                    {
-                        ImGui::InputInt("w", &w.at(row));
-                    }
-                    if (column == 1)
-                    {
-                        ImGui::InputInt("h", &h.at(row));
-                    }
-                    if (column == 2)
-                    {
-                        ImGui::InputInt("x", &x.at(row));
-                    }
-                    if (column == 3)
+                    ImGui::TableNextRow();
+                    for (int column = 0; column < 5; column++)
                     {
-                        ImGui::InputInt("y", &y.at(row));
+                        ImGui::TableSetColumnIndex(column);
+
+                        ImGui::PushID(row * 5 + column);
+                        if (column == 0)
+                        {
+                            ImGui::InputInt("w", &island.width);
+                        }
+                        if (column == 1)
+                        {
+                            ImGui::InputInt("h", &island.height);
+                        }
+                        if (column == 2)
+                        {
+                            ImGui::InputInt("x", &island.x);
+                        }
+                        if (column == 3)
+                        {
+                            ImGui::InputInt("y", &island.y);
+                        }
+                        if (column == 4)
+                        {
+                            toggle_button("s", &island.south);
+                        }
+                        ImGui::PopID();
                     }
-                    if (column == 4)
-                    {
-                        toggle_button("s", &s.at(row));
-                    }
-                    ImGui::PopID();
                 }
             }
             ImGui::EndTable();
         }
 
-        if (ImGui::Button("Create"))
+        if (ImGui::Button("Pack islands"))
         {
-            for (auto v{ 0 }; v < nrOfIslands; ++v)
+            if (!PackIslands(islands, width, height, waterMargin))
             {
-                aabbs.at(v) = physics::Aabb(glm::ivec2(x.at(v), y.at(v)), glm::ivec2(w.at(v), h.at(v)));
+                Log::MDCII_LOG_WARN("[WorldGenerator::RenderImGui()] The islands do not fit into the world.");
             }
+        }
 
-            if (Validate(aabbs))
-            {
-                AddWorldValues(j, width, height);
+        ImGui::SameLine();
 
-                for (auto i{ 0 }; i < nrOfIslands; ++i)
-                {
-                    AddIslandValues(j, w.at(i), h.at(i), x.at(i), y.at(i), s.at(i));
-                }
+        if (ImGui::Button("Create"))
+        {
+            std::vector<physics::Aabb> aabbs;
+            for (const auto& island : islands)
+            {
+                aabbs.emplace_back(glm::ivec2(island.x, island.y), glm::ivec2(island.width, island.height));
+            }
 
-                m_file << j;
+            if (m_filePath.empty())
+            {
+                Log::MDCII_LOG_WARN("[WorldGenerator::RenderImGui()] The map file already exists.");
+            }
+            else if (Validate(aabbs, waterMargin))
+            {
+                CreateWorld(m_filePath, width, height, islands, static_cast<uint64_t>(seed), std::thread::hardware_concurrency());
+                m_filePath.clear();
 
                 Log::MDCII_LOG_DEBUG("[WorldGenerator::RenderImGui()] The world was successfully created.");
             }
             else
             {
-                Log::MDCII_LOG_WARN("[WorldGenerator::RenderImGui()] Invalid island positions.");
+                Log::MDCII_LOG_WARN("[WorldGenerator::RenderImGui()] Invalid island positions. Use Pack islands to find free positions.");
+            }
+        }
+    }
+}
+
+//-------------------------------------------------
+// Create
+//-------------------------------------------------
+
+std::vector<mdcii::world::IslandSettings> mdcii::world::WorldGenerator::CreateIslandSettings(
+    const int32_t t_worldWidth,
+    const int32_t t_worldHeight,
+    const int32_t t_nrOfIslands,
+    const int32_t t_waterMargin,
+    const uint64_t t_seed
+)
+{
+    Log::MDCII_LOG_DEBUG("[WorldGenerator::CreateIslandSettings()] Create {} random islands with seed {}.", t_nrOfIslands, t_seed);
+
+    if (t_worldWidth < ISLAND_MIN_SIZE || t_worldHeight < ISLAND_MIN_SIZE)
+    {
+        throw MDCII_EXCEPTION("[WorldGenerator::CreateIslandSettings()] The world is too small for an island.");
+    }
+
+    // the island streams start at 0, so the placement uses the last stream
+    CounterRng rng{ t_seed, std::numeric_limits<uint64_t>::max() };
+
+    std::vector<IslandSettings> islands;
+    for (auto i{ 0 }; i < t_nrOfIslands; ++i)
+    {
+        IslandSettings island;
+        island.width = rng.NextInt(ISLAND_MIN_SIZE, std::min(ISLAND_MAX_SIZE, t_worldWidth));
+        island.height = rng.NextInt(ISLAND_MIN_SIZE, std::min(ISLAND_MAX_SIZE, t_worldHeight));
+        islands.push_back(island);
+    }
+
+    // only the islands in the neighboring grid cells are checked
+    physics::UniformGrid grid{ t_worldWidth, t_worldHeight, ISLAND_MAX_SIZE + t_waterMargin };
+
+    auto placed{ true };
+    for (auto& island : islands)
+    {
+        placed = false;
+        for (auto attempt{ 0 }; attempt < MAX_PLACEMENT_ATTEMPTS && !placed; ++attempt)
+        {
+            island.x = rng.NextInt(0, t_worldWidth - island.width);
+            island.y = rng.NextInt(0, t_worldHeight - island.height);
+
+            if (const physics::Aabb aabb{ { island.x, island.y }, { island.width, island.height } }; !grid.Overlaps(aabb, t_waterMargin))
+            {
+                grid.Insert(aabb);
+                placed = true;
             }
         }
+
+        if (!placed)
+        {
+            break;
+        }
+    }
+
+    // too many islands for random positions
+    if (!placed)
+    {
+        Log::MDCII_LOG_DEBUG("[WorldGenerator::CreateIslandSettings()] No free random position found, pack the islands.");
+
+        if (!PackIslands(islands, t_worldWidth, t_worldHeight, t_waterMargin))
+        {
+            throw MDCII_EXCEPTION("[WorldGenerator::CreateIslandSettings()] The islands do not fit into the world.");
+        }
+    }
+
+    for (auto& island : islands)
+    {
+        island.south = island.y + island.height / 2 >= t_worldHeight / 2;
+    }
+
+    return islands;
+}
+
+bool mdcii::world::WorldGenerator::PackIslands(
+    std::vector<IslandSettings>& t_islands,
+    const int32_t t_worldWidth,
+    const int32_t t_worldHeight,
+    const int32_t t_waterMargin
+)
+{
+    // the highest islands first, so that the rows are filled evenly
+    std::vector<size_t> order(t_islands.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&t_islands](const size_t t_a, const size_t t_b) {
+        return t_islands[t_a].height > t_islands[t_b].height;
+    });
+
+    auto x{ 0 };
+    auto rowY{ 0 };
+    auto rowHeight{ 0 };
+    for (const auto i : order)
+    {
+        auto& island{ t_islands[i] };
+        if (island.width > t_worldWidth)
+        {
+            return false;
+        }
+
+        // start a new row
+        if (x + island.width > t_worldWidth)
+        {
+            x = 0;
+            rowY += rowHeight + t_waterMargin;
+            rowHeight = 0;
+        }
+
+        if (rowY + island.height > t_worldHeight)
+        {
+            return false;
+        }
+
+        island.x = x;
+        island.y = rowY;
+
+        x += island.width + t_waterMargin;
+        rowHeight = std::max(rowHeight, island.height);
     }
+
+    return true;
+}
+
+void mdcii::world::WorldGenerator::CreateWorld(
+    const std::string& t_filePath,
+    const int32_t t_worldWidth,
+    const int32_t t_worldHeight,
+    const std::vector<IslandSettings>& t_islands,
+    const uint64_t t_seed,
+    const uint32_t t_nrOfThreads
+)
+{
+    Log::MDCII_LOG_DEBUG("[WorldGenerator::CreateWorld()] Generate {} islands on {} threads.", t_islands.size(), t_nrOfThreads);
+
+    std::vector<std::future<GeneratedIsland>> futures;
+    {
+        ThreadPool threadPool{ t_nrOfThreads };
+        for (auto i{ 0u }; i < t_islands.size(); ++i)
+        {
+            futures.push_back(threadPool.Submit([&t_islands, t_seed, i]() {
+                // the random numbers only depend on the seed and the island index
+                CounterRng rng{ t_seed, i };
+                return CreateIsland(t_islands.at(i), rng);
+            }));
+        }
+    }
+
+    std::vector<GeneratedIsland> islands;
+    islands.reserve(futures.size());
+    for (auto& future : futures)
+    {
+        islands.push_back(future.get());
+    }
+
+    if (std::filesystem::path(t_filePath).extension() == ".sav")
+    {
+        WriteSaveGame(t_filePath, t_worldWidth, t_worldHeight, islands);
+    }
+    else
+    {
+        WriteJson(t_filePath, t_worldWidth, t_worldHeight, islands);
+    }
+
+    Log::MDCII_LOG_DEBUG("[WorldGenerator::CreateWorld()] The world was written to file {}.", t_filePath);
 }
 
 //-------------------------------------------------
@@ -161,79 +355,114 @@ void mdcii::world::WorldGenerator::Init()
         return;
     }
 
-    m_file.open(fileName);
-    if (!m_file.is_open())
-    {
-        throw MDCII_EXCEPTION("[WorldGenerator::Init()] Error while opening file " + fileName + ".");
-    }
+    m_filePath = fileName;
 
     Log::MDCII_LOG_DEBUG("[WorldGenerator::Init()] The world generator was successfully initialized.");
 }
 
 //-------------------------------------------------
-// Create Json
+// Create Islands
 //-------------------------------------------------
 
-bool mdcii::world::WorldGenerator::Validate(const std::vector<physics::Aabb>& t_aabbs)
+bool mdcii::world::WorldGenerator::Validate(const std::vector<physics::Aabb>& t_aabbs, const int32_t t_waterMargin)
 {
-    Log::MDCII_LOG_DEBUG("[WorldGenerator::Validate()] Check for Aabbs collisions.");
+    Log::MDCII_LOG_DEBUG("[WorldGenerator::Validate()] Check {} Aabbs for collisions.", t_aabbs.size());
 
-    for (auto i{ 0 }; i < t_aabbs.size(); ++i)
-    {
-        for (auto j{ 0 }; j < t_aabbs.size(); ++j)
-        {
-            if (i != j)
-            {
-                if (physics::Aabb::AabbVsAabb(t_aabbs.at(i), t_aabbs.at(j)))
-                {
-                    return false;
-                }
-            }
-        }
-    }
+    return !physics::has_overlap(t_aabbs, t_waterMargin);
+}
 
-    return true;
+mdcii::world::WorldGenerator::GeneratedIsland mdcii::world::WorldGenerator::CreateIsland(const IslandSettings& t_settings, CounterRng& t_rng)
+{
+    GeneratedIsland island;
+    island.settings = t_settings;
+
+    // the shape of the island, all layers use the same mask
+    const IslandMask mask{ t_settings.width, t_settings.height, t_rng };
+
+    CreateTerrain(mask, island.terrainTiles, t_settings.south, t_rng);
+    CreateCoast(mask, island.coastTiles);
+    CreateBuildings(t_settings.width, t_settings.height, island.buildingsTiles);
+
+    return island;
 }
 
-void mdcii::world::WorldGenerator::AddWorldValues(nlohmann::json& t_j, const int32_t t_width, const int32_t t_height)
+//-------------------------------------------------
+// Write
+//-------------------------------------------------
+
+void mdcii::world::WorldGenerator::WriteJson(
+    const std::string& t_filePath,
+    const int32_t t_worldWidth,
+    const int32_t t_worldHeight,
+    const std::vector<GeneratedIsland>& t_islands
+)
 {
-    Log::MDCII_LOG_DEBUG("[WorldGenerator::AddWorldValues()] Adds world Json values.");
+    std::ofstream file{ t_filePath };
+    if (!file.is_open())
+    {
+        throw MDCII_EXCEPTION("[WorldGenerator::WriteJson()] Error while opening file " + t_filePath + ".");
+    }
+
+    nlohmann::json j;
+    j["world"] = { { "width", t_worldWidth }, { "height", t_worldHeight } };
+
+    for (const auto& island : t_islands)
+    {
+        AddIslandValues(j, island);
+    }
 
-    t_j["world"] = { { "width", t_width }, { "height", t_height } };
+    file << j;
 }
 
-void mdcii::world::WorldGenerator::AddIslandValues(
-    nlohmann::json& t_j,
-    const int32_t t_width,
-    const int32_t t_height,
-    const int32_t t_worldX,
-    const int32_t t_worldY,
-    const bool t_south
+void mdcii::world::WorldGenerator::WriteSaveGame(
+    const std::string& t_filePath,
+    const int32_t t_worldWidth,
+    const int32_t t_worldHeight,
+    const std::vector<GeneratedIsland>& t_islands
 )
 {
-    Log::MDCII_LOG_DEBUG("[WorldGenerator::AddIslandValues()] Adds Json values for an new island.");
+    file::SaveGameWriter writer{ t_filePath, Game::INI.Get<bool>("content", "save_game_rle") };
+    writer.WriteHeader(file::NO_CHECKPOINT_ID, t_worldWidth, t_worldHeight, static_cast<uint32_t>(t_islands.size()));
 
-    std::vector<std::shared_ptr<layer::Tile>> coastTiles;
-    std::vector<std::shared_ptr<layer::Tile>> terrainTiles;
-    std::vector<std::shared_ptr<layer::Tile>> buildingsTiles;
+    for (const auto& island : t_islands)
+    {
+        writer.WriteIsland({ island.settings.width, island.settings.height, island.settings.x, island.settings.y });
+        for (const auto& [layerType, tiles] : {
+                 std::pair{ layer::LayerType::COAST, &island.coastTiles },
+                 std::pair{ layer::LayerType::TERRAIN, &island.terrainTiles },
+                 std::pair{ layer::LayerType::BUILDINGS, &island.buildingsTiles }
+             })
+        {
+            std::vector<file::SaveGameTile> saveGameTiles;
+            saveGameTiles.reserve(tiles->size());
+            for (const auto& tile : *tiles)
+            {
+                saveGameTiles.push_back(file::to_save_game_tile(*tile));
+            }
 
+            writer.WriteLayer(layerType, saveGameTiles);
+        }
+    }
+
+    writer.Close();
+}
+
+void mdcii::world::WorldGenerator::AddIslandValues(nlohmann::json& t_j, const GeneratedIsland& t_island)
+{
     nlohmann::json c = nlohmann::json::object();
     nlohmann::json t = nlohmann::json::object();
     nlohmann::json b = nlohmann::json::object();
     nlohmann::json i = nlohmann::json::object();
 
-    i["width"] = t_width;
-    i["height"] = t_height;
-    i["x"] = t_worldX;
-    i["y"] = t_worldY;
+    i["width"] = t_island.settings.width;
+    i["height"] = t_island.settings.height;
+    i["x"] = t_island.settings.x;
+    i["y"] = t_island.settings.y;
     i["layers"] = nlohmann::json::array();
 
-    CreateTerrain(t_width, t_height, terrainTiles, t_south);
-    CreateCoast(t_width, t_height, coastTiles);
-    CreateBuildings(t_width, t_height, buildingsTiles);
-    c["coast"] = coastTiles;
-    t["terrain"] = terrainTiles;
-    b["buildings"] = buildingsTiles;
+    c["coast"] = t_island.coastTiles;
+    t["terrain"] = t_island.terrainTiles;
+    b["buildings"] = t_island.buildingsTiles;
 
     i["layers"].push_back(c);
     i["layers"].push_back(t);
@@ -247,163 +476,78 @@ void mdcii::world::WorldGenerator::AddIslandValues(
 //-------------------------------------------------
 
 void mdcii::world::WorldGenerator::CreateTerrain(
-    const int32_t t_width,
-    const int32_t t_height,
+    const IslandMask& t_mask,
     std::vector<std::shared_ptr<layer::Tile>>& t_terrainTiles,
-    const bool t_south
+    const bool t_south,
+    CounterRng& t_rng
 )
 {
-    // default
-    for (auto y{ 0 }; y < t_height; ++y)
+    for (auto y{ 0 }; y < t_mask.height; ++y)
     {
-        for (auto x{ 0 }; x < t_width; ++x)
+        for (auto x{ 0 }; x < t_mask.width; ++x)
         {
-            t_terrainTiles.emplace_back(std::make_unique<layer::Tile>());
-        }
-    }
-
-    auto mapIndex = [&](const int32_t t_x, const int32_t t_y) {
-        return t_y * t_width + t_x;
-    };
-
-    srand(static_cast<uint32_t>(time(0)));
+            const auto& [type, rotation]{ t_mask.GetTile(x, y) };
 
-    // terrain
-    for (auto y{ 2 }; y < t_height - 2; ++y)
-    {
-        for (auto x{ 2 }; x < t_width - 2; ++x)
-        {
-            auto id{ GRASS };
-            if (t_south)
+            auto id{ -1 };
+            switch (type)
             {
-                if (auto r{ (rand() % 10) }; r >= 7)
-                {
-                    id = SOUTH_TREES.at(rand() % 11);
-                }
+            case IslandTileType::LAND:
+                id = GRASS;
+                break;
+            case IslandTileType::BANK:
+                id = BANK;
+                break;
+            case IslandTileType::BANK_CORNER:
+                id = BANK_CORNER;
+                break;
+            case IslandTileType::BANK_CORNER_INSIDE:
+                id = BANK_CORNER_INSIDE;
+                break;
+            default:
+                break;
             }
-            else
-            {
-                if (auto r{ (rand() % 10) }; r >= 7)
-                {
-                    id = NORTH_TREES.at(rand() % 11);
-                }
-            }
-
-            auto terrainTile{ std::make_unique<layer::Tile>() };
-            terrainTile->buildingId = id;
-            terrainTile->rotation = Rotation::DEG0;
-            terrainTile->x = 0;
-            terrainTile->y = 0;
-            terrainTile->worldXDeg0 = x;
-            terrainTile->worldYDeg0 = y;
 
-            t_terrainTiles.at(mapIndex(x, y)) = std::move(terrainTile);
+            t_terrainTiles.emplace_back(CreateTile(id, rotation, x, y));
         }
     }
 
-    // corners
-    t_terrainTiles.at(mapIndex(2, 2))->buildingId = BANK_CORNER; // top left
-    t_terrainTiles.at(mapIndex(2, 2))->rotation = Rotation::DEG90;
-
-    t_terrainTiles.at(mapIndex(t_width - 3, 2))->buildingId = BANK_CORNER; // top right
-    t_terrainTiles.at(mapIndex(t_width - 3, 2))->rotation = Rotation::DEG180;
-
-    t_terrainTiles.at(mapIndex(t_width - 3, t_height - 3))->buildingId = BANK_CORNER; // bottom right
-    t_terrainTiles.at(mapIndex(t_width - 3, t_height - 3))->rotation = Rotation::DEG270;
-
-    t_terrainTiles.at(mapIndex(2, t_height - 3))->buildingId = BANK_CORNER; // bottom left
-    t_terrainTiles.at(mapIndex(2, t_height - 3))->rotation = Rotation::DEG0;
-
-    // borders
-    for (auto x{ 3 }; x < t_width - 3; ++x)
+    // trees with a min distance to each other
+    for (const auto& position : t_mask.SampleLand(VEGETATION_MIN_DISTANCE, t_rng))
     {
-        t_terrainTiles.at(mapIndex(x, 2))->buildingId = BANK;
-        t_terrainTiles.at(mapIndex(x, 2))->rotation = Rotation::DEG180;
-
-        t_terrainTiles.at(mapIndex(x, t_height - 3))->buildingId = BANK;
-        t_terrainTiles.at(mapIndex(x, t_height - 3))->rotation = Rotation::DEG0;
-    }
-
-    for (auto y{ 3 }; y < t_height - 3; ++y)
-    {
-        t_terrainTiles.at(mapIndex(2, y))->buildingId = BANK;
-        t_terrainTiles.at(mapIndex(2, y))->rotation = Rotation::DEG90;
-
-        t_terrainTiles.at(mapIndex(t_width - 3, y))->buildingId = BANK;
-        t_terrainTiles.at(mapIndex(t_width - 3, y))->rotation = Rotation::DEG270;
+        const auto index{ static_cast<size_t>(position.y) * t_mask.width + position.x };
+        t_terrainTiles.at(index)->buildingId = t_south ? SOUTH_TREES.at(t_rng.NextInt(0, 10)) : NORTH_TREES.at(t_rng.NextInt(0, 10));
     }
 }
 
-void mdcii::world::WorldGenerator::CreateCoast(
-    const int32_t t_width,
-    const int32_t t_height,
-    std::vector<std::shared_ptr<layer::Tile>>& t_coastTiles
-)
+void mdcii::world::WorldGenerator::CreateCoast(const IslandMask& t_mask, std::vector<std::shared_ptr<layer::Tile>>& t_coastTiles)
 {
-    // default
-    for (auto y{ 0 }; y < t_height; ++y)
+    for (auto y{ 0 }; y < t_mask.height; ++y)
     {
-        for (auto x{ 0 }; x < t_width; ++x)
+        for (auto x{ 0 }; x < t_mask.width; ++x)
         {
-            t_coastTiles.emplace_back(std::make_unique<layer::Tile>());
-        }
-    }
-
-    auto mapIndex = [&](const int32_t t_x, const int32_t t_y) {
-        return t_y * t_width + t_x;
-    };
+            const auto& [type, rotation]{ t_mask.GetTile(x, y) };
 
-    // coast
-    for (auto y{ 0 }; y < t_height; ++y)
-    {
-        for (auto x{ 0 }; x < t_width; ++x)
-        {
-            if (x == 0 || x == 1 || x == t_width - 1 || x == t_width - 2 ||
-                y == 0 || y == 1 || y == t_height - 1 || y == t_height - 2)
+            auto id{ -1 };
+            switch (type)
             {
-                auto terrainTile{ std::make_unique<layer::Tile>() };
-                terrainTile->buildingId = COAST_WATER;
-                terrainTile->rotation = Rotation::DEG0;
-                terrainTile->x = 0;
-                terrainTile->y = 0;
-                terrainTile->worldXDeg0 = x;
-                terrainTile->worldYDeg0 = y;
-
-                t_coastTiles.at(mapIndex(x, y)) = std::move(terrainTile);
+            case IslandTileType::COAST_WATER:
+                id = COAST_WATER;
+                break;
+            case IslandTileType::COAST:
+                id = COAST;
+                break;
+            case IslandTileType::COAST_CORNER:
+                id = COAST_CORNER;
+                break;
+            case IslandTileType::COAST_CORNER_INSIDE:
+                id = COAST_CORNER_INSIDE;
+                break;
+            default:
+                break;
             }
-        }
-    }
-
-    // corners
-    t_coastTiles.at(mapIndex(1, 1))->buildingId = COAST_CORNER; // top left
-    t_coastTiles.at(mapIndex(1, 1))->rotation = Rotation::DEG90;
-
-    t_coastTiles.at(mapIndex(t_width - 2, 1))->buildingId = COAST_CORNER; // top right
-    t_coastTiles.at(mapIndex(t_width - 2, 1))->rotation = Rotation::DEG180;
-
-    t_coastTiles.at(mapIndex(t_width - 2, t_height - 2))->buildingId = COAST_CORNER; // bottom right
-    t_coastTiles.at(mapIndex(t_width - 2, t_height - 2))->rotation = Rotation::DEG270;
-
-    t_coastTiles.at(mapIndex(1, t_height - 2))->buildingId = COAST_CORNER; // bottom left
-    t_coastTiles.at(mapIndex(1, t_height - 2))->rotation = Rotation::DEG0;
-
-    // borders
-    for (auto x{ 2 }; x < t_width - 2; ++x)
-    {
-        t_coastTiles.at(mapIndex(x, 1))->buildingId = COAST;
-        t_coastTiles.at(mapIndex(x, 1))->rotation = Rotation::DEG270;
 
-        t_coastTiles.at(mapIndex(x, t_height - 2))->buildingId = 1205;
-        t_coastTiles.at(mapIndex(x, t_height - 2))->rotation = Rotation::DEG90;
-    }
-
-    for (auto y{ 2 }; y < t_height - 2; ++y)
-    {
-        t_coastTiles.at(mapIndex(1, y))->buildingId = COAST;
-        t_coastTiles.at(mapIndex(1, y))->rotation = Rotation::DEG180;
-
-        t_coastTiles.at(mapIndex(t_width - 2, y))->buildingId = 1205;
-        t_coastTiles.at(mapIndex(t_width - 2, y))->rotation = Rotation::DEG0;
+            t_coastTiles.emplace_back(CreateTile(id, rotation, x, y));
+        }
     }
 }
 
@@ -422,3 +566,21 @@ void mdcii::world::WorldGenerator::CreateBuildings(
         }
     }
 }
+
+std::unique_ptr<mdcii::layer::Tile> mdcii::world::WorldGenerator::CreateTile(const int32_t t_buildingId, const Rotation t_rotation, const int32_t t_x, const int32_t t_y)
+{
+    auto tile{ std::make_unique<layer::Tile>() };
+    if (t_buildingId < 0)
+    {
+        return tile;
+    }
+
+    tile->buildingId = t_buildingId;
+    tile->rotation = t_rotation;
+    tile->x = 0;
+    tile->y = 0;
+    tile->worldXDeg0 = t_x;
+    tile->worldYDeg0 = t_y;
+
+    return tile;
+}
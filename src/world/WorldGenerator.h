@@ -18,7 +18,7 @@
 
 #pragma once
 
-#include <fstream>
+#include "Rotation.h"
 #include "data/json.hpp"
 #include "physics/Aabb.h"
 
@@ -26,6 +26,14 @@
 // Forward declarations
 //-------------------------------------------------
 
+namespace mdcii
+{
+    /**
+     * Forward declaration class CounterRng.
+     */
+    class CounterRng;
+}
+
 namespace mdcii::layer
 {
     /**
@@ -40,8 +48,28 @@ namespace mdcii::layer
 
 namespace mdcii::world
 {
+    /**
+     * Forward declaration class IslandMask.
+     */
+    class IslandMask;
+
+    /**
+     * The size and position of an island to generate.
+     */
+    struct IslandSettings
+    {
+        int32_t width{ 16 };
+        int32_t height{ 16 };
+        int32_t x{ 0 };
+        int32_t y{ 0 };
+        bool south{ true };
+    };
+
     /**
      * Creates a custom world map.
+     *
+     * The islands are generated in parallel. Each island uses its own
+     * counter-based random numbers, so that a seed always creates the same world.
      */
     class WorldGenerator
     {
@@ -54,14 +82,47 @@ namespace mdcii::world
 
         static constexpr auto BANK{ 1011 };
         static constexpr auto BANK_CORNER{ 1051 };
+        static constexpr auto BANK_CORNER_INSIDE{ 1071 };
 
         static constexpr auto COAST_WATER{ 1203 };
         static constexpr auto COAST{ 1205 };
         static constexpr auto COAST_CORNER{ 1207 };
+        static constexpr auto COAST_CORNER_INSIDE{ 1209 };
 
         static constexpr std::array<int32_t, 11> NORTH_TREES{ 1304, 1306, 1308, 1310, 1312, 1314, 1316, 1318, 1320, 1322, 1324 };
         static constexpr std::array<int32_t, 11> SOUTH_TREES{ 1352, 1354, 1356, 1358, 1360, 1362, 1364, 1366, 1368, 1370, 1372 };
 
+        /**
+         * The min width and height of a random island.
+         */
+        static constexpr auto ISLAND_MIN_SIZE{ 16 };
+
+        /**
+         * The max width and height of a random island.
+         */
+        static constexpr auto ISLAND_MAX_SIZE{ 40 };
+
+        /**
+         * The min distance between two trees.
+         */
+        static constexpr auto VEGETATION_MIN_DISTANCE{ 2.0f };
+
+        /**
+         * The default min distance between two islands.
+         */
+        static constexpr auto ISLAND_WATER_MARGIN{ 2 };
+
+        /**
+         * The max number of islands that can be edited in the ImGui menu.
+         * Only the visible rows of the island table are rendered.
+         */
+        static constexpr auto MAX_GUI_ISLANDS{ 4096 };
+
+        /**
+         * The number of attempts to find a free position for a random island.
+         */
+        static constexpr auto MAX_PLACEMENT_ATTEMPTS{ 1000 };
+
         //-------------------------------------------------
         // Ctors. / Dtor.
         //-------------------------------------------------
@@ -84,17 +145,87 @@ namespace mdcii::world
          */
         void RenderImGui();
 
+        //-------------------------------------------------
+        // Create
+        //-------------------------------------------------
+
+        /**
+         * Creates random island sizes and positions without collisions.
+         *
+         * @param t_worldWidth The width of the world.
+         * @param t_worldHeight The height of the world.
+         * @param t_nrOfIslands The number of islands.
+         * @param t_waterMargin The min distance between two islands.
+         * @param t_seed The seed.
+         *
+         * @return The IslandSettings objects.
+         */
+        [[nodiscard]] static std::vector<IslandSettings> CreateIslandSettings(
+            int32_t t_worldWidth,
+            int32_t t_worldHeight,
+            int32_t t_nrOfIslands,
+            int32_t t_waterMargin,
+            uint64_t t_seed
+        );
+
+        /**
+         * Finds positions for islands of a given size, row by row with the highest islands first.
+         *
+         * @param t_islands The islands whose positions are set.
+         * @param t_worldWidth The width of the world.
+         * @param t_worldHeight The height of the world.
+         * @param t_waterMargin The min distance between two islands.
+         *
+         * @return False if the islands do not fit into the world.
+         */
+        static bool PackIslands(std::vector<IslandSettings>& t_islands, int32_t t_worldWidth, int32_t t_worldHeight, int32_t t_waterMargin);
+
+        /**
+         * Generates the islands on a thread pool and writes the world into a file.
+         * A file with the extension .sav is written as a savegame, otherwise as a Json map.
+         *
+         * @param t_filePath The path to the new file.
+         * @param t_worldWidth The width of the world.
+         * @param t_worldHeight The height of the world.
+         * @param t_islands The islands to generate.
+         * @param t_seed The seed.
+         * @param t_nrOfThreads The number of worker threads.
+         */
+        static void CreateWorld(
+            const std::string& t_filePath,
+            int32_t t_worldWidth,
+            int32_t t_worldHeight,
+            const std::vector<IslandSettings>& t_islands,
+            uint64_t t_seed,
+            uint32_t t_nrOfThreads
+        );
+
     protected:
 
     private:
+        //-------------------------------------------------
+        // Types
+        //-------------------------------------------------
+
+        /**
+         * The generated Tile objects of an island.
+         */
+        struct GeneratedIsland
+        {
+            IslandSettings settings;
+            std::vector<std::shared_ptr<layer::Tile>> coastTiles;
+            std::vector<std::shared_ptr<layer::Tile>> terrainTiles;
+            std::vector<std::shared_ptr<layer::Tile>> buildingsTiles;
+        };
+
         //-------------------------------------------------
         // Member
         //-------------------------------------------------
 
         /**
-         * The new map file.
+         * The path to the new map file.
          */
-        std::ofstream m_file;
+        std::string m_filePath;
 
         //-------------------------------------------------
         // Init
@@ -106,38 +237,60 @@ namespace mdcii::world
         void Init();
 
         //-------------------------------------------------
-        // Create Json
+        // Create Islands
         //-------------------------------------------------
 
         /**
-         * Checks the Aabbs for collisions.
+         * Checks the Aabbs for collisions with sweep and prune.
          *
          * @param t_aabbs The Aabbs to be checked.
+         * @param t_waterMargin The min distance between two Aabbs.
          *
          * @return False if there is a collision.
          */
-        static bool Validate(const std::vector<physics::Aabb>& t_aabbs);
+        static bool Validate(const std::vector<physics::Aabb>& t_aabbs, int32_t t_waterMargin);
 
         /**
-         * Adds world width and height to an Json value.
+         * Creates the Tile objects of all layers of an island.
          *
-         * @param t_j The Json where the values will be added.
-         * @param t_width The width of the world.
-         * @param t_height The height of the world.
+         * @param t_settings The size and position of the island.
+         * @param t_rng The random numbers of the island.
+         *
+         * @return The GeneratedIsland object.
+         */
+        static GeneratedIsland CreateIsland(const IslandSettings& t_settings, CounterRng& t_rng);
+
+        //-------------------------------------------------
+        // Write
+        //-------------------------------------------------
+
+        /**
+         * Writes the world as a Json map.
+         *
+         * @param t_filePath The path to the new file.
+         * @param t_worldWidth The width of the world.
+         * @param t_worldHeight The height of the world.
+         * @param t_islands The generated islands.
          */
-        static void AddWorldValues(nlohmann::json& t_j, int32_t t_width, int32_t t_height);
+        static void WriteJson(const std::string& t_filePath, int32_t t_worldWidth, int32_t t_worldHeight, const std::vector<GeneratedIsland>& t_islands);
+
+        /**
+         * Writes the world as a savegame.
+         *
+         * @param t_filePath The path to the new file.
+         * @param t_worldWidth The width of the world.
+         * @param t_worldHeight The height of the world.
+         * @param t_islands The generated islands.
+         */
+        static void WriteSaveGame(const std::string& t_filePath, int32_t t_worldWidth, int32_t t_worldHeight, const std::vector<GeneratedIsland>& t_islands);
 
         /**
          * Adds an island to an Json value.
          *
          * @param t_j The Json where the values will be added.
-         * @param t_width The width of the island.
-         * @param t_height The height of the island.
-         * @param t_worldX The x position in the world.
-         * @param t_worldY The y position in the world.
-         * @param t_south If true then trees will be created for a southern island.
+         * @param t_island The generated island.
          */
-        static void AddIslandValues(nlohmann::json& t_j, int32_t t_width, int32_t t_height, int32_t t_worldX, int32_t t_worldY, bool t_south);
+        static void AddIslandValues(nlohmann::json& t_j, const GeneratedIsland& t_island);
 
         //-------------------------------------------------
         // Create Layer
@@ -146,30 +299,25 @@ namespace mdcii::world
         /**
          * Creates Tile objects for the TerrainLayer.
          *
-         * @param t_width The width of the island.
-         * @param t_height The height of the island.
+         * @param t_mask The shape of the island.
          * @param t_terrainTiles The created Tile objects.
          * @param t_south If true then trees will be created for a southern island.
+         * @param t_rng The random numbers of the island.
          */
         static void CreateTerrain(
-            int32_t t_width,
-            int32_t t_height,
+            const IslandMask& t_mask,
             std::vector<std::shared_ptr<layer::Tile>>& t_terrainTiles,
-            bool t_south
+            bool t_south,
+            CounterRng& t_rng
         );
 
         /**
          * Creates Tile objects for the CoastLayer.
          *
-         * @param t_width The width of the island.
-         * @param t_height The height of the island.
+         * @param t_mask The shape of the island.
          * @param t_coastTiles The created Tile objects.
          */
-        static void CreateCoast(
-            int32_t t_width,
-            int32_t t_height,
-            std::vector<std::shared_ptr<layer::Tile>>& t_coastTiles
-        );
+        static void CreateCoast(const IslandMask& t_mask, std::vector<std::shared_ptr<layer::Tile>>& t_coastTiles);
 
         /**
          * Creates Tile objects for the BuildingsLayer.
@@ -183,5 +331,17 @@ namespace mdcii::world
             int32_t t_height,
             std::vector<std::shared_ptr<layer::Tile>>& t_buildingsTiles
         );
+
+        /**
+         * Creates a Tile object at an island position.
+         *
+         * @param t_buildingId The building Id or -1 for an empty Tile.
+         * @param t_rotation The rotation of the building.
+         * @param t_x The x position on the island.
+         * @param t_y The y position on the island.
+         *
+         * @return The Tile object.
+         */
+        static std::unique_ptr<layer::Tile> CreateTile(int32_t t_buildingId, Rotation t_rotation, int32_t t_x, int32_t t_y);
     };
 }
@@ -26,6 +26,7 @@
 #include "state/State.h"
 #include "data/Text.h"
 #include "file/OriginalResourcesManager.h"
+#include "AutoSave.h"
 #include "layer/TerrainLayer.h"
 
 //-------------------------------------------------
@@ -216,58 +217,22 @@ void mdcii::world::WorldGui::SaveGameGui()
 {
     const auto fileName{ Game::RESOURCES_REL_PATH + Game::INI.Get<std::string>("content", "save_game_map") };
 
+    // the AutoSave is also used by the simulation thread
+    std::lock_guard lock{ m_world->tickMutex };
+
+    if (m_world->autoSave->IsSaving())
+    {
+        ImGui::TextUnformatted("Saving...");
+        return;
+    }
+
     const auto str{ data::Text::GetMenuText(Game::INI.Get<std::string>("locale", "lang"), "SaveGame") + fileName };
     if (ImGui::Button(str.c_str()))
     {
         Log::MDCII_LOG_DEBUG("[WorldGui::SaveGameGui()] Start saving the game in file {}...", fileName);
 
-        nlohmann::json json;
-
-        std::ofstream file{ fileName };
-        if (!file)
-        {
-            throw MDCII_EXCEPTION("[WorldGui::SaveGameGui()] Error while opening file " + fileName + ".");
-        }
-
-        // version
-        json["version"] = Game::VERSION;
-
-        // world
-        json["world"] = *m_world;
-
-        // islands
-        auto islandsJson = nlohmann::json::array();
-        for (const auto& island : m_world->terrain->islands)
-        {
-            // island
-            auto islandJson = nlohmann::json::object();
-            islandJson = *island;
-            islandJson["layers"] = nlohmann::json::array();
-
-            // coast
-            auto c = nlohmann::json::object();
-            c["coast"] = island->coastLayer->tiles;
-
-            // terrain
-            auto t = nlohmann::json::object();
-            t["terrain"] = island->terrainLayer->tiles;
-
-            // buildings
-            auto b = nlohmann::json::object();
-            b["buildings"] = island->buildingsLayer->tiles;
-
-            islandJson["layers"].push_back(c);
-            islandJson["layers"].push_back(t);
-            islandJson["layers"].push_back(b);
-
-            islandsJson.push_back(islandJson);
-        }
-
-        json["islands"] = islandsJson;
-
-        file << json;
-
-        Log::MDCII_LOG_DEBUG("[WorldGui::SaveGameGui()] The game has been successfully saved in file {}.", fileName);
+        // the file is written by a worker thread
+        m_world->autoSave->SaveInBackground(fileName);
     }
 }
 
@@ -20,6 +20,32 @@
 #include "world/Zoom.h"
 #include "world/Rotation.h"
 #include "physics/Aabb.h"
+#include "physics/BroadPhase.h"
+#include "ThreadPool.h"
+#include "CounterRng.h"
+#include "world/BuildingRegistry.h"
+#include "world/BuildabilityMap.h"
+#include "world/IslandMask.h"
+#include "profiler/FrameStatistics.h"
+#include "event/InputLog.h"
+#include "event/EventManager.h"
+#include "world/AnimationClock.h"
+#include "ogl/StateCache.h"
+#include "ogl/RecordingDevice.h"
+#include "ogl/buffer/Vao.h"
+#include "ogl/buffer/Vbo.h"
+#include "ogl/buffer/Ssbo.h"
+#include "renderer/FrameUniforms.h"
+#include "renderer/IslandBatch.h"
+#include "ogl/resource/ProgramBinaryCache.h"
+#include "file/SaveGameJournal.h"
+#include "layer/GameLayer.h"
+#include "file/JsonMapReader.h"
+#include "file/BshFile.h"
+#include "world/MousePicker.h"
+#include "layer/Tile.h"
+#include "data/json.hpp"
+#include "Game.h"
 
 TEST(TestSuite, TestZoomOperators)
 {
@@ -76,8 +102,855 @@ TEST(TestSuite, TestAabb1)
     ASSERT_TRUE(mdcii::physics::Aabb::PointVsAabb(glm::ivec2(15, 23), aabb));
 }
 
+TEST(TestSuite, TestBroadPhase)
+{
+    std::vector<mdcii::physics::Aabb> aabbs;
+    aabbs.emplace_back(glm::ivec2(0, 0), glm::ivec2(16, 16));
+    aabbs.emplace_back(glm::ivec2(18, 0), glm::ivec2(16, 16));
+    aabbs.emplace_back(glm::ivec2(0, 40), glm::ivec2(20, 16));
+
+    ASSERT_FALSE(mdcii::physics::has_overlap(aabbs));
+    ASSERT_FALSE(mdcii::physics::has_overlap(aabbs, 2));
+    ASSERT_TRUE(mdcii::physics::has_overlap(aabbs, 3));
+
+    aabbs.emplace_back(glm::ivec2(15, 50), glm::ivec2(4, 4));
+    ASSERT_TRUE(mdcii::physics::has_overlap(aabbs));
+
+    mdcii::physics::UniformGrid grid{ 100, 100, 20 };
+    grid.Insert(aabbs.at(0));
+    grid.Insert(aabbs.at(1));
+
+    ASSERT_TRUE(grid.Overlaps(mdcii::physics::Aabb(glm::ivec2(30, 10), glm::ivec2(8, 8))));
+    ASSERT_FALSE(grid.Overlaps(mdcii::physics::Aabb(glm::ivec2(36, 0), glm::ivec2(8, 8))));
+    ASSERT_TRUE(grid.Overlaps(mdcii::physics::Aabb(glm::ivec2(36, 0), glm::ivec2(8, 8)), 3));
+}
+
+TEST(TestSuite, TestThreadPool)
+{
+    mdcii::ThreadPool threadPool{ 4 };
+    ASSERT_EQ(4u, threadPool.GetNrOfThreads());
+
+    std::vector<std::future<int>> futures;
+    for (auto i{ 0 }; i < 100; ++i)
+    {
+        futures.push_back(threadPool.Submit([i]() { return i * 2; }));
+    }
+
+    auto sum{ 0 };
+    for (auto& future : futures)
+    {
+        sum += future.get();
+    }
+
+    ASSERT_EQ(9900, sum);
+
+    std::vector<std::future<void>> voidFutures;
+    voidFutures.push_back(threadPool.Submit([]() { throw std::runtime_error("Task failed."); }));
+    ASSERT_THROW(mdcii::ThreadPool::WaitForAll(voidFutures), std::runtime_error);
+}
+
+TEST(TestSuite, TestCounterRng)
+{
+    mdcii::CounterRng a{ 42, 1 };
+    mdcii::CounterRng b{ 42, 1 };
+    mdcii::CounterRng c{ 42, 2 };
+
+    // the same seed and stream always create the same numbers
+    auto differentStreams{ false };
+    for (auto i{ 0 }; i < 100; ++i)
+    {
+        const auto value{ a.Next() };
+        ASSERT_EQ(value, b.Next());
+        differentStreams |= value != c.Next();
+    }
+    ASSERT_TRUE(differentStreams);
+
+    // numbers can be taken out of order
+    mdcii::CounterRng d{ 42, 1 };
+    ASSERT_EQ(mdcii::CounterRng(42, 1).At(7), d.At(7));
+
+    for (auto i{ 0 }; i < 1000; ++i)
+    {
+        const auto value{ d.NextInt(-3, 3) };
+        ASSERT_TRUE(value >= -3 && value <= 3);
+
+        const auto f{ d.NextFloat() };
+        ASSERT_TRUE(f >= 0.0f && f < 1.0f);
+    }
+}
+
+TEST(TestSuite, TestIslandMask)
+{
+    for (auto seed{ 0u }; seed < 50u; ++seed)
+    {
+        mdcii::CounterRng rng{ seed, 0 };
+        const auto width{ rng.NextInt(6, 60) };
+        const auto height{ rng.NextInt(6, 60) };
+
+        // each neighborhood has a matching tile, otherwise the ctor throws
+        const mdcii::world::IslandMask mask{ width, height, rng };
+
+        auto land{ 0 };
+        for (auto y{ 0 }; y < height; ++y)
+        {
+            for (auto x{ 0 }; x < width; ++x)
+            {
+                const auto type{ mask.GetTile(x, y).type };
+                if (type >= mdcii::world::IslandTileType::BANK)
+                {
+                    ++land;
+
+                    // the coast needs two tiles of water
+                    ASSERT_TRUE(x >= 2 && y >= 2 && x < width - 2 && y < height - 2);
+                }
+            }
+        }
+        ASSERT_GT(land, 0);
+
+        const auto trees{ mask.SampleLand(2.0f, rng) };
+        for (auto i{ 0u }; i < trees.size(); ++i)
+        {
+            ASSERT_EQ(mdcii::world::IslandTileType::LAND, mask.GetTile(trees[i].x, trees[i].y).type);
+            for (auto j{ i + 1 }; j < trees.size(); ++j)
+            {
+                const auto dx{ trees[i].x - trees[j].x };
+                const auto dy{ trees[i].y - trees[j].y };
+                ASSERT_GE(dx * dx + dy * dy, 4);
+            }
+        }
+    }
+}
+
+TEST(TestSuite, TestBuildingRegistry)
+{
+    mdcii::world::BuildingRegistry registry;
+
+    const auto first{ registry.Add({ 5, { 2, 3 }, mdcii::world::Rotation::DEG90, { 3, 2 } }) };
+    const auto second{ registry.Add({ 7, { 0, 0 }, mdcii::world::Rotation::DEG0, { 1, 1 } }) };
+    ASSERT_EQ(0, first);
+    ASSERT_EQ(1, second);
+    ASSERT_EQ(2, registry.GetNrOfPlacedBuildings());
+
+    // a rotated 3x2 building covers 2x3 tiles
+    const auto footprint{ mdcii::world::BuildingRegistry::GetFootprint(registry.Get(first)) };
+    ASSERT_EQ(6u, footprint.size());
+    for (const auto& position : footprint)
+    {
+        ASSERT_TRUE(position.x >= 2 && position.x <= 3);
+        ASSERT_TRUE(position.y >= 3 && position.y <= 5);
+    }
+
+    registry.Remove(first);
+    ASSERT_FALSE(registry.Contains(first));
+    ASSERT_EQ(1, registry.GetNrOfPlacedBuildings());
+    ASSERT_THROW(registry.Remove(first), mdcii::MdciiException);
+
+    // the free index is reused
+    ASSERT_EQ(first, registry.Add({ 9, { 4, 4 }, mdcii::world::Rotation::DEG180, { 2, 2 } }));
+    ASSERT_EQ(9, registry.Get(first).buildingId);
+}
+
+TEST(TestSuite, TestBuildabilityMap)
+{
+    using mdcii::world::BuildableCell;
+
+    // a 4x3 island with a coast column on the left
+    std::vector<BuildableCell> cells(12, BuildableCell::LAND);
+    for (auto y{ 0 }; y < 3; ++y)
+    {
+        cells.at(static_cast<size_t>(y) * 4) = BuildableCell::COAST;
+    }
+
+    mdcii::world::BuildabilityMap map;
+    map.Create(4, 3, cells);
+
+    ASSERT_EQ(9, map.Count(BuildableCell::LAND, glm::ivec2(0, 0), glm::ivec2(4, 3)));
+    ASSERT_EQ(3, map.Count(BuildableCell::COAST, glm::ivec2(0, 0), glm::ivec2(4, 3)));
+
+    ASSERT_TRUE(map.IsBuildable(glm::ivec2(1, 0), glm::ivec2(3, 3), false));
+    ASSERT_FALSE(map.IsBuildable(glm::ivec2(0, 0), glm::ivec2(2, 2), false));
+    ASSERT_FALSE(map.IsBuildable(glm::ivec2(2, 2), glm::ivec2(3, 1), false));
+
+    ASSERT_TRUE(map.IsBuildable(glm::ivec2(0, 0), glm::ivec2(2, 2), true));
+    ASSERT_FALSE(map.IsBuildable(glm::ivec2(1, 0), glm::ivec2(2, 2), true));
+
+    const auto version{ map.GetVersion() };
+    map.Set(2, 1, BuildableCell::BLOCKED);
+
+    ASSERT_NE(version, map.GetVersion());
+    ASSERT_EQ(8, map.Count(BuildableCell::LAND, glm::ivec2(0, 0), glm::ivec2(4, 3)));
+    ASSERT_FALSE(map.IsBuildable(glm::ivec2(1, 0), glm::ivec2(3, 3), false));
+    ASSERT_TRUE(map.IsBuildable(glm::ivec2(3, 0), glm::ivec2(1, 3), false));
+}
+
+TEST(TestSuite, TestFrameStatistics)
+{
+    ASSERT_EQ(0, mdcii::profiler::calc_frame_statistics({}).count);
+
+    std::vector<double> times;
+    for (auto i{ 100 }; i > 0; --i)
+    {
+        times.push_back(static_cast<double>(i));
+    }
+
+    const auto statistics{ mdcii::profiler::calc_frame_statistics(times) };
+
+    ASSERT_EQ(100, statistics.count);
+    ASSERT_DOUBLE_EQ(5050.0, statistics.total);
+    ASSERT_DOUBLE_EQ(1.0, statistics.min);
+    ASSERT_DOUBLE_EQ(100.0, statistics.max);
+    ASSERT_DOUBLE_EQ(50.5, statistics.mean);
+    ASSERT_DOUBLE_EQ(50.0, statistics.median);
+    ASSERT_DOUBLE_EQ(95.0, statistics.p95);
+    ASSERT_DOUBLE_EQ(99.0, statistics.p99);
+}
+
+TEST(TestSuite, TestInputLog)
+{
+    using namespace mdcii::event;
+
+    InputLog log;
+    log.width = 1024;
+    log.height = 768;
+    log.frames = 500;
+    log.records.push_back({ 0, std::make_shared<MouseMovedEvent>(10.5f, 20.0f) });
+    log.records.push_back({ 0, std::make_shared<MouseButtonPressedEvent>(0) });
+    log.records.push_back({ 3, std::make_shared<KeyPressedEvent>(-1, 2) });
+    log.records.push_back({ 300, std::make_shared<MouseScrolledEvent>(0.0f, -1.0f) });
+
+    std::stringstream stream;
+    log.Write(stream);
+
+    InputLog result;
+    result.Read(stream);
+
+    ASSERT_EQ(1024, result.width);
+    ASSERT_EQ(768, result.height);
+    ASSERT_EQ(500u, result.frames);
+    ASSERT_EQ(4u, result.records.size());
+
+    ASSERT_EQ(0u, result.records[1].frame);
+    ASSERT_EQ(MdciiEventType::MOUSE_BUTTON_PRESSED, result.records[1].event->type);
+
+    const auto& moved{ static_cast<const MouseMovedEvent&>(*result.records[0].event) };
+    ASSERT_FLOAT_EQ(10.5f, moved.x);
+    ASSERT_FLOAT_EQ(20.0f, moved.y);
+
+    const auto& key{ static_cast<const KeyPressedEvent&>(*result.records[2].event) };
+    ASSERT_EQ(3u, result.records[2].frame);
+    ASSERT_EQ(-1, key.key);
+    ASSERT_EQ(2, key.repeatCount);
+
+    ASSERT_EQ(300u, result.records[3].frame);
+    ASSERT_FLOAT_EQ(-1.0f, static_cast<const MouseScrolledEvent&>(*result.records[3].event).yOffset);
+
+    std::stringstream invalid{ "XXXX" };
+    ASSERT_THROW(result.Read(invalid), mdcii::MdciiException);
+
+    // a garbage count of records in a truncated log
+    InputLog empty;
+    std::stringstream emptyStream;
+    empty.Write(emptyStream);
+    auto truncated{ emptyStream.str() };
+    truncated.replace(truncated.size() - sizeof(uint32_t), sizeof(uint32_t), sizeof(uint32_t), '\xFF');
+    std::stringstream truncatedStream{ truncated };
+    ASSERT_THROW(result.Read(truncatedStream), mdcii::MdciiException);
+}
+
+TEST(TestSuite, TestEventManagerCoalescing)
+{
+    using namespace mdcii::event;
+
+    EventManager::InitEventQueue();
+
+    // the type and, for mouse moves, the x position of each dispatched event
+    std::vector<std::pair<MdciiEventType, float>> dispatched;
+    const auto mouseMoved{ EventManager::event_dispatcher.appendListener(MdciiEventType::MOUSE_MOVED, [&dispatched](const MdciiEvent& t_event) {
+        dispatched.emplace_back(t_event.type, static_cast<const MouseMovedEvent&>(t_event).x);
+    }) };
+    const auto mouseButtonPressed{ EventManager::event_dispatcher.appendListener(MdciiEventType::MOUSE_BUTTON_PRESSED, [&dispatched](const MdciiEvent& t_event) {
+        dispatched.emplace_back(t_event.type, 0.0f);
+    }) };
+    const auto keyPressed{ EventManager::event_dispatcher.appendListener(MdciiEventType::KEY_PRESSED, [&dispatched](const MdciiEvent& t_event) {
+        dispatched.emplace_back(t_event.type, 0.0f);
+    }) };
+
+    const auto eventsReceived{ EventManager::events_received };
+    const auto eventsDispatched{ EventManager::events_dispatched };
+
+    EventManager::EnqueueMouseMoved(std::make_shared<MouseMovedEvent>(1.0f, 1.0f));
+    EventManager::EnqueueMouseMoved(std::make_shared<MouseMovedEvent>(2.0f, 2.0f));
+    EventManager::Enqueue(std::make_shared<MouseButtonPressedEvent>(0));
+    EventManager::EnqueueMouseMoved(std::make_shared<MouseMovedEvent>(3.0f, 3.0f));
+    EventManager::EnqueueMouseMoved(std::make_shared<MouseMovedEvent>(4.0f, 4.0f));
+    EventManager::Enqueue(std::make_shared<KeyPressedEvent>(65));
+    EventManager::EnqueueMouseMoved(std::make_shared<MouseMovedEvent>(5.0f, 5.0f));
+
+    // nothing is dispatched before the frame processes the events
+    ASSERT_TRUE(dispatched.empty());
+    ASSERT_TRUE(EventManager::ProcessEvents());
+
+    // a press flushes the last pending move before it, the last move of the frame is flushed at the end
+    const std::vector<std::pair<MdciiEventType, float>> expected{
+        { MdciiEventType::MOUSE_MOVED, 2.0f },
+        { MdciiEventType::MOUSE_BUTTON_PRESSED, 0.0f },
+        { MdciiEventType::MOUSE_MOVED, 4.0f },
+        { MdciiEventType::KEY_PRESSED, 0.0f },
+        { MdciiEventType::MOUSE_MOVED, 5.0f },
+    };
+    ASSERT_EQ(expected, dispatched);
+
+    ASSERT_EQ(7, EventManager::events_received - eventsReceived);
+    ASSERT_EQ(5, EventManager::events_dispatched - eventsDispatched);
+
+    // an empty frame dispatches nothing
+    ASSERT_FALSE(EventManager::ProcessEvents());
+    ASSERT_EQ(5u, dispatched.size());
+
+    EventManager::event_dispatcher.removeListener(MdciiEventType::MOUSE_MOVED, mouseMoved);
+    EventManager::event_dispatcher.removeListener(MdciiEventType::MOUSE_BUTTON_PRESSED, mouseButtonPressed);
+    EventManager::event_dispatcher.removeListener(MdciiEventType::KEY_PRESSED, keyPressed);
+}
+
+TEST(TestSuite, TestAnimationClock)
+{
+    mdcii::world::AnimationClock clock;
+
+    // the first tick increments all counters
+    clock.Tick();
+    for (const auto counter : clock.timeCounter)
+    {
+        ASSERT_EQ(1, counter);
+    }
+
+    for (auto i{ 1 }; i < 13 * 2; ++i)
+    {
+        clock.Tick();
+    }
+
+    ASSERT_EQ(26, clock.ticks);
+    ASSERT_EQ(5, clock.timeCounter[0]);
+    ASSERT_EQ(4, clock.timeCounter[1]);
+    ASSERT_EQ(3, clock.timeCounter[2]);
+    ASSERT_EQ(3, clock.timeCounter[3]);
+    ASSERT_EQ(2, clock.timeCounter[4]);
+
+    while (clock.ticks != 0)
+    {
+        clock.Tick();
+    }
+
+    ASSERT_EQ(0, clock.timeCounter[0]);
+}
+
+/**
+ * Installs a RecordingDevice for the tests of the Gpu wrappers
+ * and removes it again, even if an assertion fails.
+ */
+class RecordingDeviceTest : public ::testing::Test
+{
+protected:
+    mdcii::ogl::RecordingDevice* device{ nullptr };
+
+    void SetUp() override
+    {
+        auto recordingDevice{ std::make_unique<mdcii::ogl::RecordingDevice>(true) };
+        device = recordingDevice.get();
+        mdcii::ogl::Device::Set(std::move(recordingDevice));
+    }
+
+    void TearDown() override
+    {
+        mdcii::ogl::Device::Set(nullptr);
+        device = nullptr;
+    }
+};
+
+TEST_F(RecordingDeviceTest, TestRecordingDevice)
+{
+    using namespace mdcii::ogl;
+
+    {
+        const std::vector<int32_t> gfx(100, 7);
+
+        buffer::Ssbo ssbo{ "gfx" };
+        ssbo.Bind();
+        buffer::Ssbo::StoreData(static_cast<uint32_t>(gfx.size() * sizeof(int32_t)), gfx.data());
+        buffer::Ssbo::StoreSubData(4 * sizeof(int32_t), sizeof(int32_t), &gfx[4]);
+        ssbo.BindBase(2);
+
+        buffer::Vao vao;
+        vao.Bind();
+        vao.Bind();
+        vao.drawCount = 6;
+        vao.DrawInstanced(100);
+        buffer::Vao::Unbind();
+
+        // the second bind of the Vao is skipped
+        ASSERT_EQ(1, device->statistics.skippedStateChanges);
+
+        ASSERT_EQ(2, device->liveBuffers + device->liveVertexArrays);
+        ASSERT_EQ(2, device->statistics.bufferUploads);
+        ASSERT_EQ(404, device->statistics.bytesUploaded);
+        ASSERT_EQ(1, device->statistics.bufferBindings);
+        ASSERT_EQ(1, device->statistics.drawCalls);
+        ASSERT_EQ(100, device->statistics.instancesDrawn);
+        ASSERT_EQ("DrawArraysInstanced 4 0 6 100", device->commands.at(device->commands.size() - 2));
+    }
+
+    // the destructors delete the handles
+    ASSERT_EQ(0, device->liveBuffers);
+    ASSERT_EQ(0, device->liveVertexArrays);
+
+    device->Reset();
+    ASSERT_TRUE(device->commands.empty());
+    ASSERT_EQ(0, device->statistics.drawCalls);
+}
+
+TEST(TestSuite, TestStateCache)
+{
+    mdcii::ogl::StateCache cache;
+
+    // nothing is known at the start
+    ASSERT_TRUE(cache.SetProgram(3));
+    ASSERT_FALSE(cache.SetProgram(3));
+    ASSERT_TRUE(cache.SetProgram(0));
+
+    // an indexed binding also changes the generic binding
+    ASSERT_TRUE(cache.SetBufferBase(1, 2, 7));
+    ASSERT_FALSE(cache.SetBufferBase(1, 2, 7));
+    ASSERT_FALSE(cache.SetBuffer(1, 7));
+    ASSERT_TRUE(cache.SetBuffer(0, 7));
+
+    // a skipped indexed binding doesn't change the generic binding
+    ASSERT_TRUE(cache.SetBuffer(1, 8));
+    ASSERT_FALSE(cache.SetBufferBase(1, 2, 7));
+    ASSERT_TRUE(cache.SetBuffer(1, 7));
+
+    // a deleted handle can be reused
+    cache.ForgetBuffer(7);
+    ASSERT_TRUE(cache.SetBufferBase(1, 2, 7));
+    ASSERT_TRUE(cache.SetBuffer(0, 7));
+
+    // textures are bound per unit
+    ASSERT_TRUE(cache.SetTexture(0x0DE1, 5));
+    ASSERT_TRUE(cache.SetTexture(0x0DE1, 5));
+    ASSERT_TRUE(cache.SetActiveTexture(0x84C0));
+    ASSERT_TRUE(cache.SetTexture(0x0DE1, 5));
+    ASSERT_FALSE(cache.SetTexture(0x0DE1, 5));
+    ASSERT_TRUE(cache.SetActiveTexture(0x84C1));
+    ASSERT_TRUE(cache.SetTexture(0x0DE1, 5));
+    ASSERT_FALSE(cache.SetActiveTexture(0x84C1));
+
+    cache.Invalidate();
+    ASSERT_TRUE(cache.SetProgram(0));
+    ASSERT_TRUE(cache.SetActiveTexture(0x84C1));
+    ASSERT_TRUE(cache.SetTexture(0x0DE1, 5));
+}
+
+TEST_F(RecordingDeviceTest, TestFrameUniforms)
+{
+    {
+        mdcii::renderer::FrameUniforms frameUniforms;
+        frameUniforms.data.worldRotation = 1;
+        frameUniforms.data.updates[2].x = 7;
+
+        frameUniforms.Upload();
+        ASSERT_EQ(1, device->statistics.bufferUploads);
+        ASSERT_EQ(160, device->statistics.bytesUploaded);
+
+        // unchanged data is not uploaded again, but still bound
+        frameUniforms.Upload();
+        ASSERT_EQ(1, device->statistics.bufferUploads);
+        ASSERT_EQ(1, device->statistics.bufferBindings);
+
+        frameUniforms.data.updates[2].x = 8;
+        frameUniforms.Upload();
+        ASSERT_EQ(2, device->statistics.bufferUploads);
+    }
+}
+
+TEST_F(RecordingDeviceTest, TestIslandBatch)
+{
+    using namespace mdcii::ogl;
+
+    {
+        mdcii::renderer::IslandBatch batch{ { 10, 0, 5, 7 } };
+        ASSERT_EQ(22, batch.totalInstances);
+        ASSERT_EQ(std::vector<int32_t>({ 0, 10, 10, 15 }), batch.baseInstances);
+
+        // every island reads its instances from a shared Ssbo
+        const std::vector<int32_t> island0(10, 1);
+        const std::vector<int32_t> island1;
+        const std::vector<int32_t> island2(5, 3);
+        const std::vector<int32_t> island3(7, 4);
+
+        buffer::Ssbo ssbo{ "islands" };
+        ssbo.Bind();
+        device->ResetStatistics();
+        batch.StoreInBoundSsbo<int32_t>({ &island0, &island1, &island2, &island3 });
+        ASSERT_EQ(3, device->statistics.bufferUploads);
+        ASSERT_EQ(88, device->statistics.bytesUploaded);
+
+        // the empty island is skipped, the base instance selects the instance offset
+        device->ResetStatistics();
+        batch.Draw({ 0, 1, 3 });
+        ASSERT_EQ(2u, batch.commands.size());
+        ASSERT_EQ(6u, batch.commands[0].count);
+        ASSERT_EQ(10u, batch.commands[0].instanceCount);
+        ASSERT_EQ(1u, batch.commands[0].baseInstance);
+        ASSERT_EQ(7u, batch.commands[1].instanceCount);
+        ASSERT_EQ(4u, batch.commands[1].baseInstance);
+        ASSERT_EQ(1, device->statistics.drawCalls);
+        ASSERT_EQ(17, device->statistics.instancesDrawn);
+        ASSERT_EQ(1, device->statistics.bufferUploads);
+        ASSERT_EQ("MultiDrawArraysIndirect 4 2 17", device->commands.back());
+
+        // unchanged commands are not uploaded again
+        batch.Draw({ 0, 1, 3 });
+        ASSERT_EQ(2, device->statistics.drawCalls);
+        ASSERT_EQ(1, device->statistics.bufferUploads);
+
+        // nothing visible, nothing to draw
+        batch.Draw({ 1 });
+        ASSERT_TRUE(batch.commands.empty());
+        ASSERT_EQ(2, device->statistics.drawCalls);
+    }
+}
+
+TEST(TestSuite, TestProgramBinaryCache)
+{
+    using mdcii::ogl::resource::ProgramBinaryCache;
+
+    const auto key{ ProgramBinaryCache::CreateKey("vertex", "fragment", "driver 1.0") };
+    ASSERT_EQ(key, ProgramBinaryCache::CreateKey("vertex", "fragment", "driver 1.0"));
+    ASSERT_NE(key, ProgramBinaryCache::CreateKey("vertex", "fragment", "driver 1.1"));
+    ASSERT_NE(key, ProgramBinaryCache::CreateKey("#define X\nvertex", "fragment", "driver 1.0"));
+    ASSERT_NE(key, ProgramBinaryCache::CreateKey("vertexf", "ragment", "driver 1.0"));
+
+    ASSERT_EQ("shader_world.bin", ProgramBinaryCache::CreateFileName("shader/world"));
+
+    const mdcii::ogl::resource::ProgramBinary binary{ 42, { 'a', 'b', 'c' } };
+
+    std::stringstream stream;
+    ProgramBinaryCache::Write(stream, key, binary);
+
+    const auto result{ ProgramBinaryCache::Read(stream, key) };
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(42u, result->format);
+    ASSERT_EQ(binary.data, result->data);
+
+    std::stringstream outdated;
+    ProgramBinaryCache::Write(outdated, key, binary);
+    ASSERT_FALSE(ProgramBinaryCache::Read(outdated, key + 1).has_value());
+
+    std::stringstream invalid{ "XXXX" };
+    ASSERT_FALSE(ProgramBinaryCache::Read(invalid, key).has_value());
+
+    std::stringstream complete;
+    ProgramBinaryCache::Write(complete, key, binary);
+    std::stringstream truncated{ complete.str().substr(0, complete.str().size() - 1) };
+    ASSERT_FALSE(ProgramBinaryCache::Read(truncated, key).has_value());
+}
+
+TEST(TestSuite, TestSaveGame)
+{
+    using namespace mdcii::file;
+    using mdcii::layer::LayerType;
+
+    const auto filePath{ (std::filesystem::temp_directory_path() / "MdciiTestSaveGame.sav").string() };
+
+    // a long run of equal tiles and tiles that change every time
+    const std::vector<SaveGameTile> coast(1000, { 1201, 0, 0, 0 });
+    std::vector<SaveGameTile> terrain;
+    for (auto i{ 0 }; i < 1000; ++i)
+    {
+        terrain.push_back({ static_cast<int16_t>(101 + i % 3), static_cast<uint8_t>(i % 4), static_cast<int8_t>(i % 40 - 20), static_cast<int8_t>(i % 25) });
+    }
+    const std::vector<SaveGameTile> buildings(1000);
+
+    std::uintmax_t rawFileSize{ 0 };
+    for (const auto rle : { false, true })
+    {
+        {
+            SaveGameWriter writer{ filePath, rle };
+            writer.WriteHeader(42, 100, 80, 1);
+            writer.WriteIsland({ 40, 25, 3, 4 });
+            writer.WriteLayer(LayerType::COAST, coast);
+            writer.WriteLayer(LayerType::TERRAIN, terrain);
+            writer.WriteLayer(LayerType::BUILDINGS, buildings);
+            writer.Close();
+        }
+
+        ASSERT_TRUE(SaveGameReader::IsSaveGameFile(filePath));
+
+        SaveGameReader reader{ filePath };
+        ASSERT_EQ(42u, reader.checkpointId);
+        ASSERT_EQ(100, reader.worldWidth);
+        ASSERT_EQ(80, reader.worldHeight);
+        ASSERT_EQ(1u, reader.nrOfIslands);
+
+        const auto island{ reader.ReadIsland() };
+        ASSERT_EQ(40, island.width);
+        ASSERT_EQ(25, island.height);
+        ASSERT_EQ(3, island.x);
+        ASSERT_EQ(4, island.y);
+
+        ASSERT_TRUE(coast == reader.ReadTiles(LayerType::COAST, 1000));
+        ASSERT_TRUE(terrain == reader.ReadTiles(LayerType::TERRAIN, 1000));
+        ASSERT_TRUE(buildings == reader.ReadTiles(LayerType::BUILDINGS, 1000));
+
+        if (!rle)
+        {
+            rawFileSize = std::filesystem::file_size(filePath);
+        }
+    }
+
+    // the runs are stored as one record
+    ASSERT_LT(std::filesystem::file_size(filePath), rawFileSize);
+
+    // the layers are read in order and with the size of the island
+    {
+        SaveGameReader reader{ filePath };
+        (void)reader.ReadIsland();
+        ASSERT_THROW((void)reader.ReadTiles(LayerType::TERRAIN, 1000), mdcii::MdciiException);
+    }
+    {
+        SaveGameReader reader{ filePath };
+        (void)reader.ReadIsland();
+        ASSERT_THROW((void)reader.ReadTiles(LayerType::COAST, 999), mdcii::MdciiException);
+    }
+
+    // a failed conversion leaves no file
+    std::filesystem::remove(filePath);
+    ASSERT_THROW(SaveGameWriter::ConvertJsonMap("NoMap.json", filePath, true), mdcii::MdciiException);
+    ASSERT_FALSE(std::filesystem::exists(filePath));
+    ASSERT_FALSE(std::filesystem::exists(filePath + ".tmp"));
+
+    // the position of a tile must fit into an int8_t
+    mdcii::layer::Tile tile;
+    tile.buildingId = 1304;
+    tile.x = 127;
+    tile.y = -128;
+    const auto saveGameTile{ to_save_game_tile(tile) };
+    ASSERT_EQ(127, saveGameTile.x);
+    ASSERT_EQ(-128, saveGameTile.y);
+
+    tile.x = 128;
+    ASSERT_THROW((void)to_save_game_tile(tile), mdcii::MdciiException);
+    tile.x = 0;
+    tile.y = -129;
+    ASSERT_THROW((void)to_save_game_tile(tile), mdcii::MdciiException);
+    tile.y = 0;
+    tile.buildingId = 40000;
+    ASSERT_THROW((void)to_save_game_tile(tile), mdcii::MdciiException);
+}
+
+TEST(TestSuite, TestSaveGameJournal)
+{
+    using namespace mdcii::file;
+
+    const auto filePath{ (std::filesystem::temp_directory_path() / "MdciiTestSaveGame.sav.journal").string() };
+    std::filesystem::remove(filePath);
+
+    const std::vector<SaveGameJournalEntry> block0{ { 0, 1, 3, { 1304, 1, 0, 0 } }, { 0, 2, 4, { 501, 2, 1, 0 } } };
+    const std::vector<SaveGameJournalEntry> block1{ { 0, 1, 5, { 1306, 3, 0, 1 } } };
+    SaveGameJournal::Append(filePath, 42, block0);
+    SaveGameJournal::Append(filePath, 42, block1);
+
+    // a journal of another savegame is ignored and not extended
+    ASSERT_TRUE(SaveGameJournal::Read(filePath, 43).empty());
+    ASSERT_THROW(SaveGameJournal::Append(filePath, 43, block1), mdcii::MdciiException);
+
+    const auto entries{ SaveGameJournal::Read(filePath, 42) };
+    ASSERT_EQ(3, entries.size());
+
+    std::vector<std::shared_ptr<mdcii::layer::Tile>> tiles;
+    for (auto i{ 0 }; i < 8; ++i)
+    {
+        tiles.push_back(std::make_shared<mdcii::layer::Tile>());
+    }
+
+    for (const auto& entry : entries)
+    {
+        SaveGameJournal::ReplayEntry(entry, tiles);
+    }
+
+    ASSERT_EQ(-1, tiles.at(0)->buildingId);
+    ASSERT_EQ(1304, tiles.at(3)->buildingId);
+    ASSERT_EQ(mdcii::world::Rotation::DEG90, tiles.at(3)->rotation);
+    ASSERT_EQ(501, tiles.at(4)->buildingId);
+    ASSERT_EQ(1, tiles.at(4)->x);
+    ASSERT_EQ(mdcii::world::Rotation::DEG270, tiles.at(5)->rotation);
+    ASSERT_EQ(1, tiles.at(5)->y);
+    ASSERT_THROW(SaveGameJournal::ReplayEntry({ 0, 1, 8, {} }, tiles), mdcii::MdciiException);
+
+    // an interrupted save leaves a truncated last block
+    const auto fileSize{ std::filesystem::file_size(filePath) };
+    std::filesystem::resize_file(filePath, fileSize - 1);
+    ASSERT_EQ(2, SaveGameJournal::Read(filePath, 42).size());
+
+    // the number of entries of a torn block can be garbage
+    std::filesystem::resize_file(filePath, fileSize - sizeof(uint32_t) - SAVE_GAME_JOURNAL_ENTRY_SIZE);
+    {
+        std::ofstream file{ filePath, std::ios::binary | std::ios::app };
+        const auto nrOfEntries{ std::numeric_limits<uint32_t>::max() };
+        file.write(reinterpret_cast<const char*>(&nrOfEntries), sizeof(nrOfEntries));
+    }
+    ASSERT_EQ(2, SaveGameJournal::Read(filePath, 42).size());
+
+    std::filesystem::remove(filePath);
+}
+
+TEST(TestSuite, TestJsonMapReader)
+{
+    using mdcii::file::JsonMapReader;
+    using mdcii::file::JsonMapIsland;
+
+    const auto filePath{ mdcii::Game::RESOURCES_REL_PATH + "data/ExampleMap.json" };
+
+    std::vector<JsonMapIsland> islands;
+    JsonMapReader reader{ filePath };
+    reader.Read([&islands](JsonMapIsland& t_island) { islands.push_back(std::move(t_island)); });
+
+    // the same map read as Json value
+    nlohmann::json j;
+    std::ifstream file{ filePath };
+    file >> j;
+
+    ASSERT_EQ(j.at("version").get<std::string>(), reader.version);
+    ASSERT_EQ(j.at("world").at("width").get<int32_t>(), reader.worldWidth);
+    ASSERT_EQ(j.at("world").at("height").get<int32_t>(), reader.worldHeight);
+    ASSERT_EQ(j.at("islands").size(), islands.size());
+
+    const auto compareTiles = [](const nlohmann::json& t_json, const std::vector<std::shared_ptr<mdcii::layer::Tile>>& t_tiles) {
+        ASSERT_EQ(t_json.size(), t_tiles.size());
+        for (std::size_t i{ 0 }; i < t_tiles.size(); ++i)
+        {
+            const auto& tileJson{ t_json.at(i) };
+            const auto& tile{ *t_tiles.at(i) };
+            if (tileJson.is_null())
+            {
+                ASSERT_FALSE(tile.HasBuilding());
+                continue;
+            }
+
+            ASSERT_EQ(tileJson.value("id", -1), tile.buildingId);
+            ASSERT_EQ(mdcii::world::int_to_rotation(tileJson.value("rotation", 0)), tile.rotation);
+            ASSERT_EQ(tileJson.value("x", 0), tile.x);
+            ASSERT_EQ(tileJson.value("y", 0), tile.y);
+        }
+    };
+
+    for (std::size_t i{ 0 }; i < islands.size(); ++i)
+    {
+        const auto& islandJson{ j.at("islands").at(i) };
+        const auto& island{ islands.at(i) };
+        ASSERT_EQ(islandJson.at("width").get<int32_t>(), island.width);
+        ASSERT_EQ(islandJson.at("height").get<int32_t>(), island.height);
+        ASSERT_EQ(islandJson.at("x").get<int32_t>(), island.x);
+        ASSERT_EQ(islandJson.at("y").get<int32_t>(), island.y);
+
+        for (const auto& layerJson : islandJson.at("layers"))
+        {
+            for (const auto& [k, v] : layerJson.items())
+            {
+                if (k == "coast")
+                {
+                    compareTiles(v, island.coastTiles);
+                }
+                else if (k == "terrain")
+                {
+                    compareTiles(v, island.terrainTiles);
+                }
+                else if (k == "buildings")
+                {
+                    compareTiles(v, island.buildingsTiles);
+                }
+            }
+        }
+    }
+
+    // a map of another version is rejected before any island is created
+    const auto otherFilePath{ (std::filesystem::temp_directory_path() / "MdciiTestMap.json").string() };
+    {
+        // the keys of a written Json value are sorted, so the version is written by hand
+        std::ofstream otherFile{ otherFilePath };
+        otherFile << R"({ "version": "0.0", "islands": )" << j.at("islands") << " }";
+    }
+
+    auto nrOfIslands{ 0 };
+    JsonMapReader otherReader{ otherFilePath };
+    ASSERT_THROW(otherReader.Read([&nrOfIslands](JsonMapIsland&) { ++nrOfIslands; }), mdcii::MdciiException);
+    ASSERT_EQ(0, nrOfIslands);
+
+    std::filesystem::remove(otherFilePath);
+}
+
+TEST(TestSuite, TestBshTextureIsOpaque)
+{
+    // a gfx wider than one word of the alpha mask
+    mdcii::file::BshTexture bshTexture;
+    bshTexture.width = 70;
+    bshTexture.height = 3;
+
+    ASSERT_FALSE(bshTexture.IsOpaque(0, 0));
+
+    bshTexture.alphaMask.resize(static_cast<size_t>(bshTexture.GetAlphaMaskStride()) * bshTexture.height);
+    ASSERT_EQ(2u, bshTexture.GetAlphaMaskStride());
+
+    for (const auto& [x, y] : std::vector<std::pair<int32_t, int32_t>>{ { 0, 0 }, { 63, 1 }, { 64, 1 }, { 69, 2 } })
+    {
+        bshTexture.alphaMask[static_cast<size_t>(y) * bshTexture.GetAlphaMaskStride() + x / 64] |= uint64_t{ 1 } << (x % 64);
+    }
+
+    ASSERT_TRUE(bshTexture.IsOpaque(0, 0));
+    ASSERT_TRUE(bshTexture.IsOpaque(63, 1));
+    ASSERT_TRUE(bshTexture.IsOpaque(64, 1));
+    ASSERT_TRUE(bshTexture.IsOpaque(69, 2));
+    ASSERT_FALSE(bshTexture.IsOpaque(1, 0));
+    ASSERT_FALSE(bshTexture.IsOpaque(64, 0));
+    ASSERT_FALSE(bshTexture.IsOpaque(63, 2));
+
+    // outside of the gfx
+    ASSERT_FALSE(bshTexture.IsOpaque(-1, 0));
+    ASSERT_FALSE(bshTexture.IsOpaque(0, -1));
+    ASSERT_FALSE(bshTexture.IsOpaque(70, 2));
+    ASSERT_FALSE(bshTexture.IsOpaque(0, 3));
+}
+
+TEST(TestSuite, TestMousePickerToDeg0Offset)
+{
+    using mdcii::world::MousePicker;
+    using mdcii::world::Rotation;
+
+    ASSERT_EQ(glm::ivec2(1, 2), MousePicker::ToDeg0Offset({ 1, 2 }, Rotation::DEG0));
+    ASSERT_EQ(glm::ivec2(2, -1), MousePicker::ToDeg0Offset({ 1, 2 }, Rotation::DEG90));
+    ASSERT_EQ(glm::ivec2(-1, -2), MousePicker::ToDeg0Offset({ 1, 2 }, Rotation::DEG180));
+    ASSERT_EQ(glm::ivec2(-2, 1), MousePicker::ToDeg0Offset({ 1, 2 }, Rotation::DEG270));
+
+    // the offset between two rotated positions leads back to the unrotated positions
+    const auto width{ 10 };
+    const auto height{ 8 };
+    const glm::ivec2 position{ 3, 4 };
+    magic_enum::enum_for_each<Rotation>([&](const Rotation t_rotation) {
+        const auto rotatedPosition{ mdcii::world::rotate_position(position.x, position.y, width, height, t_rotation) };
+        for (auto y{ -2 }; y <= 2; ++y)
+        {
+            for (auto x{ -2 }; x <= 2; ++x)
+            {
+                const auto rotatedOther{ mdcii::world::rotate_position(position.x + x, position.y + y, width, height, t_rotation) };
+                ASSERT_EQ(glm::ivec2(x, y), MousePicker::ToDeg0Offset(rotatedOther - rotatedPosition, t_rotation));
+            }
+        }
+    });
+}
+
 int main()
 {
+    // most classes log their lifetime
+    mdcii::Log::Init();
+
     testing::InitGoogleTest();
     return RUN_ALL_TESTS();
 }
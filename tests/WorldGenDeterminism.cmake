@@ -0,0 +1,23 @@
+# Generates the same world with one and with several threads and compares the files.
+# Usage: cmake -DWORLDGEN=<MDCII_WORLDGEN executable> -DOUTPUT_DIR=<dir> -P WorldGenDeterminism.cmake
+
+get_filename_component(WORLDGEN_DIR ${WORLDGEN} DIRECTORY)
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+
+foreach(EXTENSION sav json)
+    foreach(THREADS 1 4)
+        # the generator reads the config.ini from its working directory
+        execute_process(COMMAND ${WORLDGEN} 128 128 12 42 ${OUTPUT_DIR}/World_${THREADS}.${EXTENSION} ${THREADS}
+                        WORKING_DIRECTORY ${WORLDGEN_DIR}
+                        RESULT_VARIABLE RESULT)
+        if (NOT RESULT EQUAL 0)
+            message(FATAL_ERROR "MDCII_WORLDGEN failed with ${THREADS} threads.")
+        endif()
+    endforeach()
+
+    execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${OUTPUT_DIR}/World_1.${EXTENSION} ${OUTPUT_DIR}/World_4.${EXTENSION}
+                    RESULT_VARIABLE RESULT)
+    if (NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "The .${EXTENSION} worlds differ between 1 and 4 threads.")
+    endif()
+endforeach()